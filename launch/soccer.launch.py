@@ -2,7 +2,8 @@ import os
 from pathlib import Path
 
 from ament_index_python.packages import get_package_share_directory
-from launch_ros.actions import Node
+from launch_ros.actions import ComposableNodeContainer, LoadComposableNodes, Node
+from launch_ros.descriptions import ComposableNode
 
 from launch import LaunchContext, LaunchDescription
 from launch.actions import (
@@ -12,7 +13,7 @@ from launch.actions import (
     SetLaunchConfiguration,
     Shutdown,
 )
-from launch.conditions import IfCondition
+from launch.conditions import IfCondition, UnlessCondition
 from launch.launch_description_sources import PythonLaunchDescriptionSource
 from launch.substitutions import (
     LaunchConfiguration,
@@ -52,6 +53,10 @@ def generate_launch_description():
     use_internal_ref = LaunchConfiguration("use_internal_ref")
     ref_flag = LaunchConfiguration("ref_flag")
 
+    # load the vision -> filter -> planning -> control -> radio pipeline into
+    # one process instead of one process per node
+    composable = LaunchConfiguration("composable")
+
     param_config = LaunchConfiguration("param_config")
     param_config_filepath = LaunchConfiguration("param_config_filepath")
 
@@ -94,6 +99,7 @@ def generate_launch_description():
             ),
             DeclareLaunchArgument("use_manual_control", default_value="False"),
             DeclareLaunchArgument("use_sim_radio", default_value="True"),
+            DeclareLaunchArgument("composable", default_value="False"),
             # this launch arg shouldn't be used, is solely dependent on run_sim
             # (above, param_config is defined by run_sim)
             DeclareLaunchArgument(
@@ -116,6 +122,7 @@ def generate_launch_description():
             # Note the order doesn't matter here: ROS nodes launch in some
             # random order (there are Executors to change that)
             Node(
+                condition=UnlessCondition(composable),
                 package="rj_robocup",
                 executable="vision_receiver",
                 output="screen",
@@ -140,7 +147,9 @@ def generate_launch_description():
                 on_exit=Shutdown(),
             ),
             Node(
-                condition=IfCondition(PythonExpression([run_sim])),
+                condition=IfCondition(
+                    PythonExpression([run_sim, " and not ", composable])
+                ),
                 package="rj_robocup",
                 executable="sim_radio_node",
                 output="screen",
@@ -148,7 +157,9 @@ def generate_launch_description():
                 on_exit=Shutdown(),
             ),
             Node(
-                condition=IfCondition(PythonExpression(["not ", run_sim])),
+                condition=IfCondition(
+                    PythonExpression(["not ", run_sim, " and not ", composable])
+                ),
                 package="rj_robocup",
                 executable="network_radio_node",
                 output="screen",
@@ -159,6 +170,7 @@ def generate_launch_description():
                 on_exit=Shutdown(),
             ),
             Node(
+                condition=UnlessCondition(composable),
                 package="rj_robocup",
                 executable="control_node",
                 output="screen",
@@ -166,6 +178,7 @@ def generate_launch_description():
                 on_exit=Shutdown(),
             ),
             Node(
+                condition=UnlessCondition(composable),
                 package="rj_robocup",
                 executable="planner_node",
                 output="screen",
@@ -190,7 +203,9 @@ def generate_launch_description():
                 on_exit=Shutdown(),
             ),
             Node(
-                condition=IfCondition(PythonExpression(["not ", use_manual_control])),
+                condition=IfCondition(
+                    PythonExpression(["not ", use_manual_control, " and not ", composable])
+                ),
                 package="rj_robocup",
                 executable="coach_node",
                 output="screen",
@@ -218,11 +233,91 @@ def generate_launch_description():
                 on_exit=Shutdown(),
             ),
             Node(
+                condition=UnlessCondition(composable),
                 package="rj_robocup",
                 executable="rj_vision_filter",
                 output="screen",
                 parameters=[param_config_filepath],
                 on_exit=Shutdown(),
             ),
+            # With composable:=True, the nodes above run as components in one
+            # container instead. Hot path topics (detection frames, world
+            # state, trajectories, setpoints) then skip DDS entirely.
+            ComposableNodeContainer(
+                condition=IfCondition(composable),
+                name="soccer_container",
+                namespace="",
+                package="rclcpp_components",
+                executable="component_container_mt",
+                output="screen",
+                composable_node_descriptions=[
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="GlobalParamReceiver",
+                        name="global_param_receiver",
+                    ),
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="vision_receiver::VisionReceiver",
+                        parameters=[param_config_filepath],
+                    ),
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="vision_filter::VisionFilter",
+                        parameters=[param_config_filepath],
+                    ),
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="planning::PlannerNode",
+                        parameters=[param_config_filepath],
+                    ),
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="control::MotionControlNode",
+                        parameters=[param_config_filepath],
+                    ),
+                ],
+                on_exit=Shutdown(),
+            ),
+            LoadComposableNodes(
+                condition=IfCondition(PythonExpression([composable, " and ", run_sim])),
+                target_container="soccer_container",
+                composable_node_descriptions=[
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="radio::SimRadio",
+                        parameters=[param_config_filepath],
+                    ),
+                ],
+            ),
+            LoadComposableNodes(
+                condition=IfCondition(
+                    PythonExpression([composable, " and not ", run_sim])
+                ),
+                target_container="soccer_container",
+                composable_node_descriptions=[
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="radio::NetworkRadio",
+                        parameters=[
+                            param_config_filepath,
+                            {"server_port": LaunchConfiguration("server_port")},
+                        ],
+                    ),
+                ],
+            ),
+            LoadComposableNodes(
+                condition=IfCondition(
+                    PythonExpression([composable, " and not ", use_manual_control])
+                ),
+                target_container="soccer_container",
+                composable_node_descriptions=[
+                    ComposableNode(
+                        package="rj_robocup",
+                        plugin="strategy::CoachNode",
+                        parameters=[param_config_filepath],
+                    ),
+                ],
+            ),
         ]
     )
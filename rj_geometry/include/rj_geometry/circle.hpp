@@ -63,6 +63,8 @@ public:
 
     bool near_point(Point pt, float threshold) const override;
 
+    bool bounding_box(Rect* out) const override;
+
     // Returns the number of points at which this circle intersects the given
     // circle.
     // i must be null or point to two points.
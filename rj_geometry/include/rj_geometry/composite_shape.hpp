@@ -32,6 +32,10 @@ public:
     [[nodiscard]] bool contains_point(Point pt) const override;
     [[nodiscard]] bool near_point(Point pt, float threshold) const override;
 
+    /// The union of the subshapes' bounding boxes. Fails if any subshape is
+    /// unbounded or there are no subshapes.
+    bool bounding_box(Rect* out) const override;
+
     void add(const std::shared_ptr<Shape>& shape);
 
     /// adds @comp_shape's subshapes to the receiver
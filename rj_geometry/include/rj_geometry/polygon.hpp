@@ -45,6 +45,8 @@ public:
 
     Rect bbox() const;
 
+    bool bounding_box(Rect* out) const override;
+
     std::vector<Point> vertices;
 
     void add_vertex(Point pt) { vertices.push_back(pt); }
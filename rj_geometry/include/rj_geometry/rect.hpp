@@ -34,6 +34,8 @@ public:
         pt[1] = other.pt[1];
     }
 
+    Rect& operator=(const Rect& other) = default;
+
     Shape* clone() const override;
 
     bool operator==(const Rect& other) const { return pt == other.pt; }
@@ -73,6 +75,8 @@ public:
 
     bool hit(const Segment& seg) const override;
 
+    bool bounding_box(Rect* out) const override;
+
     Point center() const { return (pt[0] + pt[1]) / 2; }
 
     /*
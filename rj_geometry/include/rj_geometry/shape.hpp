@@ -5,6 +5,7 @@
 
 namespace rj_geometry {
 
+class Rect;
 class Segment;
 
 /**
@@ -52,6 +53,15 @@ public:
         throw std::runtime_error("Unimplemented method");
     }
 
+    /**
+     * Computes the axis-aligned bounding box of this shape. Used by ShapeSet
+     * to cull shapes that can't be hit before running the exact test.
+     *
+     * @param out Set to the bounding box when one exists
+     * @return False if the shape doesn't have (or doesn't know) finite bounds
+     */
+    virtual bool bounding_box(Rect* /*out*/) const { return false; }
+
     virtual std::string to_string() { return "Shape"; }
 
     friend std::ostream& operator<<(std::ostream& stream, Shape& shape) {
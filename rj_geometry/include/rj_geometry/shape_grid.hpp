@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "rect.hpp"
+#include "shape.hpp"
+
+namespace rj_geometry {
+
+/**
+ * A uniform grid over the bounding boxes of a list of shapes, used by ShapeSet
+ * as a broad phase for collision queries. Each cell stores the indices of the
+ * shapes whose (padded) bounding box overlaps it, so a query only has to run
+ * the exact hit test on shapes that are nearby.
+ *
+ * The grid is immutable once built and refers to shapes by their index in the
+ * list it was built from, so it must be rebuilt whenever that list changes.
+ */
+class ShapeGrid {
+public:
+    /// Target edge length of a grid cell, in meters.
+    static constexpr double kCellSize = 0.5;
+
+    /// Upper bound on the number of cells along each axis.
+    static constexpr int kMaxCellsPerAxis = 64;
+
+    /**
+     * Builds a grid over the given shapes.
+     *
+     * @param shapes The shapes to index
+     * @param padding Distance to grow each bounding box by, so that anything
+     *     within @padding of a shape is still reported as a candidate
+     */
+    ShapeGrid(const std::vector<std::shared_ptr<Shape>>& shapes, double padding);
+
+    /**
+     * Calls @fn(index, box) for every shape that may touch @query, stopping
+     * as soon as @fn returns true. @box is the shape's padded bounding box, or
+     * nullptr for shapes without one, which are always reported. Each shape is
+     * reported at most once.
+     *
+     * @return True if @fn returned true for some shape
+     */
+    template <typename Fn>
+    bool any_candidate(const Rect& query, Fn&& fn) const {
+        for (int index : unbounded_) {
+            if (fn(index, static_cast<const Rect*>(nullptr))) {
+                return true;
+            }
+        }
+
+        if (entries_.empty() || !bounds_.intersects(query)) {
+            return false;
+        }
+
+        const int min_cx = cell_x(query.minx());
+        const int max_cx = cell_x(query.maxx());
+        const int min_cy = cell_y(query.miny());
+        const int max_cy = cell_y(query.maxy());
+
+        for (int cy = min_cy; cy <= max_cy; cy++) {
+            for (int cx = min_cx; cx <= max_cx; cx++) {
+                const int cell = cy * cells_x_ + cx;
+                for (int i = cell_start_[cell]; i < cell_start_[cell + 1]; i++) {
+                    const Entry& entry = entries_[cell_items_[i]];
+
+                    // A shape spanning several cells is only reported from the
+                    // first cell it shares with the query.
+                    if (cx != std::max(entry.min_cx, min_cx) ||
+                        cy != std::max(entry.min_cy, min_cy)) {
+                        continue;
+                    }
+
+                    if (entry.box.intersects(query) && fn(entry.index, &entry.box)) {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+private:
+    struct Entry {
+        Rect box;
+        int index;
+        int min_cx;
+        int min_cy;
+    };
+
+    [[nodiscard]] int cell_x(double x) const {
+        return std::clamp(static_cast<int>(std::floor((x - origin_x_) / cell_width_)), 0,
+                          cells_x_ - 1);
+    }
+
+    [[nodiscard]] int cell_y(double y) const {
+        return std::clamp(static_cast<int>(std::floor((y - origin_y_) / cell_height_)), 0,
+                          cells_y_ - 1);
+    }
+
+    Rect bounds_;
+    double origin_x_ = 0;
+    double origin_y_ = 0;
+    double cell_width_ = 1;
+    double cell_height_ = 1;
+    int cells_x_ = 0;
+    int cells_y_ = 0;
+
+    std::vector<Entry> entries_;
+    std::vector<int> unbounded_;
+
+    // Compressed cell lists: the entries overlapping cell c are
+    // cell_items_[cell_start_[c]] through cell_items_[cell_start_[c + 1] - 1].
+    std::vector<int> cell_start_;
+    std::vector<int> cell_items_;
+};
+
+}  // namespace rj_geometry
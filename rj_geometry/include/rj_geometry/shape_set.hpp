@@ -5,18 +5,45 @@
 #include <sstream>
 #include <vector>
 
+#include <rj_constants/constants.hpp>
 #include <rj_geometry_msgs/msg/shape_set.hpp>
 
+#include "rect.hpp"
+#include "segment.hpp"
 #include "shape.hpp"
+#include "shape_grid.hpp"
 
 namespace rj_geometry {
 
-/// This class maintains a collection of Shape objects.
+/**
+ * This class maintains a collection of Shape objects.
+ *
+ * Point and segment hit queries against sets of at least
+ * kMinShapesForGrid shapes go through a ShapeGrid broad phase, which is built
+ * lazily on the first query after the set changes. Shapes must not be
+ * modified in place after they are added, or the grid will go stale.
+ */
 class ShapeSet {
 public:
     using Msg = rj_geometry_msgs::msg::ShapeSet;
 
+    /// Below this many shapes a linear scan is cheaper than building a grid.
+    static constexpr size_t kMinShapesForGrid = 8;
+
     ShapeSet() = default;
+    ~ShapeSet() = default;
+
+    // The grid is immutable, so copies can share it.
+    ShapeSet(const ShapeSet& other)
+        : shapes_(other.shapes_), grid_(std::atomic_load(&other.grid_)) {}
+    ShapeSet(ShapeSet&& other) noexcept = default;
+
+    ShapeSet& operator=(const ShapeSet& other) {
+        shapes_ = other.shapes_;
+        grid_ = std::atomic_load(&other.grid_);
+        return *this;
+    }
+    ShapeSet& operator=(ShapeSet&& other) noexcept = default;
 
     /// Initializes the set by iterating from @first to @last, which are
     /// iterators into a collection of std::shared_ptr<Shape>.
@@ -27,7 +54,11 @@ public:
         }
     }
 
-    std::vector<std::shared_ptr<Shape>>& shapes() { return shapes_; }
+    /// Mutable access to the shapes. This invalidates the grid.
+    std::vector<std::shared_ptr<Shape>>& shapes() {
+        grid_.reset();
+        return shapes_;
+    }
     [[nodiscard]] const std::vector<std::shared_ptr<Shape>>& shapes() const {
         return shapes_;
     }
@@ -35,6 +66,7 @@ public:
     void add(std::shared_ptr<Shape> shape) {
         assert(shape != nullptr);
         shapes_.push_back(shape);
+        grid_.reset();
     }
 
     void add(const ShapeSet& other) {
@@ -44,7 +76,10 @@ public:
     }
 
     /// Remove all shapes
-    void clear() { shapes_.clear(); }
+    void clear() {
+        shapes_.clear();
+        grid_.reset();
+    }
 
     /**
      * Get a set of which shapes "hit" the given object.
@@ -55,11 +90,10 @@ public:
     template <typename T>
     std::set<std::shared_ptr<Shape>> hit_set(const T& obj) const {
         std::set<std::shared_ptr<Shape>> hits;
-        for (const auto& shape : shapes_) {
-            if (shape->hit(obj)) {
-                hits.insert(shape);
-            }
-        }
+        hit_if(obj, [&](const std::shared_ptr<Shape>& shape) {
+            hits.insert(shape);
+            return false;
+        });
         return hits;
     }
 
@@ -71,8 +105,69 @@ public:
      */
     template <typename T>
     bool hit(const T& obj) const {
+        return hit_if(obj, [](const std::shared_ptr<Shape>& /*shape*/) { return true; });
+    }
+
+    /**
+     * Check if any of the shapes in this set that satisfy a predicate "hit"
+     * the given object. The predicate is only evaluated on shapes that hit.
+     *
+     * @param obj The object to collision test
+     * @param pred Called with each shape that hits @obj; returning true stops
+     *     the search
+     * @return True if @pred returned true for some shape
+     */
+    template <typename T, typename Pred>
+    bool hit_if(const T& obj, Pred&& pred) const {
+        Rect query;
+        const std::shared_ptr<const ShapeGrid> grid =
+            query_box(obj, &query) ? get_grid() : nullptr;
+
+        if (grid == nullptr) {
+            for (const auto& shape : shapes_) {
+                if (shape->hit(obj) && pred(shape)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        return grid->any_candidate(query, [&](int index, const Rect* /*box*/) {
+            const auto& shape = shapes_[index];
+            return shape->hit(obj) && pred(shape);
+        });
+    }
+
+    /**
+     * Broad-phase query: find the shapes that could hit some point inside
+     * @region, i.e. those whose bounding box, padded by a robot radius,
+     * overlaps it. Shapes without a bounding box are always included.
+     *
+     * @param region The area to search
+     * @param fn Called as fn(shape, box) with each candidate and its padded
+     *     bounding box (nullptr if unbounded); returning true stops the search
+     * @return True if @fn returned true for some shape
+     */
+    template <typename Fn>
+    bool visit_near(const Rect& region, Fn&& fn) const {
+        const std::shared_ptr<const ShapeGrid> grid = get_grid();
+        if (grid != nullptr) {
+            return grid->any_candidate(region, [&](int index, const Rect* box) {
+                return fn(shapes_[index], box);
+            });
+        }
+
         for (const auto& shape : shapes_) {
-            if (shape->hit(obj)) {
+            Rect box;
+            if (!shape->bounding_box(&box)) {
+                if (fn(shape, static_cast<const Rect*>(nullptr))) {
+                    return true;
+                }
+                continue;
+            }
+
+            box.pad(static_cast<float>(kShapeGridPadding));
+            if (box.intersects(region) && fn(shape, &box)) {
                 return true;
             }
         }
@@ -90,7 +185,45 @@ public:
     }
 
 private:
+    // The region a hit query can touch, before padding by the robot radius.
+    // Objects without an overload here fall back to a linear scan.
+    static bool query_box(Point pt, Rect* out) {
+        *out = Rect(pt);
+        return true;
+    }
+
+    static bool query_box(const Segment& seg, Rect* out) {
+        *out = Rect(seg.pt[0], seg.pt[1]);
+        return true;
+    }
+
+    template <typename T>
+    static bool query_box(const T& /*obj*/, Rect* /*out*/) {
+        return false;
+    }
+
+    /// Returns the grid for the current shapes, building it if necessary, or
+    /// nullptr if the set is too small to benefit from one.
+    [[nodiscard]] std::shared_ptr<const ShapeGrid> get_grid() const {
+        if (shapes_.size() < kMinShapesForGrid) {
+            return nullptr;
+        }
+
+        // Concurrent readers may both build a grid; either result is valid.
+        std::shared_ptr<const ShapeGrid> grid = std::atomic_load(&grid_);
+        if (grid == nullptr) {
+            grid = std::make_shared<const ShapeGrid>(shapes_, kShapeGridPadding);
+            std::atomic_store(&grid_, grid);
+        }
+        return grid;
+    }
+
+    // Shape::hit() reports anything within a robot radius, plus a millimeter
+    // of slack for float rounding in Rect.
+    static constexpr double kShapeGridPadding = kRobotRadius + 1e-3;
+
     std::vector<std::shared_ptr<Shape>> shapes_;
+    mutable std::shared_ptr<const ShapeGrid> grid_;
 };
 
 }  // namespace rj_geometry
@@ -1,4 +1,5 @@
 #include <rj_geometry/circle.hpp>
+#include <rj_geometry/rect.hpp>
 #include <rj_geometry/segment.hpp>
 #include <rj_constants/constants.hpp>
 
@@ -158,4 +159,10 @@ bool Circle::near_point(Point pt, float threshold) const {
     return center.near_point(pt, threshold + radius());
 }
 
+bool Circle::bounding_box(Rect* out) const {
+    const Point extent(radius(), radius());
+    *out = Rect(center - extent, center + extent);
+    return true;
+}
+
 }  // namespace rj_geometry
@@ -1,4 +1,5 @@
 #include <rj_geometry/composite_shape.hpp>
+#include <rj_geometry/rect.hpp>
 
 namespace rj_geometry {
 
@@ -22,6 +23,29 @@ bool CompositeShape::near_point(Point pt, float threshold) const {
     return false;
 }
 
+bool CompositeShape::bounding_box(Rect* out) const {
+    if (subshapes_.empty()) {
+        return false;
+    }
+
+    Rect bounds;
+    for (size_t i = 0; i < subshapes_.size(); i++) {
+        Rect sub_bounds;
+        if (!subshapes_[i]->bounding_box(&sub_bounds)) {
+            return false;
+        }
+
+        if (i == 0) {
+            bounds = sub_bounds;
+        } else {
+            bounds.expand(sub_bounds);
+        }
+    }
+
+    *out = bounds;
+    return true;
+}
+
 void CompositeShape::add(const std::shared_ptr<Shape>& shape) {
     if (shape != nullptr) {
         subshapes_.push_back(shape);
@@ -45,6 +45,15 @@ Rect Polygon::bbox() const {
     return rect;
 }
 
+bool Polygon::bounding_box(Rect* out) const {
+    if (vertices.empty()) {
+        return false;
+    }
+
+    *out = bbox();
+    return true;
+}
+
 bool Polygon::intersects(const Rect& rect) const { return intersects(Polygon(rect)); }
 
 bool Polygon::intersects(const Polygon& other) const {
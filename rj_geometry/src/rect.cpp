@@ -148,6 +148,11 @@ bool Rect::hit(const Segment& seg) const { return near_segment(seg, kRobotRadius
 
 bool Rect::hit(Point point) const { return near_point(point, kRobotRadius); }
 
+bool Rect::bounding_box(Rect* out) const {
+    *out = *this;
+    return true;
+}
+
 void Rect::expand(Point p) {
     float min_x = minx();
     float min_y = miny();
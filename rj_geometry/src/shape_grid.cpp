@@ -0,0 +1,64 @@
+#include <rj_geometry/shape_grid.hpp>
+
+namespace rj_geometry {
+
+ShapeGrid::ShapeGrid(const std::vector<std::shared_ptr<Shape>>& shapes, double padding) {
+    for (int i = 0; i < static_cast<int>(shapes.size()); i++) {
+        Rect box;
+        if (!shapes[i]->bounding_box(&box)) {
+            unbounded_.push_back(i);
+            continue;
+        }
+
+        box.pad(static_cast<float>(padding));
+        if (entries_.empty()) {
+            bounds_ = box;
+        } else {
+            bounds_.expand(box);
+        }
+        entries_.push_back(Entry{box, i, 0, 0});
+    }
+
+    if (entries_.empty()) {
+        return;
+    }
+
+    origin_x_ = bounds_.minx();
+    origin_y_ = bounds_.miny();
+
+    const double width = bounds_.maxx() - bounds_.minx();
+    const double height = bounds_.maxy() - bounds_.miny();
+    cells_x_ = std::clamp(static_cast<int>(std::ceil(width / kCellSize)), 1, kMaxCellsPerAxis);
+    cells_y_ = std::clamp(static_cast<int>(std::ceil(height / kCellSize)), 1, kMaxCellsPerAxis);
+    cell_width_ = std::max(width / cells_x_, 1e-6);
+    cell_height_ = std::max(height / cells_y_, 1e-6);
+
+    // Two passes: count the entries in each cell, then fill them in.
+    cell_start_.assign(cells_x_ * cells_y_ + 1, 0);
+    for (Entry& entry : entries_) {
+        entry.min_cx = cell_x(entry.box.minx());
+        entry.min_cy = cell_y(entry.box.miny());
+        for (int cy = entry.min_cy; cy <= cell_y(entry.box.maxy()); cy++) {
+            for (int cx = entry.min_cx; cx <= cell_x(entry.box.maxx()); cx++) {
+                cell_start_[cy * cells_x_ + cx + 1]++;
+            }
+        }
+    }
+
+    for (size_t cell = 1; cell < cell_start_.size(); cell++) {
+        cell_start_[cell] += cell_start_[cell - 1];
+    }
+
+    std::vector<int> fill(cell_start_.begin(), cell_start_.end() - 1);
+    cell_items_.resize(cell_start_.back());
+    for (int i = 0; i < static_cast<int>(entries_.size()); i++) {
+        const Entry& entry = entries_[i];
+        for (int cy = entry.min_cy; cy <= cell_y(entry.box.maxy()); cy++) {
+            for (int cx = entry.min_cx; cx <= cell_x(entry.box.maxx()); cx++) {
+                cell_items_[fill[cy * cells_x_ + cx]++] = i;
+            }
+        }
+    }
+}
+
+}  // namespace rj_geometry
@@ -0,0 +1,125 @@
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rj_geometry/circle.hpp"
+#include "rj_geometry/composite_shape.hpp"
+#include "rj_geometry/polygon.hpp"
+#include "rj_geometry/rect.hpp"
+#include "rj_geometry/segment.hpp"
+#include "rj_geometry/shape_set.hpp"
+
+namespace rj_geometry::Testing {
+
+namespace {
+
+/// A field's worth of obstacles: a row of robots, a wall and a goal box.
+ShapeSet make_crowded_set() {
+    ShapeSet set;
+    for (int i = 0; i < 12; i++) {
+        set.add(std::make_shared<Circle>(Point(-3.0 + 0.5 * i, 4.5), 0.09));
+    }
+    set.add(std::make_shared<Rect>(Point(-4.5, -0.2), Point(4.5, -0.1)));
+    set.add(std::make_shared<Polygon>(
+        std::vector<Point>{Point(-1, 8), Point(1, 8), Point(1, 9), Point(-1, 9)}));
+    return set;
+}
+
+/// The same queries answered without the grid.
+bool linear_hit(const ShapeSet& set, const Segment& seg) {
+    for (const auto& shape : set.shapes()) {
+        if (shape->hit(seg)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(ShapeSet, BoundingBox) {
+    Rect box;
+
+    EXPECT_TRUE(Circle(Point(1, 2), 0.5).bounding_box(&box));
+    EXPECT_NEAR(box.minx(), 0.5, 1e-6);
+    EXPECT_NEAR(box.maxy(), 2.5, 1e-6);
+
+    EXPECT_TRUE(Rect(Point(3, 4), Point(1, 2)).bounding_box(&box));
+    EXPECT_NEAR(box.minx(), 1, 1e-6);
+    EXPECT_NEAR(box.maxy(), 4, 1e-6);
+
+    EXPECT_FALSE(Polygon().bounding_box(&box));
+    EXPECT_FALSE(CompositeShape().bounding_box(&box));
+
+    CompositeShape composite;
+    composite.add(std::make_shared<Circle>(Point(0, 0), 1));
+    composite.add(std::make_shared<Rect>(Point(2, 2), Point(3, 3)));
+    EXPECT_TRUE(composite.bounding_box(&box));
+    EXPECT_NEAR(box.minx(), -1, 1e-6);
+    EXPECT_NEAR(box.maxx(), 3, 1e-6);
+}
+
+TEST(ShapeSet, PointHits) {
+    ShapeSet set = make_crowded_set();
+    ASSERT_GE(set.shapes().size(), ShapeSet::kMinShapesForGrid);
+
+    EXPECT_TRUE(set.hit(Point(-3.0, 4.5)));
+    // Within a robot radius of the robot, but outside its circle.
+    EXPECT_TRUE(set.hit(Point(-3.0, 4.5 + 0.15)));
+    EXPECT_TRUE(set.hit(Point(0, 8.5)));
+    EXPECT_TRUE(set.hit(Point(4.4, -0.15)));
+
+    EXPECT_FALSE(set.hit(Point(0, 2)));
+    EXPECT_FALSE(set.hit(Point(-20, 20)));
+
+    EXPECT_EQ(set.hit_set(Point(-3.0, 4.5)).size(), 1);
+    EXPECT_EQ(set.hit_set(Point(0, 2)).size(), 0);
+}
+
+TEST(ShapeSet, SegmentHitsMatchLinearScan) {
+    ShapeSet set = make_crowded_set();
+
+    for (double x0 = -5; x0 <= 5; x0 += 0.37) {
+        for (double y1 = -1; y1 <= 10; y1 += 0.41) {
+            Segment seg(Point(x0, -1), Point(-x0 * 0.5, y1));
+            EXPECT_EQ(set.hit(seg), linear_hit(set, seg));
+        }
+    }
+
+    // A long segment that crosses every robot should report each one once.
+    Segment across(Point(-4, 4.5), Point(4, 4.5));
+    EXPECT_EQ(set.hit_set(across).size(), 12);
+}
+
+TEST(ShapeSet, HitIf) {
+    ShapeSet set = make_crowded_set();
+    const Point start(-3.0, 4.5);
+    const auto start_hits = set.hit_set(start);
+
+    Segment seg(start, Point(-2.5, 4.5));
+    EXPECT_TRUE(set.hit_if(seg, [&](const std::shared_ptr<Shape>& shape) {
+        return start_hits.find(shape) == start_hits.end();
+    }));
+
+    Segment away(start, Point(-3.0, 3.0));
+    EXPECT_FALSE(set.hit_if(away, [&](const std::shared_ptr<Shape>& shape) {
+        return start_hits.find(shape) == start_hits.end();
+    }));
+}
+
+TEST(ShapeSet, GridRebuiltOnAdd) {
+    ShapeSet set = make_crowded_set();
+    EXPECT_FALSE(set.hit(Point(0, 2)));
+
+    set.add(std::make_shared<Circle>(Point(0, 2), 0.09));
+    EXPECT_TRUE(set.hit(Point(0, 2)));
+
+    // A copy shares the grid, but stays independent of later changes.
+    ShapeSet copy = set;
+    copy.clear();
+    EXPECT_FALSE(copy.hit(Point(0, 2)));
+    EXPECT_TRUE(set.hit(Point(0, 2)));
+}
+
+}  // namespace rj_geometry::Testing
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <rclcpp/rclcpp.hpp>
+
+namespace rj_utils {
+
+/**
+ * Options for publishers on the hot path (detection frames, world state,
+ * trajectories, setpoints).
+ *
+ * When the publisher and its subscribers are loaded into the same component
+ * container, messages are handed over as pointers instead of being
+ * serialized through DDS; subscribers in other processes still get them the
+ * usual way. This is turned on per topic rather than for whole nodes because
+ * intra-process delivery only supports volatile durability, and some of our
+ * topics (team color, play state) are transient local.
+ *
+ * Publish these topics as unique_ptrs so the message can be moved to the
+ * last subscriber without a copy.
+ */
+inline rclcpp::PublisherOptions intra_process_publisher_options() {
+    rclcpp::PublisherOptions options;
+    options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+    return options;
+}
+
+/**
+ * Options for subscriptions to hot path topics. See
+ * intra_process_publisher_options().
+ *
+ * Take these messages as ConstSharedPtr so that every subscriber in the
+ * process can share one copy.
+ */
+inline rclcpp::SubscriptionOptions intra_process_subscription_options() {
+    rclcpp::SubscriptionOptions options;
+    options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+    return options;
+}
+
+}  // namespace rj_utils
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <builtin_interfaces/msg/time.hpp>
+
+namespace rj_utils {
+
+/**
+ * Hops a vision frame takes on its way to becoming a robot command. Each
+ * stage is recorded by the node where it ends, against the stamps carried in
+ * the message's rj_msgs/FrameTrace.
+ */
+enum class LatencyStage : uint8_t {
+    // Camera capture to vision_receiver getting the packet
+    kCaptureToReceive,
+    // vision_receiver to vision_filter publishing a world state
+    kReceiveToFilter,
+    // World state to planner publishing a trajectory
+    kFilterToPlan,
+    // World state to motion control publishing a setpoint
+    kFilterToControl,
+    // Setpoint to the radio sending it
+    kControlToRadio,
+    // Camera capture to the radio sending the command
+    kEndToEnd,
+    kNumStages
+};
+
+/**
+ * @return Name of the stage, as used in the exported CSV
+ */
+const char* to_string(LatencyStage stage);
+
+/**
+ * Per-stage latency histograms shared by everything in the process.
+ *
+ * Recording is a handful of relaxed atomic adds, so any thread (callbacks,
+ * planner workers, the radio) can record without locking or allocating.
+ * Buckets are kBucketWidth wide, and the last bucket collects everything
+ * that didn't fit.
+ *
+ * If RJ_LATENCY_TRACE_DIR is set, the global recorder writes its histograms to
+ * latency_<pid>.csv in that directory when the process exits.
+ */
+class LatencyRecorder {
+public:
+    static constexpr std::chrono::microseconds kBucketWidth{100};
+    static constexpr size_t kNumBuckets = 256;
+
+    struct Summary {
+        uint64_t count = 0;
+        double mean_ms = 0;
+        double max_ms = 0;
+        // Upper edges of the buckets holding these percentiles
+        double p50_ms = 0;
+        double p99_ms = 0;
+    };
+
+    LatencyRecorder() = default;
+    ~LatencyRecorder();
+
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+    LatencyRecorder(LatencyRecorder&&) = delete;
+    LatencyRecorder& operator=(LatencyRecorder&&) = delete;
+
+    /**
+     * @return The recorder shared by the whole process
+     */
+    static LatencyRecorder& global();
+
+    /**
+     * Adds one sample. Negative latencies (clock skew) count as zero.
+     */
+    void record(LatencyStage stage, std::chrono::nanoseconds latency);
+
+    /**
+     * Adds the time between two trace stamps. Does nothing if @start is
+     * zero, which is how untraced messages leave it.
+     */
+    void record(LatencyStage stage, const builtin_interfaces::msg::Time& start,
+                const builtin_interfaces::msg::Time& end);
+
+    [[nodiscard]] Summary summary(LatencyStage stage) const;
+
+    /**
+     * Writes every non-empty bucket as "stage,bucket_end_ms,count" rows.
+     */
+    void write_csv(std::ostream& out) const;
+
+    /**
+     * Path the histograms get written to at exit, empty to not write them
+     */
+    void set_export_path(std::string path) { export_path_ = std::move(path); }
+
+private:
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, kNumBuckets> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+    };
+
+    std::array<Histogram, static_cast<size_t>(LatencyStage::kNumStages)> histograms_{};
+
+    std::string export_path_;
+};
+
+}  // namespace rj_utils
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rj_utils {
+
+/**
+ * A fixed set of worker threads that runs batches of tasks, e.g. one
+ * planning task per robot per frame, or one vision update per camera.
+ *
+ * Threads are created once and parked between batches, so dispatching a batch
+ * costs a notify rather than a thread spawn. Idle threads (including the
+ * caller) steal the next unclaimed task from the shared batch, so one slow
+ * task doesn't hold up the ones queued behind it.
+ */
+class WorkerPool {
+public:
+    /**
+     * @param num_threads Total threads working on a batch, counting the
+     *     thread that calls run_all(). Defaults to the number of cores.
+     */
+    explicit WorkerPool(size_t num_threads = std::thread::hardware_concurrency());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /**
+     * Runs every task in @tasks and blocks until all of them have finished
+     * (the frame barrier). The calling thread works on tasks too.
+     *
+     * If any task throws, the first exception is rethrown here after the
+     * whole batch has finished.
+     *
+     * Not reentrant: only one thread may call run_all() at a time.
+     */
+    void run_all(const std::vector<std::function<void()>>& tasks);
+
+    /// Number of threads that work on a batch, counting the caller.
+    [[nodiscard]] size_t num_threads() const { return workers_.size() + 1; }
+
+private:
+    void worker_loop();
+
+    // Claim and run tasks from the current batch until none are left.
+    void drain_batch();
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable batch_ready_;
+    std::condition_variable batch_done_;
+
+    // Protected by mutex_.
+    const std::vector<std::function<void()>>* tasks_ = nullptr;
+    uint64_t generation_ = 0;
+    size_t num_remaining_ = 0;
+    std::exception_ptr first_error_;
+    size_t next_task_ = 0;
+    bool stopping_ = false;
+};
+
+}  // namespace rj_utils
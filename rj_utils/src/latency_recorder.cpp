@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <rj_utils/latency_recorder.hpp>
+
+namespace rj_utils {
+
+namespace {
+
+int64_t to_nanoseconds(const builtin_interfaces::msg::Time& time) {
+    return static_cast<int64_t>(time.sec) * 1'000'000'000 + time.nanosec;
+}
+
+double to_milliseconds(uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1e6; }
+
+double bucket_end_ms(size_t bucket) {
+    return std::chrono::duration<double, std::milli>(LatencyRecorder::kBucketWidth).count() *
+           static_cast<double>(bucket + 1);
+}
+
+}  // namespace
+
+const char* to_string(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::kCaptureToReceive:
+            return "capture_to_receive";
+        case LatencyStage::kReceiveToFilter:
+            return "receive_to_filter";
+        case LatencyStage::kFilterToPlan:
+            return "filter_to_plan";
+        case LatencyStage::kFilterToControl:
+            return "filter_to_control";
+        case LatencyStage::kControlToRadio:
+            return "control_to_radio";
+        case LatencyStage::kEndToEnd:
+            return "end_to_end";
+        default:
+            return "unknown";
+    }
+}
+
+LatencyRecorder::~LatencyRecorder() {
+    if (export_path_.empty()) {
+        return;
+    }
+
+    std::ofstream out{export_path_};
+    write_csv(out);
+}
+
+LatencyRecorder& LatencyRecorder::global() {
+    static LatencyRecorder recorder;
+    static const bool kExportPathSet = [] {
+        const char* dir = std::getenv("RJ_LATENCY_TRACE_DIR");
+        if (dir == nullptr) {
+            return false;
+        }
+        recorder.set_export_path(std::string{dir} + "/latency_" + std::to_string(getpid()) +
+                                 ".csv");
+        return true;
+    }();
+    static_cast<void>(kExportPathSet);
+    return recorder;
+}
+
+void LatencyRecorder::record(LatencyStage stage, std::chrono::nanoseconds latency) {
+    Histogram& histogram = histograms_.at(static_cast<size_t>(stage));
+
+    const uint64_t ns = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+    const size_t bucket =
+        std::min<uint64_t>(ns / std::chrono::nanoseconds(kBucketWidth).count(), kNumBuckets - 1);
+
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t max = histogram.max_ns.load(std::memory_order_relaxed);
+    while (ns > max &&
+           !histogram.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyRecorder::record(LatencyStage stage, const builtin_interfaces::msg::Time& start,
+                             const builtin_interfaces::msg::Time& end) {
+    if (start.sec == 0 && start.nanosec == 0) {
+        return;
+    }
+
+    record(stage, std::chrono::nanoseconds(to_nanoseconds(end) - to_nanoseconds(start)));
+}
+
+LatencyRecorder::Summary LatencyRecorder::summary(LatencyStage stage) const {
+    const Histogram& histogram = histograms_.at(static_cast<size_t>(stage));
+
+    Summary summary;
+    summary.count = histogram.count.load(std::memory_order_relaxed);
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    summary.mean_ms =
+        to_milliseconds(histogram.sum_ns.load(std::memory_order_relaxed)) / summary.count;
+    summary.max_ms = to_milliseconds(histogram.max_ns.load(std::memory_order_relaxed));
+
+    // Samples keep landing while we read, so walk the buckets against their
+    // own total rather than the count read above
+    std::array<uint64_t, kNumBuckets> buckets{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        total += buckets[i];
+    }
+
+    uint64_t seen = 0;
+    bool found_p50 = false;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        seen += buckets[i];
+        if (!found_p50 && seen * 2 >= total) {
+            summary.p50_ms = bucket_end_ms(i);
+            found_p50 = true;
+        }
+        if (seen * 100 >= total * 99) {
+            summary.p99_ms = bucket_end_ms(i);
+            break;
+        }
+    }
+
+    return summary;
+}
+
+void LatencyRecorder::write_csv(std::ostream& out) const {
+    out << "stage,bucket_end_ms,count\n";
+    for (size_t stage = 0; stage < histograms_.size(); stage++) {
+        const Histogram& histogram = histograms_[stage];
+        for (size_t i = 0; i < kNumBuckets; i++) {
+            const uint64_t count = histogram.buckets[i].load(std::memory_order_relaxed);
+            if (count > 0) {
+                out << to_string(static_cast<LatencyStage>(stage)) << "," << bucket_end_ms(i)
+                    << "," << count << "\n";
+            }
+        }
+    }
+}
+
+}  // namespace rj_utils
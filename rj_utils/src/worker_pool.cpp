@@ -0,0 +1,97 @@
+#include <rj_utils/worker_pool.hpp>
+
+namespace rj_utils {
+
+WorkerPool::WorkerPool(size_t num_threads) {
+    // The thread calling run_all() is one of the workers.
+    const size_t num_workers = num_threads > 1 ? num_threads - 1 : 0;
+    workers_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; i++) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    batch_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run_all(const std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_ = &tasks;
+        num_remaining_ = tasks.size();
+        first_error_ = nullptr;
+        next_task_ = 0;
+        generation_++;
+    }
+    batch_ready_.notify_all();
+
+    drain_batch();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        batch_done_.wait(lock, [this]() { return num_remaining_ == 0; });
+        tasks_ = nullptr;
+        error = first_error_;
+    }
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::worker_loop() {
+    uint64_t last_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            batch_ready_.wait(lock,
+                              [&]() { return stopping_ || generation_ != last_generation; });
+            if (stopping_) {
+                return;
+            }
+            last_generation = generation_;
+        }
+
+        drain_batch();
+    }
+}
+
+void WorkerPool::drain_batch() {
+    // Tasks are claimed under the lock, so a thread that shows up late can't
+    // claim a task from a batch that has already finished.
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (tasks_ != nullptr && next_task_ < tasks_->size()) {
+        const std::function<void()>& task = (*tasks_)[next_task_++];
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error != nullptr && first_error_ == nullptr) {
+            first_error_ = error;
+        }
+        if (--num_remaining_ == 0) {
+            batch_done_.notify_all();
+        }
+    }
+}
+
+}  // namespace rj_utils
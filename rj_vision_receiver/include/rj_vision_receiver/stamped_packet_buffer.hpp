@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <rclcpp/time.hpp>
+
+namespace vision_receiver {
+/**
+ * @brief A reusable buffer holding one raw vision datagram and the time it
+ * was received.
+ *
+ * @details Buffers are allocated once and recycled between the network and
+ * publish threads, so the packet bytes are never copied on the way in.
+ */
+struct StampedPacketBuffer {
+    using UniquePtr = std::unique_ptr<StampedPacketBuffer>;
+
+    // Largest UDP payload we can get
+    static constexpr size_t kCapacity = 65536;
+
+    std::vector<uint8_t> data = std::vector<uint8_t>(kCapacity);
+    size_t num_bytes = 0;
+    rclcpp::Time receive_time;
+};
+}  // namespace vision_receiver
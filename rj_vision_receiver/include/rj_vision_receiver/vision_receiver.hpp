@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
+#include <sys/socket.h>
+
 #include <boost/asio.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -13,7 +17,7 @@
 #include <rj_param_utils/ros2_local_param_provider.hpp>
 #include <rj_protos/ssl_vision_wrapper.pb.h>
 #include <rj_utils/concurrent_queue.hpp>
-#include <rj_vision_receiver/stamped_wrapper_packet.hpp>
+#include <rj_vision_receiver/stamped_packet_buffer.hpp>
 
 namespace vision_receiver {
 using RawProtobufMsg = rj_msgs::msg::RawProtobuf;
@@ -29,22 +33,46 @@ using DetectionRobotMsg = rj_msgs::msg::DetectionRobot;
  * UDP port for packets. If sim = true, it tries both simulator ports until one
  * works. Otherwise, it connects to the port specified in the constructor.
  *
- * Whenever a new packet comes in (encoded as Google Protobuf), it is parsed
- * into an SSL_WrapperPacket and placed onto the circular buffer @_packets.
- * They remain there until they are retrieved with get_packets().
+ * Whenever the socket becomes readable, every queued datagram is read in one
+ * recvmmsg() call straight into buffers taken from a preallocated pool, and
+ * the buffers are handed to the publish thread. The publish thread parses each
+ * one into a reused SSL_WrapperPacket, publishes it, and returns the buffer to
+ * the pool.
  */
 class VisionReceiver : public rclcpp::Node {
 public:
     static constexpr std::chrono::milliseconds kTimeout{100};
 
-    VisionReceiver();
+    // Max number of datagrams read per recvmmsg() call
+    static constexpr size_t kReceiveBatchSize = 8;
+
+    // Number of packet buffers allocated up front
+    static constexpr size_t kNumPacketBuffers = 16;
+
+    explicit VisionReceiver(const rclcpp::NodeOptions& options = rclcpp::NodeOptions{});
+    ~VisionReceiver() override;
+
+    VisionReceiver(const VisionReceiver&) = delete;
+    VisionReceiver& operator=(const VisionReceiver&) = delete;
+    VisionReceiver(VisionReceiver&&) = delete;
+    VisionReceiver& operator=(VisionReceiver&&) = delete;
 
     void set_port(const std::string& interface, int port);
 
 private:
     void start_receive();
-    void receive_packet(const boost::system::error_code& error,
-                       std::size_t num_bytes);
+
+    /**
+     * @brief Reads every datagram waiting on the socket, in batches, without
+     * blocking.
+     */
+    void receive_packets(const boost::system::error_code& error);
+
+    /**
+     * @brief Takes a buffer from the pool, or allocates a new one if the
+     * publish thread is holding all of them.
+     */
+    StampedPacketBuffer::UniquePtr take_buffer();
 
     /**
      * @brief Handles the network packets for vision.
@@ -71,8 +99,9 @@ private:
     /**
      * @brief Process new packets
      *
-     * Publishes the raw packet. If the packet has geometry info, publish that.
-     * If it has detection information, also publish that.
+     * Publishes the raw packet if anyone is listening. If the packet has
+     * geometry info, publish that. If it has detection information, also
+     * publish that.
      */
     void process_one_packet();
 
@@ -103,24 +132,36 @@ private:
      * synchronization.
      * @param frame
      * @param received_time Time that this packet was received.
-     * @return
+     * @param msg[out] Message to fill in
      */
-    [[nodiscard]] DetectionFrameMsg construct_ros_msg(
-        const SSL_DetectionFrame& frame,
-        const rclcpp::Time& received_time) const;
+    void construct_ros_msg(const SSL_DetectionFrame& frame,
+                           const rclcpp::Time& received_time,
+                           DetectionFrameMsg* msg) const;
 
     config_client::ConfigClient config_;
     int port_;
 
-    std::vector<uint8_t> recv_buffer_{};
-
     boost::asio::io_service io_context_;
     boost::asio::ip::udp::socket socket_;
-    boost::asio::ip::udp::endpoint sender_endpoint_;
     std::thread network_thread_;
     std::thread publish_thread_;
-
-    rj_utils::ConcurrentQueue<StampedSSLWrapperPacket::UniquePtr> packets_;
+    // Cleared to stop both threads when the node is destroyed, which in a
+    // component container can happen well before shutdown
+    std::atomic_bool running_{true};
+
+    // Received packets waiting to be published, and empty buffers waiting to
+    // be received into
+    rj_utils::ConcurrentQueue<StampedPacketBuffer::UniquePtr> packets_;
+    rj_utils::ConcurrentQueue<StampedPacketBuffer::UniquePtr> free_buffers_;
+
+    // recvmmsg() scratch, only touched by the network thread
+    std::array<StampedPacketBuffer::UniquePtr, kReceiveBatchSize> batch_buffers_;
+    std::array<mmsghdr, kReceiveBatchSize> batch_headers_{};
+    std::array<iovec, kReceiveBatchSize> batch_iovecs_{};
+
+    // Parsed into on every packet so its submessages are reused, only
+    // touched by the publish thread
+    SSL_WrapperPacket wrapper_;
 
     rclcpp::Publisher<RawProtobufMsg>::SharedPtr raw_packet_pub_;
     rclcpp::Publisher<DetectionFrameMsg>::SharedPtr detection_frame_pub_;
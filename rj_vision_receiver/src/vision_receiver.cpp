@@ -1,7 +1,10 @@
+#include <cerrno>
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 #include <boost/exception/diagnostic_information.hpp>
+#include <rclcpp_components/register_node_macro.hpp>
 #include <spdlog/spdlog.h>
 
 #include <rj_common/field_dimensions.hpp>
@@ -9,6 +12,7 @@
 #include <rj_constants/topic_names.hpp>
 #include <rj_convert/ros_convert.hpp>
 #include <rj_utils/conversions.hpp>
+#include <rj_utils/intra_process.hpp>
 #include <rj_utils/logging_macros.hpp>
 #include <rj_vision_receiver/vision_receiver.hpp>
 
@@ -17,15 +21,17 @@ constexpr auto kVisionReceiverParamModule = "vision_receiver";
 namespace vision_receiver {
 using boost::asio::ip::udp;
 
-VisionReceiver::VisionReceiver()
-    : Node{"vision_receiver", rclcpp::NodeOptions{}
+VisionReceiver::VisionReceiver(const rclcpp::NodeOptions& options)
+    : Node{"vision_receiver", rclcpp::NodeOptions{options}
                                   .automatically_declare_parameters_from_overrides(true)
                                   .allow_undeclared_parameters(true)},
       config_{this},
       port_{-1},
       socket_{io_context_},
       param_provider_(this, kVisionReceiverParamModule) {
-    recv_buffer_.resize(65536);
+    for (size_t i = 0; i < kNumPacketBuffers; i++) {
+        free_buffers_.push(std::make_unique<StampedPacketBuffer>());
+    }
 
     /* below, vision_interface should be IP where vision receiver pubs to (in
      * scrim-2022 this was same IP as ext ref)
@@ -52,20 +58,26 @@ VisionReceiver::VisionReceiver()
     set_port(param_vision_interface_, param_port_);
 
     raw_packet_pub_ = create_publisher<RawProtobufMsg>(topics::kRawProtobufTopic, 10);
-    detection_frame_pub_ = create_publisher<DetectionFrameMsg>(topics::kDetectionFrameTopic, 10);
+    detection_frame_pub_ = create_publisher<DetectionFrameMsg>(
+        topics::kDetectionFrameTopic, 10, rj_utils::intra_process_publisher_options());
 
     // Spin off threads for the networking part and the publishing part.
     network_thread_ = std::thread{&VisionReceiver::receive_thread, this};
     publish_thread_ = std::thread{&VisionReceiver::publish_thread, this};
+}
 
-    rclcpp::on_shutdown([this]() {
+VisionReceiver::~VisionReceiver() {
+    running_ = false;
+    if (network_thread_.joinable()) {
         network_thread_.join();
+    }
+    if (publish_thread_.joinable()) {
         publish_thread_.join();
-    });
+    }
 }
 
 void VisionReceiver::receive_thread() {
-    while (rclcpp::ok()) {
+    while (rclcpp::ok() && running_) {
         io_context_.run_for(kTimeout);
     }
 }
@@ -77,7 +89,7 @@ void VisionReceiver::publish_thread() {
         return;
     }
 
-    while (rclcpp::ok()) {
+    while (rclcpp::ok() && running_) {
         // Blocking call to get one packet and process it.
         process_one_packet();
     }
@@ -120,77 +132,88 @@ void VisionReceiver::set_port(const std::string& interface, int port) {
 
 void VisionReceiver::process_one_packet() {
     // Get a packet, with blocking.
-    StampedSSLWrapperPacket::UniquePtr packet;
+    StampedPacketBuffer::UniquePtr packet;
     if (!packets_.try_get(packet, kTimeout)) {
         return;
     }
 
-    // Publish raw packet
-    RawProtobufMsg::UniquePtr raw_protobuf_msg = to_ros_msg(packet->wrapper);
-    raw_packet_pub_->publish(std::move(raw_protobuf_msg));
+    // Parse the protobuf message. This reuses the submessages allocated by
+    // earlier packets.
+    if (!wrapper_.ParseFromArray(packet->data.data(), static_cast<int>(packet->num_bytes))) {
+        EZ_ERROR_STREAM("Got bad packet of " << packet->num_bytes << " bytes");
+        free_buffers_.push(std::move(packet));
+        return;
+    }
+
+    // Publish the raw packet as we received it, skipping the copy if no one
+    // is listening
+    if (raw_packet_pub_->get_subscription_count() > 0) {
+        RawProtobufMsg::UniquePtr raw_protobuf_msg = std::make_unique<RawProtobufMsg>();
+        raw_protobuf_msg->data.assign(packet->data.begin(),
+                                      packet->data.begin() + packet->num_bytes);
+        raw_packet_pub_->publish(std::move(raw_protobuf_msg));
+    }
+
+    const rclcpp::Time receive_time = packet->receive_time;
+    free_buffers_.push(std::move(packet));
 
     // If packet has geometry data, attempt to read information and
     // update if changed.
-    if (packet->wrapper.has_geometry()) {
-        update_geometry_packet(packet->wrapper.geometry().field());
+    if (wrapper_.has_geometry()) {
+        update_geometry_packet(wrapper_.geometry().field());
     }
 
     // If the packet has detection data, publish it.
-    if (packet->wrapper.has_detection()) {
-        SSL_DetectionFrame* det = packet->wrapper.mutable_detection();
-
-        DetectionFrameMsg::UniquePtr detection_frame_msg =
-            std::make_unique<DetectionFrameMsg>(construct_ros_msg(*det, packet->receive_time));
-        sync_detection_timestamp(detection_frame_msg.get(), packet->receive_time);
+    if (wrapper_.has_detection()) {
+        DetectionFrameMsg::UniquePtr detection_frame_msg = std::make_unique<DetectionFrameMsg>();
+        construct_ros_msg(wrapper_.detection(), receive_time, detection_frame_msg.get());
+        sync_detection_timestamp(detection_frame_msg.get(), receive_time);
 
         detection_frame_pub_->publish(std::move(detection_frame_msg));
     }
 }
 
-DetectionFrameMsg VisionReceiver::construct_ros_msg(const SSL_DetectionFrame& frame,
-                                                    const rclcpp::Time& received_time) const {
-    DetectionFrameMsg msg{};
-
-    msg.frame_number = frame.frame_number();
-    msg.t_capture = to_ros_time(frame.t_capture());
-    msg.t_sent = to_ros_time(frame.t_sent());
-    msg.t_received = received_time;
-    msg.camera_id = frame.camera_id();
+void VisionReceiver::construct_ros_msg(const SSL_DetectionFrame& frame,
+                                       const rclcpp::Time& received_time,
+                                       DetectionFrameMsg* msg) const {
+    msg->frame_number = frame.frame_number();
+    msg->t_capture = to_ros_time(frame.t_capture());
+    msg->t_sent = to_ros_time(frame.t_sent());
+    msg->t_received = received_time;
+    msg->camera_id = frame.camera_id();
 
     const bool defend_plus_x = config_.game_settings().defend_plus_x;
 
     // Only add balls that are in a used half
     const google::protobuf::RepeatedPtrField<SSL_DetectionBall>& balls = frame.balls();
-    msg.balls.reserve(balls.size());
+    msg->balls.reserve(balls.size());
     for (int i = 0; i < balls.size(); ++i) {
         const SSL_DetectionBall& ball = balls.Get(i);
         if (in_used_half(defend_plus_x, ball.x())) {
-            msg.balls.emplace_back(to_ros_msg(ball));
+            msg->balls.emplace_back(to_ros_msg(ball));
         }
     }
 
     // Add blue robots that are in a used half
     const google::protobuf::RepeatedPtrField<SSL_DetectionRobot>& robots_blue = frame.robots_blue();
-    msg.robots_blue.reserve(robots_blue.size());
+    msg->robots_blue.reserve(robots_blue.size());
     for (int i = 0; i < robots_blue.size(); ++i) {
         const SSL_DetectionRobot& robot = robots_blue.Get(i);
         if (in_used_half(defend_plus_x, robot.x())) {
-            msg.robots_blue.emplace_back(to_ros_msg(robot));
+            msg->robots_blue.emplace_back(to_ros_msg(robot));
         }
     }
 
     // Add yellow robots that are in a used half
     const google::protobuf::RepeatedPtrField<SSL_DetectionRobot>& robots_yellow =
         frame.robots_yellow();
-    msg.robots_yellow.reserve(robots_yellow.size());
+    msg->robots_yellow.reserve(robots_yellow.size());
     for (int i = 0; i < robots_yellow.size(); ++i) {
         const SSL_DetectionRobot& robot = robots_yellow.Get(i);
         if (in_used_half(defend_plus_x, robot.x())) {
-            msg.robots_yellow.emplace_back(to_ros_msg(robot));
+            msg->robots_yellow.emplace_back(to_ros_msg(robot));
         }
     }
-
-    return msg;
 }
 
 rclcpp::Time VisionReceiver::to_ros_time(double time_since_epoch_s) {
@@ -212,36 +235,65 @@ void VisionReceiver::sync_detection_timestamp(DetectionFrameMsg* frame,
 }
 
 void VisionReceiver::start_receive() {
-    // Set a receive callback
-    socket_.async_receive_from(
-        boost::asio::buffer(recv_buffer_), sender_endpoint_,
-        [this](const boost::system::error_code& error, std::size_t num_bytes) {
-            // Handle the packet and then restart reception to allow new
-            // incoming data
-            receive_packet(error, num_bytes);
+    // Wait for the socket to have something to read. Note that this only
+    // waits once; the handler calls `start_receive` again to keep listening.
+    socket_.async_wait(udp::socket::wait_read, [this](const boost::system::error_code& error) {
+        receive_packets(error);
+        if (error != boost::asio::error::operation_aborted) {
             start_receive();
-        });
+        }
+    });
 }
 
-void VisionReceiver::receive_packet(const boost::system::error_code& error, std::size_t num_bytes) {
+void VisionReceiver::receive_packets(const boost::system::error_code& error) {
     // Check for error
     if (static_cast<bool>(error)) {
         EZ_ERROR_STREAM("Vision receive failed with error: " << error.message());
         return;
     }
 
-    // Parse the protobuf message and tack on the receive time.
-    StampedSSLWrapperPacket::UniquePtr stamped_packet = std::make_unique<StampedSSLWrapperPacket>();
-    stamped_packet->receive_time = get_clock()->now();
-    if (!stamped_packet->wrapper.ParseFromArray(&recv_buffer_[0], num_bytes)) {
-        EZ_ERROR_STREAM("Got bad packet of " << num_bytes << " bytes from "
-                                             << sender_endpoint_.address() << ":"
-                                             << sender_endpoint_.port());
-        return;
-    }
+    // Keep reading full batches until the socket is drained
+    int num_received = 0;
+    do {
+        for (size_t i = 0; i < kReceiveBatchSize; i++) {
+            if (batch_buffers_[i] == nullptr) {
+                batch_buffers_[i] = take_buffer();
+            }
+
+            batch_iovecs_[i].iov_base = batch_buffers_[i]->data.data();
+            batch_iovecs_[i].iov_len = batch_buffers_[i]->data.size();
 
-    // Put the message into the list
-    packets_.push(std::move(stamped_packet));
+            batch_headers_[i] = mmsghdr{};
+            batch_headers_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+            batch_headers_[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        num_received = recvmmsg(socket_.native_handle(), batch_headers_.data(),
+                                kReceiveBatchSize, MSG_DONTWAIT, nullptr);
+        if (num_received < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                EZ_ERROR_STREAM("Vision receive failed with error: " << std::strerror(errno));
+            }
+            return;
+        }
+
+        // Tack on the receive time and hand the filled buffers off
+        const rclcpp::Time receive_time = get_clock()->now();
+        for (int i = 0; i < num_received; i++) {
+            StampedPacketBuffer::UniquePtr& buffer = batch_buffers_[i];
+            buffer->num_bytes = batch_headers_[i].msg_len;
+            buffer->receive_time = receive_time;
+            packets_.push(std::move(buffer));
+        }
+    } while (num_received == static_cast<int>(kReceiveBatchSize));
+}
+
+StampedPacketBuffer::UniquePtr VisionReceiver::take_buffer() {
+    StampedPacketBuffer::UniquePtr buffer;
+    if (!free_buffers_.try_get(buffer, std::chrono::milliseconds{0})) {
+        buffer = std::make_unique<StampedPacketBuffer>();
+    }
+    return buffer;
 }
 
 bool VisionReceiver::in_used_half(bool defend_plus_x, double x) const {
@@ -338,9 +390,4 @@ void VisionReceiver::update_geometry_packet(const SSL_GeometryFieldSize& field_s
 }
 }  // namespace vision_receiver
 
-int main(int argc, char** argv) {
-    rclcpp::init(argc, argv);
-    rclcpp::spin(std::make_shared<vision_receiver::VisionReceiver>());
-    rclcpp::shutdown();
-    return 0;
-}
+RCLCPP_COMPONENTS_REGISTER_NODE(vision_receiver::VisionReceiver)
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <rj_geometry/point.hpp>
-#include <list>
+#include <vector>
 #include <rj_vision_filter/ball/kalman_ball.hpp>
 
 namespace vision_filter {
@@ -26,7 +26,7 @@ public:
      * @param calc_time Current iteration time
      * @param kalmanBalls List of best kalman ball from every camera
      */
-    WorldBall(RJ::Time calc_time, const std::list<KalmanBall>& kalman_balls);
+    WorldBall(RJ::Time calc_time, const std::vector<KalmanBall>& kalman_balls);
 
     /**
      * @return If the ball actually represents a real ball
@@ -56,7 +56,7 @@ public:
     /**
      * @return List of all the building kalman balls for this world ball
      */
-    const std::list<KalmanBall>& get_ball_components() const;
+    const std::vector<KalmanBall>& get_ball_components() const;
 
     /**
      * @return Time of creation for this world ball
@@ -69,7 +69,7 @@ private:
     rj_geometry::Point vel_;
     double pos_cov_{};
     double vel_cov_{};
-    std::list<KalmanBall> ball_components_;
+    std::vector<KalmanBall> ball_components_;
     RJ::Time time_;
 };
 }  // namespace vision_filter
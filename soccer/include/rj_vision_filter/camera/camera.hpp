@@ -1,11 +1,11 @@
 #pragma once
 
-#include <list>
 #include <rj_vision_filter/ball/ball_bounce.hpp>
 #include <rj_vision_filter/ball/camera_ball.hpp>
 #include <rj_vision_filter/ball/kalman_ball.hpp>
 #include <rj_vision_filter/ball/world_ball.hpp>
 #include <rj_vision_filter/camera/camera_frame.hpp>
+#include <rj_vision_filter/filter/gated_assignment.hpp>
 #include <rj_vision_filter/robot/camera_robot.hpp>
 #include <rj_vision_filter/robot/kalman_robot.hpp>
 #include <rj_vision_filter/robot/world_robot.hpp>
@@ -61,12 +61,33 @@ public:
      */
     void update_with_frame(
         RJ::Time calc_time, const std::vector<CameraBall>& ball_list,
-        const std::vector<std::list<CameraRobot>>& yellow_robot_list,
-        const std::vector<std::list<CameraRobot>>& blue_robot_list,
+        const std::vector<std::vector<CameraRobot>>& yellow_robot_list,
+        const std::vector<std::vector<CameraRobot>>& blue_robot_list,
         const WorldBall& previous_world_ball,
         const std::vector<WorldRobot>& previous_yellow_world_robots,
         const std::vector<WorldRobot>& previous_blue_world_robots);
 
+    /**
+     * Sorts the robots in the frame by id, then updates all the filters with
+     * it like above
+     *
+     * Only touches this camera, so different cameras can be updated in
+     * parallel as long as nothing writes to the previous world objects
+     *
+     * @param calc_time Time of this calculation
+     * @param frame Unsorted detections from this camera
+     * @param previous_world_ball Best idea of current ball pos/vel to init
+     * velocity of new filters
+     * @param previous_yellow_world_robots Best idea of current robots pos/vel to
+     * init velocity of new filters
+     * @param previous_blue_world_robots Best idea of current robots pos/vel to
+     * init velocity of new filters
+     */
+    void update_with_frame(RJ::Time calc_time, const CameraFrame& frame,
+                           const WorldBall& previous_world_ball,
+                           const std::vector<WorldRobot>& previous_yellow_world_robots,
+                           const std::vector<WorldRobot>& previous_blue_world_robots);
+
     /**
      * Updates all the filters without any new data from this specific camera
      *
@@ -79,24 +100,45 @@ public:
     /**
      * @return A list of the kalman balls associated with the camera
      */
-    const std::list<KalmanBall>& get_kalman_balls() const;
+    const std::vector<KalmanBall>& get_kalman_balls() const;
 
     /**
      * @return A vector of yellow kalman robot lists
      */
-    const std::vector<std::list<KalmanRobot>>& get_kalman_robots_yellow() const;
+    const std::vector<std::vector<KalmanRobot>>& get_kalman_robots_yellow() const;
 
     /**
      * @return A vector of blue kalman robot lists
      */
-    const std::vector<std::list<KalmanRobot>>& get_kalman_robots_blue() const;
+    const std::vector<std::vector<KalmanRobot>>& get_kalman_robots_blue() const;
+
+    /**
+     * @return The healthiest kalman ball of this camera, or nullptr if there
+     * are none. Ties go to the oldest filter.
+     */
+    [[nodiscard]] const KalmanBall* get_best_kalman_ball() const;
+
+    /**
+     * @param robot_id ID of the robot to look up
+     * @return The healthiest yellow kalman robot with that id, or nullptr if
+     * there are none
+     */
+    [[nodiscard]] const KalmanRobot* get_best_kalman_robot_yellow(size_t robot_id) const;
+
+    /**
+     * @param robot_id ID of the robot to look up
+     * @return The healthiest blue kalman robot with that id, or nullptr if
+     * there are none
+     */
+    [[nodiscard]] const KalmanRobot* get_best_kalman_robot_blue(size_t robot_id) const;
 
 private:
     /**
      * MHKF refers to the Multi-Hypothesis Kalman Filter
-     *   MHKF averages "near" the current predicted position before using that
-     * as the measurement Any measurements not "near" a filter are used as the
-     * initial values to create a new filter
+     *   MHKF pairs each filter with the closest measurement "near" its
+     * predicted position, solving for the best pairing over all the filters at
+     * once. Any measurements not "near" a filter are used as the initial values
+     * to create a new filter
      *
      * AKF refers to the Average Kalman Filter
      *   AKF averages all measurements and then uses that as the measurement to
@@ -151,8 +193,8 @@ private:
      */
     void update_robots(
         RJ::Time calc_time,
-        const std::vector<std::list<CameraRobot>>& yellow_robot_list,
-        const std::vector<std::list<CameraRobot>>& blue_robot_list,
+        const std::vector<std::vector<CameraRobot>>& yellow_robot_list,
+        const std::vector<std::vector<CameraRobot>>& blue_robot_list,
         const std::vector<WorldRobot>& previous_yellow_world_robots,
         const std::vector<WorldRobot>& previous_blue_world_robots);
 
@@ -166,9 +208,9 @@ private:
      * @param single_kalmanRobotList List of one robot ID's kalman filters
      */
     void update_robots_mhkf(RJ::Time calc_time,
-                          const std::list<CameraRobot>& single_robot_list,
+                          const std::vector<CameraRobot>& single_robot_list,
                           const WorldRobot& previous_world_robot,
-                          std::list<KalmanRobot>& single_kalman_robot_list);
+                          std::vector<KalmanRobot>& single_kalman_robot_list);
 
     /**
      * Updates robot filters using AKF style updater
@@ -180,9 +222,9 @@ private:
      * @param single_kalmanRobotList List of one robot ID's kalman filters
      */
     void update_robots_akf(RJ::Time calc_time,
-                         const std::list<CameraRobot>& single_robot_list,
+                         const std::vector<CameraRobot>& single_robot_list,
                          const WorldRobot& previous_world_robot,
-                         std::list<KalmanRobot>& single_kalman_robot_list);
+                         std::vector<KalmanRobot>& single_kalman_robot_list);
 
     /**
      * Removes any invalid kalman balls that may be too old etc
@@ -200,13 +242,24 @@ private:
      * @param robot_list_list Either kalmanRobotYellowList or kalmanRobotBlueList
      */
     static void predict_all_robots(
-        RJ::Time calc_time, std::vector<std::list<KalmanRobot>>& robot_list_list);
+        RJ::Time calc_time, std::vector<std::vector<KalmanRobot>>& robot_list_list);
 
     bool is_valid_;
 
     int camera_id_{};
-    std::list<KalmanBall> kalman_ball_list_;
-    std::vector<std::list<KalmanRobot>> kalman_robot_yellow_list_;
-    std::vector<std::list<KalmanRobot>> kalman_robot_blue_list_;
+    // Each filter set is a vector reserved up to its max_num_kalman_* cap
+    // when the camera is created, so adding and pruning hypotheses never
+    // reallocates and a frame's worth of filters sits in one block.
+    std::vector<KalmanBall> kalman_ball_list_;
+    std::vector<std::vector<KalmanRobot>> kalman_robot_yellow_list_;
+    std::vector<std::vector<KalmanRobot>> kalman_robot_blue_list_;
+
+    // Measurement to filter association, reused between balls and robots
+    GatedAssignment association_;
+
+    // Detections from the latest frame grouped by robot id, kept to reuse the
+    // memory between frames
+    std::vector<std::vector<CameraRobot>> frame_robots_yellow_;
+    std::vector<std::vector<CameraRobot>> frame_robots_blue_;
 };
 }  // namespace vision_filter
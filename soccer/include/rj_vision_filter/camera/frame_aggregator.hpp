@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include <rj_common/time.hpp>
+#include <rj_vision_filter/camera/camera_frame.hpp>
+
+namespace vision_filter {
+/**
+ * Collects camera frames into batches so the world only has to be rebuilt
+ * once per vision cycle instead of once per camera packet
+ *
+ * A batch is ready once every live camera has reported, or once the window
+ * has passed since the first frame of the batch came in. A camera counts as
+ * live if it has sent a frame within the camera timeout, so a camera that goes
+ * down only delays batches until it times out.
+ *
+ * Only the newest frame from each camera is kept. A frame captured before the
+ * newest one already seen from its camera is stale (a duplicate or out of
+ * order) and is dropped.
+ */
+class FrameAggregator {
+public:
+    /**
+     * @param window Longest time to wait for the rest of the cameras after
+     * the first frame of a batch comes in
+     * @param camera_timeout How long a camera can go without sending a frame
+     * before we stop waiting on it
+     */
+    FrameAggregator(RJ::Seconds window, RJ::Seconds camera_timeout);
+
+    /**
+     * Adds a frame to the current batch, replacing any older frame from the
+     * same camera
+     *
+     * @param frame New frame from vision
+     * @param now Time the frame came in
+     * @return False if the frame was stale and dropped
+     */
+    bool add(CameraFrame frame, RJ::Time now);
+
+    /**
+     * @param now Current time
+     * @return Whether the current batch should be processed now
+     */
+    [[nodiscard]] bool ready(RJ::Time now) const;
+
+    /**
+     * Moves the current batch out and starts a new one
+     *
+     * @param frames Cleared, then filled with at most one frame per camera
+     */
+    void take(std::vector<CameraFrame>* frames);
+
+    /**
+     * @return Number of frames dropped for being stale or replaced by a newer
+     * frame before their batch was processed
+     */
+    [[nodiscard]] size_t num_dropped() const { return num_dropped_; }
+
+private:
+    struct CameraState {
+        bool seen = false;
+        RJ::Time last_arrival;
+        RJ::Time newest_capture;
+
+        // Index into pending_, or -1 if this camera has no frame in the batch
+        int pending_index = -1;
+    };
+
+    RJ::Seconds window_;
+    RJ::Seconds camera_timeout_;
+
+    // Indexed by camera id
+    std::vector<CameraState> cameras_;
+
+    std::vector<CameraFrame> pending_;
+    RJ::Time batch_start_;
+
+    size_t num_dropped_ = 0;
+};
+}  // namespace vision_filter
@@ -1,12 +1,15 @@
-#include <list>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include <rj_utils/worker_pool.hpp>
 #include <rj_vision_filter/ball/world_ball.hpp>
 #include <rj_vision_filter/camera/camera.hpp>
 #include <rj_vision_filter/camera/camera_frame.hpp>
 #include <rj_vision_filter/kick/detector/fast_kick_detector.hpp>
 #include <rj_vision_filter/kick/detector/slow_kick_detector.hpp>
 #include <rj_vision_filter/kick/kick_event.hpp>
+#include <rj_vision_filter/kick/kick_history.hpp>
 #include <rj_vision_filter/robot/world_robot.hpp>
 
 namespace vision_filter {
@@ -81,6 +84,24 @@ private:
      */
     void calc_ball_bounce();
 
+    /**
+     * Updates every camera with its frames in frames_by_camera_, in parallel
+     * if num_camera_threads is more than 1
+     *
+     * @param calc_time Current iteration time
+     * @param update_all Whether to update the cameras without vision measurements
+     */
+    void update_cameras(RJ::Time calc_time, bool update_all);
+
+    /**
+     * Updates a single camera with its frames in frames_by_camera_
+     *
+     * @param camera_id Camera to update
+     * @param calc_time Current iteration time
+     * @param update_all Whether to update the camera if it has no frames
+     */
+    void update_camera(size_t camera_id, RJ::Time calc_time, bool update_all);
+
     /**
      * Fills the world objects with a mix of the best kalman filters from
      * each camera
@@ -108,6 +129,22 @@ private:
     std::vector<WorldRobot> robots_yellow_;
     std::vector<WorldRobot> robots_blue_;
 
+    // Scratch space reused every frame so the hot loop doesn't allocate once
+    // the buffers have grown to their steady-state size
+
+    // New frames for each camera this iteration, in the order they came in
+    std::vector<std::vector<const CameraFrame*>> frames_by_camera_;
+
+    // Healthiest filter from each camera, to be merged into the world objects
+    std::vector<KalmanBall> best_kalman_balls_;
+    std::vector<std::vector<KalmanRobot>> best_kalman_robots_yellow_;
+    std::vector<std::vector<KalmanRobot>> best_kalman_robots_blue_;
+
+    // Only created once num_camera_threads asks for more than one thread
+    std::unique_ptr<rj_utils::WorkerPool> camera_pool_;
+    std::vector<std::function<void()>> camera_tasks_;
+
+    KickHistory kick_history_;
     FastKickDetector fast_kick_;
     SlowKickDetector slow_kick_;
     KickEvent best_kick_estimate_;
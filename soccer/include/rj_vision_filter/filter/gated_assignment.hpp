@@ -0,0 +1,108 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <rj_geometry/point.hpp>
+
+namespace vision_filter {
+/**
+ * Associates measurements to tracks one-to-one, minimizing the total
+ * distance between each track and its measurement
+ *
+ * A measurement can only be associated with a track if it lies strictly
+ * inside that track's gate radius. The gates split the problem into small
+ * independent clusters of tracks and measurements that can reach each other,
+ * and only those are solved with the Hungarian algorithm. With a few objects
+ * near each other and the rest spread across the field, the whole solve stays
+ * close to linear in the number of measurements.
+ *
+ * Used by the camera for both balls and robots. Add every track and
+ * measurement, call solve(), then read back the results. All buffers are
+ * kept between frames, so reuse one instance to avoid allocating.
+ */
+class GatedAssignment {
+public:
+    static constexpr int kUnassigned = -1;
+
+    /**
+     * Removes all tracks, measurements and results
+     */
+    void clear();
+
+    /**
+     * @param pos Predicted position of the track
+     * @param gate_radius Max distance a measurement can be from pos and
+     * still be associated with this track
+     */
+    void add_track(rj_geometry::Point pos, double gate_radius);
+
+    /**
+     * @param pos Position of the measurement
+     */
+    void add_measurement(rj_geometry::Point pos);
+
+    /**
+     * Associates the tracks and measurements added since the last clear()
+     */
+    void solve();
+
+    /**
+     * @param track Index of the track, in the order they were added
+     * @return Index of the measurement associated with the track, or
+     * kUnassigned
+     */
+    [[nodiscard]] int get_measurement_for_track(size_t track) const;
+
+    /**
+     * @param measurement Index of the measurement, in the order they were added
+     * @return Whether the measurement is inside the gate of any track, even if
+     * another measurement was associated with that track
+     */
+    [[nodiscard]] bool is_gated(size_t measurement) const;
+
+private:
+    /**
+     * Union-find over tracks followed by measurements
+     */
+    int find_cluster(int node);
+
+    /**
+     * Solves a single cluster and fills in track_assignments_
+     *
+     * @param begin Index of the first gated pair of the cluster
+     * @param end One past the last gated pair of the cluster
+     */
+    void solve_cluster(size_t begin, size_t end);
+
+    /**
+     * Minimum cost assignment of every row of cost_ to a unique column
+     * Fills column_rows_ with the row given to each column (1-indexed, 0 for
+     * none). Needs rows <= cols
+     */
+    void hungarian(int rows, int cols);
+
+    std::vector<rj_geometry::Point> track_pos_;
+    std::vector<double> track_gate_;
+    std::vector<rj_geometry::Point> measurement_pos_;
+
+    // Results
+    std::vector<int> track_assignments_;
+    std::vector<bool> measurement_gated_;
+
+    // Scratch space
+    std::vector<int> measurements_by_x_;
+    std::vector<std::pair<int, int>> gated_pairs_;
+    std::vector<int> cluster_parent_;
+    std::vector<int> local_index_;
+    std::vector<int> cluster_tracks_;
+    std::vector<int> cluster_measurements_;
+    std::vector<double> cost_;
+    std::vector<double> row_potential_;
+    std::vector<double> column_potential_;
+    std::vector<double> min_slack_;
+    std::vector<int> column_rows_;
+    std::vector<int> column_way_;
+    std::vector<bool> column_used_;
+};
+}  // namespace vision_filter
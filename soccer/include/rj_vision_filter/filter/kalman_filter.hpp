@@ -4,9 +4,15 @@
 
 namespace vision_filter {
 /**
- * Abstract class that should be inherited from to create specific
+ * Base class that should be inherited from to create specific
  * kalman filters
  *
+ * The state and observation sizes are template parameters so that every
+ * matrix is a fixed-size Eigen type: they live inline in the filter (no heap
+ * allocation) and Eigen can unroll and vectorize the predict/update math.
+ * Only the sizes used by the vision filter are instantiated, in
+ * kalman_filter.cpp.
+ *
  * Must initialize:
  *  x_k1_k1, x_k_k1, x_k_k,
  *  P_k1_k1, P_k_k1, P_k_k,
@@ -28,36 +34,46 @@ namespace vision_filter {
  * x_k1_k1 is X_(k-1, k-1)
  * x_k_k is X_(k, k)
  * etc
+ *
+ * @tparam StateSize The size of the state vector
+ * @tparam ObservationSize The size of the observation vector
  */
+template <int StateSize, int ObservationSize>
 class KalmanFilter {
 public:
+    using StateVector = Eigen::Matrix<double, StateSize, 1>;
+    using ObservationVector = Eigen::Matrix<double, ObservationSize, 1>;
+    using InputVector = Eigen::Matrix<double, 1, 1>;
+
+    using StateMatrix = Eigen::Matrix<double, StateSize, StateSize>;
+    using ObservationMatrix = Eigen::Matrix<double, ObservationSize, ObservationSize>;
+    using GainMatrix = Eigen::Matrix<double, StateSize, ObservationSize>;
+    using InputMatrix = Eigen::Matrix<double, StateSize, 1>;
+    using MeasurementMatrix = Eigen::Matrix<double, ObservationSize, StateSize>;
+
     /**
-     * Creates a general kalman filter with the given sizes
+     * Creates a general kalman filter with every matrix zeroed
      * Use a child class to setup the specific state matricies
      * Assumes 1 input
-     *
-     * @param state_size The size of the state vector
-     * @param observation_size The size of the observation vector
      */
-    KalmanFilter(unsigned int state_size, unsigned int observation_size)
-        : x_k1_k1_(state_size),
-          x_k_k1_(state_size),
-          x_k_k_(state_size),
-          u_k_(1),
-          z_k_(observation_size),
-          y_k_k1_(observation_size),
-          y_k_k_(observation_size),
-          P_k1_k1_(state_size, state_size),
-          P_k_k1_(state_size, state_size),
-          P_k_k_(state_size, state_size),
-          S_k_(observation_size, observation_size),
-          K_k_(state_size, observation_size),
-          F_k_(state_size, state_size),
-          B_k_(state_size, 1),
-          H_k_(observation_size, state_size),
-          Q_k_(state_size, state_size),
-          R_k_(observation_size, observation_size),
-          identity_(Eigen::MatrixXd::Identity(state_size, state_size)) {}
+    KalmanFilter()
+        : x_k1_k1_(StateVector::Zero()),
+          x_k_k1_(StateVector::Zero()),
+          x_k_k_(StateVector::Zero()),
+          u_k_(InputVector::Zero()),
+          z_k_(ObservationVector::Zero()),
+          y_k_k1_(ObservationVector::Zero()),
+          y_k_k_(ObservationVector::Zero()),
+          P_k1_k1_(StateMatrix::Zero()),
+          P_k_k1_(StateMatrix::Zero()),
+          P_k_k_(StateMatrix::Zero()),
+          S_k_(ObservationMatrix::Zero()),
+          K_k_(GainMatrix::Zero()),
+          F_k_(StateMatrix::Zero()),
+          B_k_(InputMatrix::Zero()),
+          H_k_(MeasurementMatrix::Zero()),
+          Q_k_(StateMatrix::Zero()),
+          R_k_(ObservationMatrix::Zero()) {}
 
     /**
      * Predicts without update
@@ -71,40 +87,42 @@ public:
     void predict_with_update();
 
 protected:
-    Eigen::VectorXd x_k1_k1_;
-    Eigen::VectorXd x_k_k1_;
-    Eigen::VectorXd x_k_k_;
+    StateVector x_k1_k1_;
+    StateVector x_k_k1_;
+    StateVector x_k_k_;
 
-    Eigen::VectorXd u_k_;
-    Eigen::VectorXd z_k_;
+    InputVector u_k_;
+    ObservationVector z_k_;
 
-    Eigen::VectorXd y_k_k1_;
-    Eigen::VectorXd y_k_k_;
+    ObservationVector y_k_k1_;
+    ObservationVector y_k_k_;
 
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd P_k1_k1_;
+    StateMatrix P_k1_k1_;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd P_k_k1_;
+    StateMatrix P_k_k1_;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd P_k_k_;
+    StateMatrix P_k_k_;
 
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd S_k_;
+    ObservationMatrix S_k_;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd K_k_;
+    GainMatrix K_k_;
 
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd F_k_;
+    StateMatrix F_k_;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd B_k_;
+    InputMatrix B_k_;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd H_k_;
+    MeasurementMatrix H_k_;
 
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd Q_k_;
+    StateMatrix Q_k_;
     // NOLINTNEXTLINE(readability-identifier-naming)
-    Eigen::MatrixXd R_k_;
-
-    Eigen::MatrixXd identity_;
+    ObservationMatrix R_k_;
 };
-}  // namespace vision_filter
\ No newline at end of file
+
+// Instantiated in kalman_filter.cpp
+extern template class KalmanFilter<4, 2>;
+extern template class KalmanFilter<6, 3>;
+}  // namespace vision_filter
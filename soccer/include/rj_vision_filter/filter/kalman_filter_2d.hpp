@@ -4,7 +4,7 @@
 #include <rj_vision_filter/filter/kalman_filter.hpp>
 
 namespace vision_filter {
-class KalmanFilter2D : public KalmanFilter {
+class KalmanFilter2D : public KalmanFilter<4, 2> {
 public:
     /**
      * Creates a kalman filter with all the parameters set to 0 (F_k etc)
@@ -1,10 +1,9 @@
 #pragma once
 
-#include <deque>
 #include <rj_common/utils.hpp>
 #include <rj_vision_filter/ball/world_ball.hpp>
 #include <rj_vision_filter/kick/kick_event.hpp>
-#include <rj_vision_filter/kick/vision_state.hpp>
+#include <rj_vision_filter/kick/kick_history.hpp>
 #include <rj_vision_filter/robot/world_robot.hpp>
 
 namespace vision_filter {
@@ -20,12 +19,9 @@ namespace vision_filter {
 class FastKickDetector {
 public:
     /**
-     * Adds a record to our history list
+     * Checks the latest records in the history for a kick
      *
-     * @param calc_time Time of calculation for this vision loop
-     * @param ball Best estimation of the current ball
-     * @param yellow_robots Best estimation of the yellow robots
-     * @param blue_robots Best estimation of the blue robots
+     * @param history Latest estimations of the ball and robots
      * @param kick_event Returned kick event if we find one
      *
      * @return Whether there was a kick
@@ -33,22 +29,27 @@ public:
      * @note kick_event is only filled if it returns true
      * It is not touched otherwise
      */
-    bool add_record(RJ::Time calc_time, const WorldBall& ball,
-                   const std::vector<WorldRobot>& yellow_robots,
-                   const std::vector<WorldRobot>& blue_robots,
-                   KickEvent& kick_event);
+    bool detect(const KickHistory& history, KickEvent* kick_event) const;
 
 private:
     /**
+     * @param ball_pos Ball positions over the history, oldest first
+     * @param count Number of positions
+     *
      * @return Whether there is a large enough acceleration to be a kick
      */
-    bool detect_kick();
+    static bool detect_kick(const rj_geometry::Point* ball_pos, size_t count);
 
     /**
-     * @return Closest robot to the ball at it's kick time
+     * @param history Latest estimations of the ball and robots
+     * @param count Number of latest records to look at
+     * @param kick_idx Index in those records of the kick
+     * @param team Returned team of the closest robot
+     *
+     * @return ID of the closest robot to the ball at it's kick time, or -1
+     * if there are no robots
      */
-    WorldRobot get_closest_robot();
-
-    std::deque<VisionState> state_history_;
+    static int get_closest_robot(const KickHistory& history, size_t count, size_t kick_idx,
+                                 WorldRobot::Team* team);
 };
 }  // namespace vision_filter
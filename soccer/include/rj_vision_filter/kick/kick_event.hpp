@@ -1,8 +1,9 @@
 #pragma once
 
-#include <deque>
+#include <rj_geometry/point.hpp>
+#include <rj_geometry/pose.hpp>
 #include <rj_vision_filter/ball/world_ball.hpp>
-#include <rj_vision_filter/kick/vision_state.hpp>
+#include <rj_vision_filter/kick/kick_history.hpp>
 #include <rj_vision_filter/robot/world_robot.hpp>
 #include <utility>
 #include <vector>
@@ -14,6 +15,15 @@ namespace vision_filter {
  */
 class KickEvent {
 public:
+    /**
+     * Ball estimate at a single frame
+     */
+    struct BallSample {
+        RJ::Time time;
+        rj_geometry::Point pos;
+        rj_geometry::Point vel;
+    };
+
     /**
      * Creates invalid kick event
      * Makes things a little easier instead of check for null etc
@@ -21,32 +31,27 @@ public:
     KickEvent() : is_valid_(false){};
 
     /**
-     * Creates a valid kick event
+     * Creates a valid kick event from the kick detector history
      *
-     * @param kick_time Time of kick
-     * @param kicking_robot World robot who is the one kicking
-     * @param states_since_kick All the vision states that we have since the kick
+     * @param history History the kick was detected in
+     * @param count Number of latest samples the kick was detected over
+     * @param kick_idx Index in those samples the kick happened at
+     * @param kicking_team Team of the robot who kicked
+     * @param kicking_robot_id ID of the robot who kicked, or -1 if there
+     * wasn't a robot to blame
      */
-    KickEvent(RJ::Time kick_time, WorldRobot kicking_robot,
-              std::deque<VisionState> states_since_kick)
-        : is_valid_(true),
-          kick_time_(kick_time),
-          kicking_robot_(std::move(kicking_robot)),
-          states_since_kick_(std::move(states_since_kick)) {}
+    KickEvent(const KickHistory& history, size_t count, size_t kick_idx,
+              WorldRobot::Team kicking_team, int kicking_robot_id);
 
     /**
-     * Adds a state to the history
+     * Adds a ball estimate to the history
      * Use when the kick event is already created and we are trying
      * to estimate the kick trajectory
      *
      * @param calc_time Time of current frame
      * @param ball Ball at current frame
-     * @param yellow_robots Yellow robots at current frame
-     * @param blue_robots Blue robots at current frame
      */
-    void add_state(RJ::Time calc_time, const WorldBall& ball,
-                  const std::vector<WorldRobot>& yellow_robots,
-                  const std::vector<WorldRobot>& blue_robots);
+    void add_state(RJ::Time calc_time, const WorldBall& ball);
 
     /**
      * @return true if the kick is a valid one
@@ -59,14 +64,24 @@ public:
     RJ::Time get_kick_time() const;
 
     /**
-     * @return robot we think kicked
+     * @return team of the robot we think kicked
+     */
+    WorldRobot::Team get_kicking_team() const;
+
+    /**
+     * @return id of the robot we think kicked, or -1 if we don't know
+     */
+    int get_kicking_robot_id() const;
+
+    /**
+     * @return pose of the robot we think kicked, at the kick time
      */
-    WorldRobot get_kicking_robot() const;
+    rj_geometry::Pose get_kicking_robot_pose() const;
 
     /**
-     * @return vision states since that time we kicked
+     * @return ball estimates since the time we kicked
      */
-    const std::deque<VisionState>& get_states_since_kick() const;
+    const std::vector<BallSample>& get_ball_since_kick() const;
 
 private:
     // If it's a valid kick event object
@@ -74,8 +89,10 @@ private:
     // When it was kicked
     RJ::Time kick_time_;
     // Who kicked it
-    WorldRobot kicking_robot_;
-    // All the states since a kick
-    std::deque<VisionState> states_since_kick_;
+    WorldRobot::Team kicking_team_{};
+    int kicking_robot_id_{};
+    rj_geometry::Pose kicking_robot_pose_;
+    // The ball since the kick
+    std::vector<BallSample> ball_since_kick_;
 };
 }  // namespace vision_filter
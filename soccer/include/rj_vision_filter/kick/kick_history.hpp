@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <rj_common/time.hpp>
+#include <rj_geometry/point.hpp>
+#include <rj_vision_filter/ball/world_ball.hpp>
+#include <rj_vision_filter/robot/world_robot.hpp>
+
+namespace vision_filter {
+/**
+ * The last few frames of ball and robot estimates that the kick detectors
+ * look back over
+ *
+ * Stored as a fixed-capacity ring of flat arrays, one per field, instead of
+ * copying the world objects every frame. Every sample is written twice, at
+ * its slot and at its slot plus the capacity, so the latest N samples are
+ * always one contiguous slice of each array and can be read in place.
+ */
+class KickHistory {
+public:
+    /**
+     * Oldest-first view of the ball over the latest samples
+     */
+    struct BallTrack {
+        const RJ::Time* time;
+        const uint8_t* valid;
+        const rj_geometry::Point* pos;
+        const rj_geometry::Point* vel;
+    };
+
+    /**
+     * Oldest-first view of a single robot over the latest samples
+     */
+    struct RobotTrack {
+        const uint8_t* valid;
+        const rj_geometry::Point* pos;
+        const double* theta;
+        const rj_geometry::Point* vel;
+    };
+
+    /**
+     * Creates a history that can't hold anything
+     */
+    KickHistory() = default;
+
+    /**
+     * @param capacity Number of frames to keep
+     */
+    explicit KickHistory(size_t capacity);
+
+    /**
+     * Adds the latest frame, dropping the oldest one if full
+     *
+     * @param calc_time Time of calculation for this vision loop
+     * @param ball Best estimation of the current ball
+     * @param yellow_robots Best estimation of the yellow robots
+     * @param blue_robots Best estimation of the blue robots
+     */
+    void add(RJ::Time calc_time, const WorldBall& ball,
+             const std::vector<WorldRobot>& yellow_robots,
+             const std::vector<WorldRobot>& blue_robots);
+
+    /**
+     * @return Number of frames held
+     */
+    [[nodiscard]] size_t size() const { return size_; }
+
+    /**
+     * @return Max number of frames held
+     */
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    /**
+     * @param count Number of latest samples to view, at most size()
+     * @return The ball over the latest count samples
+     */
+    [[nodiscard]] BallTrack ball_track(size_t count) const;
+
+    /**
+     * @param team Team of the robot
+     * @param robot_id ID of the robot
+     * @param count Number of latest samples to view, at most size()
+     * @return The robot over the latest count samples
+     */
+    [[nodiscard]] RobotTrack robot_track(WorldRobot::Team team, size_t robot_id,
+                                         size_t count) const;
+
+private:
+    /**
+     * @return Index of the oldest of the latest count samples
+     */
+    [[nodiscard]] size_t start(size_t count) const;
+
+    /**
+     * @return Offset of a robot's track in the robot arrays
+     */
+    [[nodiscard]] size_t robot_offset(WorldRobot::Team team, size_t robot_id) const;
+
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    // Slot the next sample goes into
+    size_t head_ = 0;
+
+    // Each array is 2 * capacity_ long, or 2 * capacity_ per robot for the
+    // robot arrays
+    std::vector<RJ::Time> time_;
+    std::vector<uint8_t> ball_valid_;
+    std::vector<rj_geometry::Point> ball_pos_;
+    std::vector<rj_geometry::Point> ball_vel_;
+
+    std::vector<uint8_t> robot_valid_;
+    std::vector<rj_geometry::Point> robot_pos_;
+    std::vector<double> robot_theta_;
+    std::vector<rj_geometry::Point> robot_vel_;
+};
+}  // namespace vision_filter
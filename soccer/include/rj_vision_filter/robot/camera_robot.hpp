@@ -67,7 +67,7 @@ public:
      *
      * Note: All robots must have the same robot_id
      */
-    static CameraRobot combine_robots(const std::list<CameraRobot>& robots);
+    static CameraRobot combine_robots(const std::vector<CameraRobot>& robots);
 
 private:
     RJ::Time time_captured_;
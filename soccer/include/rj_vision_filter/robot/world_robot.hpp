@@ -2,7 +2,7 @@
 
 #include <rj_geometry/point.hpp>
 #include <rj_geometry/pose.hpp>
-#include <list>
+#include <vector>
 #include <rj_vision_filter/robot/kalman_robot.hpp>
 
 namespace vision_filter {
@@ -29,7 +29,7 @@ public:
      * merger
      */
     WorldRobot(RJ::Time calc_time, Team team, int robot_id,
-               const std::list<KalmanRobot>& kalman_robots);
+               const std::vector<KalmanRobot>& kalman_robots);
 
     /**
      * @return If the robot actually represents a real robot
@@ -89,7 +89,7 @@ public:
     /**
      * @return List of all the building kalman robots for this world robot
      */
-    const std::list<KalmanRobot>& get_robot_components() const;
+    const std::vector<KalmanRobot>& get_robot_components() const;
 
     /**
      * @return Time of creation for the robot estimate
@@ -103,7 +103,7 @@ private:
     rj_geometry::Twist twist_;
     double pos_cov_{};
     double vel_cov_{};
-    std::list<KalmanRobot> robot_components_;
+    std::vector<KalmanRobot> robot_components_;
     RJ::Time time_;
 
     bool is_valid_;
@@ -9,6 +9,7 @@
 
 #include <config_client/config_client.hpp>
 #include <rj_msgs/msg/detection_frame.hpp>
+#include <rj_msgs/msg/frame_trace.hpp>
 #include <rj_msgs/msg/team_color.hpp>
 #include <rj_msgs/msg/world_state.hpp>
 #include <rj_param_utils/ros2_local_param_provider.hpp>
@@ -16,6 +17,7 @@
 #include <rj_utils/concurrent_queue.hpp>
 
 #include "rj_vision_filter/camera/camera_frame.hpp"
+#include "rj_vision_filter/camera/frame_aggregator.hpp"
 #include "rj_vision_filter/camera/world.hpp"
 
 namespace vision_filter {
@@ -65,6 +67,13 @@ private:
      */
     void publish_state();
 
+    /**
+     * @brief Updates the world with the batch of camera frames collected so
+     * far, if it's ready.
+     * @param now The current time.
+     */
+    void process_frames(RJ::Time now);
+
     // TODO(1562): (It's horrible, but it's only temporary until VisionFilter
     // gets refactored).
     /**
@@ -115,5 +124,30 @@ private:
     rclcpp::Publisher<WorldStateMsg>::SharedPtr world_state_pub_;
 
     ::params::LocalROS2ParamProvider param_provider_;
+
+    /**
+     * @brief Batches up camera frames so the world is rebuilt once per vision
+     * cycle. Declared after param_provider_ so it's built with the loaded
+     * parameters.
+     */
+    FrameAggregator frame_aggregator_;
+
+    /**
+     * @brief The batch being processed, kept to reuse its memory.
+     */
+    std::vector<CameraFrame> frame_batch_;
+
+    /**
+     * @brief Latency traces of the newest frame received and of the newest
+     * frame folded into the world.
+     */
+    rj_msgs::msg::FrameTrace pending_trace_;
+    rj_msgs::msg::FrameTrace trace_;
+
+    /**
+     * @brief Last frame whose filter latency was recorded, so each frame is
+     * only counted the first time it's published.
+     */
+    uint64_t last_traced_frame_id_ = 0;
 };
 }  // namespace vision_filter
\ No newline at end of file
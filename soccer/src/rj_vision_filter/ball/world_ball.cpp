@@ -12,7 +12,7 @@ using world_ball::PARAM_ball_merger_power;
 
 WorldBall::WorldBall() : is_valid_(false) {}
 
-WorldBall::WorldBall(RJ::Time calc_time, const std::list<KalmanBall>& kalman_balls)
+WorldBall::WorldBall(RJ::Time calc_time, const std::vector<KalmanBall>& kalman_balls)
     : is_valid_(true), time_(calc_time) {
     rj_geometry::Point pos_avg = rj_geometry::Point(0, 0);
     rj_geometry::Point vel_avg = rj_geometry::Point(0, 0);
@@ -87,7 +87,7 @@ double WorldBall::get_pos_cov() const { return pos_cov_; }
 
 double WorldBall::get_vel_cov() const { return vel_cov_; }
 
-const std::list<KalmanBall>& WorldBall::get_ball_components() const { return ball_components_; }
+const std::vector<KalmanBall>& WorldBall::get_ball_components() const { return ball_components_; }
 
 RJ::Time WorldBall::get_time() const { return time_; }
 }  // namespace vision_filter
\ No newline at end of file
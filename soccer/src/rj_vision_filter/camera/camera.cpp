@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <rj_geometry/point.hpp>
 #include <rj_constants/constants.hpp>
 #include <rj_vision_filter/camera/camera.hpp>
@@ -14,13 +16,49 @@ DEFINE_NS_INT64(kVisionFilterParamModule, camera, max_num_kalman_robots, 10,
                 "Max number of Kalman robots for each robot id for this specific camera.")
 using namespace camera;
 
+namespace {
+/**
+ * @return The filter with the highest health, or nullptr if there are none.
+ * std::max_element keeps the first of equal elements, so ties go to the
+ * oldest filter.
+ */
+template <typename KalmanObject>
+const KalmanObject* healthiest(const std::vector<KalmanObject>& filters) {
+    auto best = std::max_element(filters.begin(), filters.end(),
+                                 [](const KalmanObject& a, const KalmanObject& b) {
+                                     return a.get_health() < b.get_health();
+                                 });
+
+    return best == filters.end() ? nullptr : &*best;
+}
+
+template <typename KalmanObject>
+void remove_unhealthy(std::vector<KalmanObject>& filters) {
+    filters.erase(std::remove_if(filters.begin(), filters.end(),
+                                 [](const KalmanObject& f) { return f.is_unhealthy(); }),
+                  filters.end());
+}
+}  // namespace
+
 Camera::Camera() : is_valid_(false) {}
 
 Camera::Camera(int camera_id)
     : is_valid_(true),
       camera_id_(camera_id),
       kalman_robot_yellow_list_(kNumShells),
-      kalman_robot_blue_list_(kNumShells) {}
+      kalman_robot_blue_list_(kNumShells),
+      frame_robots_yellow_(kNumShells),
+      frame_robots_blue_(kNumShells) {
+    kalman_ball_list_.reserve(PARAM_max_num_kalman_balls);
+
+    for (std::vector<KalmanRobot>& robot_list : kalman_robot_yellow_list_) {
+        robot_list.reserve(PARAM_max_num_kalman_robots);
+    }
+
+    for (std::vector<KalmanRobot>& robot_list : kalman_robot_blue_list_) {
+        robot_list.reserve(PARAM_max_num_kalman_robots);
+    }
+}
 
 bool Camera::get_is_valid() const { return is_valid_; }
 
@@ -37,8 +75,8 @@ void Camera::process_ball_bounce(const std::vector<WorldRobot>& yellow_robots,
 }
 
 void Camera::update_with_frame(RJ::Time calc_time, const std::vector<CameraBall>& ball_list,
-                               const std::vector<std::list<CameraRobot>>& yellow_robot_list,
-                               const std::vector<std::list<CameraRobot>>& blue_robot_list,
+                               const std::vector<std::vector<CameraRobot>>& yellow_robot_list,
+                               const std::vector<std::vector<CameraRobot>>& blue_robot_list,
                                const WorldBall& previous_world_ball,
                                const std::vector<WorldRobot>& previous_yellow_world_robots,
                                const std::vector<WorldRobot>& previous_blue_world_robots) {
@@ -51,6 +89,29 @@ void Camera::update_with_frame(RJ::Time calc_time, const std::vector<CameraBall>
                   previous_blue_world_robots);
 }
 
+void Camera::update_with_frame(RJ::Time calc_time, const CameraFrame& frame,
+                               const WorldBall& previous_world_ball,
+                               const std::vector<WorldRobot>& previous_yellow_world_robots,
+                               const std::vector<WorldRobot>& previous_blue_world_robots) {
+    // Take the non-sorted list from the frame and make a list for each id
+    for (size_t i = 0; i < kNumShells; i++) {
+        frame_robots_yellow_.at(i).clear();
+        frame_robots_blue_.at(i).clear();
+    }
+
+    for (const CameraRobot& robot : frame.camera_robots_yellow) {
+        frame_robots_yellow_.at(robot.get_robot_id()).push_back(robot);
+    }
+
+    for (const CameraRobot& robot : frame.camera_robots_blue) {
+        frame_robots_blue_.at(robot.get_robot_id()).push_back(robot);
+    }
+
+    update_with_frame(calc_time, frame.camera_balls, frame_robots_yellow_, frame_robots_blue_,
+                      previous_world_ball, previous_yellow_world_robots,
+                      previous_blue_world_robots);
+}
+
 void Camera::update_without_frame(RJ::Time calc_time) {
     remove_invalid_balls();
     remove_invalid_robots();
@@ -59,13 +120,13 @@ void Camera::update_without_frame(RJ::Time calc_time) {
         b.predict(calc_time);
     }
 
-    for (std::list<KalmanRobot>& robot_list : kalman_robot_yellow_list_) {
+    for (std::vector<KalmanRobot>& robot_list : kalman_robot_yellow_list_) {
         for (KalmanRobot& robot : robot_list) {
             robot.predict(calc_time);
         }
     }
 
-    for (std::list<KalmanRobot>& robot_list : kalman_robot_blue_list_) {
+    for (std::vector<KalmanRobot>& robot_list : kalman_robot_blue_list_) {
         for (KalmanRobot& robot : robot_list) {
             robot.predict(calc_time);
         }
@@ -107,44 +168,31 @@ void Camera::update_balls_mhkf(RJ::Time calc_time, const std::vector<CameraBall>
 
     // TODO: Try merging some of the kalman filters together
 
-    // Create list of bools corresponding to whether we have used this ball
-    // as measurement yet
-    std::vector<bool> used_camera_ball(ball_list.size(), false);
-
-    // Which camera balls to apply to which kalman ball
-    std::vector<std::vector<CameraBall>> applied_balls_list(kalman_ball_list_.size());
-
-    // Figure out which measurements go with which kalman balls
-    int kalman_ball_idx = 0;
-    for (KalmanBall& kalman_ball : kalman_ball_list_) {
-        std::vector<CameraBall>& measurement_balls = applied_balls_list.at(kalman_ball_idx);
-
-        int camera_ball_idx = 0;
-        for (const CameraBall& camera_ball : ball_list) {
-            double dist = (kalman_ball.get_pos() - camera_ball.get_pos()).mag();
-
-            // Increase the distance of our cutoff by the velocity
-            // This is so the ball doesn't move outside the kalman filter
-            // position radius when the ball instantly stops (like in sim)
-            if (dist < PARAM_mhkf_radius_cutoff + kalman_ball.get_vel().mag()) {
-                measurement_balls.push_back(camera_ball);
-                used_camera_ball.at(camera_ball_idx) = true;
-            }
-            camera_ball_idx++;
-        }
+    // Pair each kalman ball with at most one measurement
+    //
+    // Increase the distance of our cutoff by the velocity
+    // This is so the ball doesn't move outside the kalman filter
+    // position radius when the ball instantly stops (like in sim)
+    association_.clear();
+    for (const KalmanBall& kalman_ball : kalman_ball_list_) {
+        association_.add_track(kalman_ball.get_pos(),
+                               PARAM_mhkf_radius_cutoff + kalman_ball.get_vel().mag());
+    }
 
-        kalman_ball_idx++;
+    for (const CameraBall& camera_ball : ball_list) {
+        association_.add_measurement(camera_ball.get_pos());
     }
 
+    association_.solve();
+
     // Apply the ball measurements to the kalman filters
-    kalman_ball_idx = 0;
-    for (KalmanBall& kalman_ball : kalman_ball_list_) {
-        std::vector<CameraBall>& measurement_balls = applied_balls_list.at(kalman_ball_idx);
+    for (size_t i = 0; i < kalman_ball_list_.size(); i++) {
+        KalmanBall& kalman_ball = kalman_ball_list_.at(i);
+        int camera_ball_idx = association_.get_measurement_for_track(i);
 
-        // We had at least one measurement near this ball
-        if (!measurement_balls.empty()) {
-            CameraBall avg_ball = CameraBall::combine_balls(measurement_balls);
-            kalman_ball.predict_and_update(calc_time, avg_ball);
+        // We had a measurement near this ball
+        if (camera_ball_idx != GatedAssignment::kUnassigned) {
+            kalman_ball.predict_and_update(calc_time, ball_list.at(camera_ball_idx));
 
             // There aren't any measurements so just predict
         } else {
@@ -152,7 +200,10 @@ void Camera::update_balls_mhkf(RJ::Time calc_time, const std::vector<CameraBall>
         }
     }
 
-    // Any balls not used, create a kalman ball at that position
+    // Any balls not near a kalman ball, create a kalman ball at that position
+    //
+    // Measurements near a kalman ball that lost out to a better one are
+    // dropped instead, since they are most likely a double detection
     //
     // If there are two measurements which too far away from any
     // current kalman filter, the two measurements will be form
@@ -161,7 +212,7 @@ void Camera::update_balls_mhkf(RJ::Time calc_time, const std::vector<CameraBall>
     // A slight delay in will most likely be seen in these cases
     for (size_t i = 0; i < ball_list.size(); i++) {
         const CameraBall& camera_ball = ball_list.at(i);
-        bool was_used = used_camera_ball.at(i);
+        bool was_used = association_.is_gated(i);
 
         if (!was_used && kalman_ball_list_.size() < PARAM_max_num_kalman_balls) {
             kalman_ball_list_.emplace_back(camera_id_, calc_time, camera_ball, previous_world_ball);
@@ -187,13 +238,13 @@ void Camera::update_balls_akf(RJ::Time calc_time, const std::vector<CameraBall>&
 }
 
 void Camera::update_robots(RJ::Time calc_time,
-                           const std::vector<std::list<CameraRobot>>& yellow_robot_list,
-                           const std::vector<std::list<CameraRobot>>& blue_robot_list,
+                           const std::vector<std::vector<CameraRobot>>& yellow_robot_list,
+                           const std::vector<std::vector<CameraRobot>>& blue_robot_list,
                            const std::vector<WorldRobot>& previous_yellow_world_robots,
                            const std::vector<WorldRobot>& previous_blue_world_robots) {
     for (size_t i = 0; i < kNumShells; i++) {
-        const std::list<CameraRobot>& single_yellow_robot_list = yellow_robot_list.at(i);
-        const std::list<CameraRobot>& single_blue_robot_list = blue_robot_list.at(i);
+        const std::vector<CameraRobot>& single_yellow_robot_list = yellow_robot_list.at(i);
+        const std::vector<CameraRobot>& single_blue_robot_list = blue_robot_list.at(i);
 
         // Make sure we actually have robots for the yellow team
         if (single_yellow_robot_list.empty()) {
@@ -233,9 +284,10 @@ void Camera::update_robots(RJ::Time calc_time,
     }
 }
 
-void Camera::update_robots_mhkf(RJ::Time calc_time, const std::list<CameraRobot>& single_robot_list,
+void Camera::update_robots_mhkf(RJ::Time calc_time,
+                                const std::vector<CameraRobot>& single_robot_list,
                                 const WorldRobot& previous_world_robot,
-                                std::list<KalmanRobot>& single_kalman_robot_list) {
+                                std::vector<KalmanRobot>& single_kalman_robot_list) {
     // If we have no existing filters, create a new one from average of
     // everything Easier than trying to figure out which ones are more than X
     // meters away from each other Only delays the filter collection by a camera
@@ -250,46 +302,31 @@ void Camera::update_robots_mhkf(RJ::Time calc_time, const std::list<CameraRobot>
 
     // TODO: Merge some of the kalman filters together
 
-    // Create list of bools corresponding to whether we have used this Robot
-    // as measurement yet
-    std::vector<bool> used_camera_robot(single_robot_list.size(), false);
-
-    // Which camera robots to apply to which kalman Robot
-    std::vector<std::list<CameraRobot>> applied_robots_list(single_kalman_robot_list.size());
-
-    // Apply camera robots to different kalman filters based off a fixed
-    // distance A single camera robots can go to multiple different kalman
-    // robots
-    int kalman_robot_idx = 0;
-    for (KalmanRobot& kalman_robot : single_kalman_robot_list) {
-        std::list<CameraRobot>& measurement_robot = applied_robots_list.at(kalman_robot_idx);
-
-        int camera_robot_idx = 0;
-        for (const CameraRobot& camera_robot : single_robot_list) {
-            double dist = (kalman_robot.get_pos() - camera_robot.get_pos()).mag();
-
-            // Increase the distance of our cutoff by the velocity
-            // This is so the robot doesn't move outside the kalman filter
-            // position radius when the robot instantly stops (like in sim)
-            if (dist < PARAM_mhkf_radius_cutoff + kalman_robot.get_vel().mag()) {
-                measurement_robot.push_back(camera_robot);
-                used_camera_robot.at(camera_robot_idx) = true;
-            }
-            camera_robot_idx++;
-        }
+    // Pair each kalman robot with at most one measurement
+    //
+    // Increase the distance of our cutoff by the velocity
+    // This is so the robot doesn't move outside the kalman filter
+    // position radius when the robot instantly stops (like in sim)
+    association_.clear();
+    for (const KalmanRobot& kalman_robot : single_kalman_robot_list) {
+        association_.add_track(kalman_robot.get_pos(),
+                               PARAM_mhkf_radius_cutoff + kalman_robot.get_vel().mag());
+    }
 
-        kalman_robot_idx++;
+    for (const CameraRobot& camera_robot : single_robot_list) {
+        association_.add_measurement(camera_robot.get_pos());
     }
 
+    association_.solve();
+
     // Predict and update the filters based on measurements
-    kalman_robot_idx = 0;
-    for (KalmanRobot& kalman_robot : single_kalman_robot_list) {
-        std::list<CameraRobot>& measurement_robots = applied_robots_list.at(kalman_robot_idx);
+    for (size_t i = 0; i < single_kalman_robot_list.size(); i++) {
+        KalmanRobot& kalman_robot = single_kalman_robot_list.at(i);
+        int camera_robot_idx = association_.get_measurement_for_track(i);
 
-        // We had at least one measurement near this Robot
-        if (!measurement_robots.empty()) {
-            CameraRobot avg_robot = CameraRobot::combine_robots(measurement_robots);
-            kalman_robot.predict_and_update(calc_time, avg_robot);
+        // We had a measurement near this Robot
+        if (camera_robot_idx != GatedAssignment::kUnassigned) {
+            kalman_robot.predict_and_update(calc_time, single_robot_list.at(camera_robot_idx));
 
             // There aren't any measurements so just predict
         } else {
@@ -298,23 +335,22 @@ void Camera::update_robots_mhkf(RJ::Time calc_time, const std::list<CameraRobot>
     }
 
     // Create kalman robots if one isn't near camera measurement
-    int camera_robot_idx = 0;
-    for (const CameraRobot& camera_robot : single_robot_list) {
-        bool was_used = used_camera_robot.at(camera_robot_idx);
+    for (size_t i = 0; i < single_robot_list.size(); i++) {
+        const CameraRobot& camera_robot = single_robot_list.at(i);
+        bool was_used = association_.is_gated(i);
 
         if (!was_used &&
             single_kalman_robot_list.size() < (unsigned long)PARAM_max_num_kalman_robots) {
             single_kalman_robot_list.emplace_back(camera_id_, calc_time, camera_robot,
                                                   previous_world_robot);
         }
-
-        camera_robot_idx++;
     }
 }
 
-void Camera::update_robots_akf(RJ::Time calc_time, const std::list<CameraRobot>& single_robot_list,
+void Camera::update_robots_akf(RJ::Time calc_time,
+                               const std::vector<CameraRobot>& single_robot_list,
                                const WorldRobot& previous_world_robot,
-                               std::list<KalmanRobot>& single_kalman_robot_list) {
+                               std::vector<KalmanRobot>& single_kalman_robot_list) {
     // Average everything and add as measuremnet
     CameraRobot avg_robot = CameraRobot::combine_robots(single_robot_list);
 
@@ -333,36 +369,46 @@ void Camera::update_robots_akf(RJ::Time calc_time, const std::list<CameraRobot>&
 
 void Camera::remove_invalid_balls() {
     // Remove all balls that are unhealthy
-    kalman_ball_list_.remove_if([](KalmanBall& b) { return b.is_unhealthy(); });
+    remove_unhealthy(kalman_ball_list_);
 }
 
 void Camera::remove_invalid_robots() {
     // Remove all the robots that are unhealthy
-    for (std::list<KalmanRobot>& robot_list : kalman_robot_blue_list_) {
-        robot_list.remove_if([](KalmanRobot& r) { return r.is_unhealthy(); });
+    for (std::vector<KalmanRobot>& robot_list : kalman_robot_blue_list_) {
+        remove_unhealthy(robot_list);
     }
 
-    for (std::list<KalmanRobot>& robot_list : kalman_robot_yellow_list_) {
-        robot_list.remove_if([](KalmanRobot& r) { return r.is_unhealthy(); });
+    for (std::vector<KalmanRobot>& robot_list : kalman_robot_yellow_list_) {
+        remove_unhealthy(robot_list);
     }
 }
 
 void Camera::predict_all_robots(RJ::Time calc_time,
-                                std::vector<std::list<KalmanRobot>>& robot_list_list) {
-    for (std::list<KalmanRobot>& robot_list : robot_list_list) {
+                                std::vector<std::vector<KalmanRobot>>& robot_list_list) {
+    for (std::vector<KalmanRobot>& robot_list : robot_list_list) {
         for (KalmanRobot& robot : robot_list) {
             robot.predict(calc_time);
         }
     }
 }
 
-const std::list<KalmanBall>& Camera::get_kalman_balls() const { return kalman_ball_list_; }
+const std::vector<KalmanBall>& Camera::get_kalman_balls() const { return kalman_ball_list_; }
 
-const std::vector<std::list<KalmanRobot>>& Camera::get_kalman_robots_yellow() const {
+const std::vector<std::vector<KalmanRobot>>& Camera::get_kalman_robots_yellow() const {
     return kalman_robot_yellow_list_;
 }
 
-const std::vector<std::list<KalmanRobot>>& Camera::get_kalman_robots_blue() const {
+const std::vector<std::vector<KalmanRobot>>& Camera::get_kalman_robots_blue() const {
     return kalman_robot_blue_list_;
 }
+
+const KalmanBall* Camera::get_best_kalman_ball() const { return healthiest(kalman_ball_list_); }
+
+const KalmanRobot* Camera::get_best_kalman_robot_yellow(size_t robot_id) const {
+    return healthiest(kalman_robot_yellow_list_.at(robot_id));
+}
+
+const KalmanRobot* Camera::get_best_kalman_robot_blue(size_t robot_id) const {
+    return healthiest(kalman_robot_blue_list_.at(robot_id));
+}
 }  // namespace vision_filter
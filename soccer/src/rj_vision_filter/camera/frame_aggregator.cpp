@@ -0,0 +1,73 @@
+#include <rj_vision_filter/camera/frame_aggregator.hpp>
+
+namespace vision_filter {
+FrameAggregator::FrameAggregator(RJ::Seconds window, RJ::Seconds camera_timeout)
+    : window_(window), camera_timeout_(camera_timeout) {}
+
+bool FrameAggregator::add(CameraFrame frame, RJ::Time now) {
+    if (frame.camera_id < 0) {
+        num_dropped_++;
+        return false;
+    }
+
+    if (static_cast<size_t>(frame.camera_id) >= cameras_.size()) {
+        cameras_.resize(frame.camera_id + 1);
+    }
+
+    CameraState& camera = cameras_.at(frame.camera_id);
+
+    if (camera.seen && frame.t_capture <= camera.newest_capture) {
+        num_dropped_++;
+        return false;
+    }
+
+    camera.seen = true;
+    camera.last_arrival = now;
+    camera.newest_capture = frame.t_capture;
+
+    if (camera.pending_index >= 0) {
+        // Superseded before its batch was processed
+        pending_.at(camera.pending_index) = std::move(frame);
+        num_dropped_++;
+    } else {
+        if (pending_.empty()) {
+            batch_start_ = now;
+        }
+
+        camera.pending_index = static_cast<int>(pending_.size());
+        pending_.push_back(std::move(frame));
+    }
+
+    return true;
+}
+
+bool FrameAggregator::ready(RJ::Time now) const {
+    if (pending_.empty()) {
+        return false;
+    }
+
+    if (RJ::Seconds(now - batch_start_) >= window_) {
+        return true;
+    }
+
+    // Otherwise wait until every live camera has reported
+    for (const CameraState& camera : cameras_) {
+        bool is_live = camera.seen && RJ::Seconds(now - camera.last_arrival) < camera_timeout_;
+
+        if (is_live && camera.pending_index < 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FrameAggregator::take(std::vector<CameraFrame>* frames) {
+    frames->clear();
+    frames->swap(pending_);
+
+    for (CameraState& camera : cameras_) {
+        camera.pending_index = -1;
+    }
+}
+}  // namespace vision_filter
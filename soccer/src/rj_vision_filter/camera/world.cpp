@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <rj_constants/constants.hpp>
 #include <rj_vision_filter/camera/world.hpp>
 #include <rj_vision_filter/params.hpp>
@@ -12,13 +14,19 @@ DEFINE_NS_FLOAT64(kVisionFilterParamModule, kick::detector, slow_kick_timeout, 0
 DEFINE_NS_FLOAT64(kVisionFilterParamModule, kick::detector, same_kick_timeout, 0.5,
                   "Only replace fast kick estimate with a slow when the two "
                   "times are within this amount.")
+DEFINE_INT64(kVisionFilterParamModule, num_camera_threads, 1,
+             "Threads used to update the cameras in parallel each frame. 1 "
+             "updates them one after another on the callback thread.")
 using namespace kick::detector;
 
 World::World()
     : last_update_time_{RJ::Time{RJ::Time::duration(0)}},
       cameras_(PARAM_max_num_cameras),
       robots_yellow_(kNumShells, WorldRobot()),
-      robots_blue_(kNumShells, WorldRobot()) {}
+      robots_blue_(kNumShells, WorldRobot()),
+      frames_by_camera_(PARAM_max_num_cameras),
+      best_kalman_robots_yellow_(kNumShells),
+      best_kalman_robots_blue_(kNumShells) {}
 
 void World::update_single_camera(RJ::Time calc_time, const CameraFrame& frame) {
     update_with_camera_frame(calc_time, {frame}, false);
@@ -28,9 +36,11 @@ void World::update_with_camera_frame(RJ::Time calc_time, const std::vector<Camer
                                      bool update_all) {
     calc_ball_bounce();
 
-    std::vector<bool> camera_updated(PARAM_max_num_cameras, false);
-
-    // TODO: Take only the newest frame if 2 come in for the same camera
+    // Group the frames by camera, keeping their order, so that each camera
+    // can be updated on its own
+    for (std::vector<const CameraFrame*>& frames : frames_by_camera_) {
+        frames.clear();
+    }
 
     for (const CameraFrame& frame : new_frames) {
         // Make sure camera from frame is created, if not, make it
@@ -38,37 +48,13 @@ void World::update_with_camera_frame(RJ::Time calc_time, const std::vector<Camer
             cameras_.at(frame.camera_id) = Camera(frame.camera_id);
         }
 
-        // Take the non-sorted list from the frame and make a list for the
-        // cameras
-        std::vector<std::list<CameraRobot>> yellow_team(kNumShells);
-        std::vector<std::list<CameraRobot>> blue_team(kNumShells);
-
-        for (const CameraRobot& robot : frame.camera_robots_yellow) {
-            yellow_team.at(robot.get_robot_id()).push_back(robot);
-        }
-
-        for (const CameraRobot& robot : frame.camera_robots_blue) {
-            blue_team.at(robot.get_robot_id()).push_back(robot);
-        }
-
-        cameras_.at(frame.camera_id)
-            .update_with_frame(calc_time, frame.camera_balls, yellow_team, blue_team, ball_,
-                               robots_yellow_, robots_blue_);
-
-        camera_updated.at(frame.camera_id) = true;
+        frames_by_camera_.at(frame.camera_id).push_back(&frame);
 
         // Update last_update_time_ with the latest t_capture.
         last_update_time_ = std::max(last_update_time_, frame.t_capture);
     }
 
-    if (update_all) {
-        for (size_t i = 0; i < cameras_.size(); i++) {
-            if (!camera_updated.at(i) && cameras_.at(i).get_is_valid()) {
-                cameras_.at(i).update_without_frame(calc_time);
-            }
-        }
-    }
-
+    update_cameras(calc_time, update_all);
     update_world_objects(calc_time);
     detect_kicks(calc_time);
 }
@@ -76,16 +62,57 @@ void World::update_with_camera_frame(RJ::Time calc_time, const std::vector<Camer
 void World::update_without_camera_frame(RJ::Time calc_time) {
     calc_ball_bounce();
 
-    for (Camera& camera : cameras_) {
-        if (camera.get_is_valid()) {
-            camera.update_without_frame(calc_time);
-        }
+    for (std::vector<const CameraFrame*>& frames : frames_by_camera_) {
+        frames.clear();
     }
 
+    update_cameras(calc_time, true);
     update_world_objects(calc_time);
     detect_kicks(calc_time);
 }
 
+void World::update_cameras(RJ::Time calc_time, bool update_all) {
+    const auto num_threads = static_cast<size_t>(std::max<int64_t>(PARAM_num_camera_threads, 1));
+
+    if (num_threads == 1) {
+        for (size_t i = 0; i < cameras_.size(); i++) {
+            update_camera(i, calc_time, update_all);
+        }
+
+        return;
+    }
+
+    // Every camera only reads the world objects from the previous frame and
+    // writes to itself, so they can all run at once. They are merged back
+    // together in update_world_objects() after the pool's barrier.
+    camera_tasks_.clear();
+    for (size_t i = 0; i < cameras_.size(); i++) {
+        if (cameras_.at(i).get_is_valid()) {
+            camera_tasks_.emplace_back(
+                [this, i, calc_time, update_all]() { update_camera(i, calc_time, update_all); });
+        }
+    }
+
+    if (camera_pool_ == nullptr || camera_pool_->num_threads() != num_threads) {
+        camera_pool_ = std::make_unique<rj_utils::WorkerPool>(num_threads);
+    }
+
+    camera_pool_->run_all(camera_tasks_);
+}
+
+void World::update_camera(size_t camera_id, RJ::Time calc_time, bool update_all) {
+    Camera& camera = cameras_.at(camera_id);
+    const std::vector<const CameraFrame*>& frames = frames_by_camera_.at(camera_id);
+
+    if (!frames.empty()) {
+        for (const CameraFrame* frame : frames) {
+            camera.update_with_frame(calc_time, *frame, ball_, robots_yellow_, robots_blue_);
+        }
+    } else if (update_all && camera.get_is_valid()) {
+        camera.update_without_frame(calc_time);
+    }
+}
+
 void World::calc_ball_bounce() {
     for (Camera& camera : cameras_) {
         if (camera.get_is_valid()) {
@@ -101,68 +128,47 @@ void World::update_world_objects(RJ::Time calc_time) {
     std::fill(robots_yellow_.begin(), robots_yellow_.end(), WorldRobot());
     std::fill(robots_blue_.begin(), robots_blue_.end(), WorldRobot());
 
-    std::list<KalmanBall> kalman_balls;
-    std::vector<std::list<KalmanRobot>> kalman_robots_yellow(kNumShells);
-    std::vector<std::list<KalmanRobot>> kalman_robots_blue(kNumShells);
+    best_kalman_balls_.clear();
+    for (size_t i = 0; i < kNumShells; i++) {
+        best_kalman_robots_yellow_.at(i).clear();
+        best_kalman_robots_blue_.at(i).clear();
+    }
 
     // Take best kalman filter from every camera and combine them
-    for (Camera& camera : cameras_) {
+    for (const Camera& camera : cameras_) {
         if (camera.get_is_valid()) {
-            std::list<KalmanBall> camera_balls = camera.get_kalman_balls();
-            std::vector<std::list<KalmanRobot>> camera_robots_yellow =
-                camera.get_kalman_robots_yellow();
-            std::vector<std::list<KalmanRobot>> camera_robots_blue =
-                camera.get_kalman_robots_blue();
-
-            if (!camera_balls.empty()) {
-                // Sort by health of the kalman filter
-                camera_balls.sort([](KalmanBall& a, KalmanBall& b) -> bool {
-                    return a.get_health() > b.get_health();
-                });
-
-                kalman_balls.push_back(camera_balls.front());
+            if (const KalmanBall* best_ball = camera.get_best_kalman_ball()) {
+                best_kalman_balls_.push_back(*best_ball);
             }
 
-            // Take the best kalman filter from the camera
-            for (size_t i = 0; i < camera_robots_yellow.size(); i++) {
-                if (!camera_robots_yellow.at(i).empty()) {
-                    camera_robots_yellow.at(i).sort([](KalmanRobot& a, KalmanRobot& b) -> bool {
-                        return a.get_health() > b.get_health();
-                    });
-
-                    kalman_robots_yellow.at(i).push_back(camera_robots_yellow.at(i).front());
+            for (size_t i = 0; i < kNumShells; i++) {
+                if (const KalmanRobot* best_robot = camera.get_best_kalman_robot_yellow(i)) {
+                    best_kalman_robots_yellow_.at(i).push_back(*best_robot);
                 }
-            }
-
-            // Take the best kalman filter from the camera
-            for (size_t i = 0; i < camera_robots_blue.size(); i++) {
-                if (!camera_robots_blue.at(i).empty()) {
-                    camera_robots_blue.at(i).sort([](KalmanRobot& a, KalmanRobot& b) -> bool {
-                        return a.get_health() > b.get_health();
-                    });
 
-                    kalman_robots_blue.at(i).push_back(camera_robots_blue.at(i).front());
+                if (const KalmanRobot* best_robot = camera.get_best_kalman_robot_blue(i)) {
+                    best_kalman_robots_blue_.at(i).push_back(*best_robot);
                 }
             }
         }
     }
 
     // Only replace the invalid result if we have measurements on any camera
-    if (!kalman_balls.empty()) {
-        ball_ = WorldBall(calc_time, kalman_balls);
+    if (!best_kalman_balls_.empty()) {
+        ball_ = WorldBall(calc_time, best_kalman_balls_);
     }
 
     for (size_t i = 0; i < robots_yellow_.size(); i++) {
-        if (!kalman_robots_yellow.at(i).empty()) {
-            robots_yellow_.at(i) =
-                WorldRobot(calc_time, WorldRobot::Team::YELLOW, i, kalman_robots_yellow.at(i));
+        if (!best_kalman_robots_yellow_.at(i).empty()) {
+            robots_yellow_.at(i) = WorldRobot(calc_time, WorldRobot::Team::YELLOW, i,
+                                              best_kalman_robots_yellow_.at(i));
         }
     }
 
     for (size_t i = 0; i < robots_blue_.size(); i++) {
-        if (!kalman_robots_blue.at(i).empty()) {
+        if (!best_kalman_robots_blue_.at(i).empty()) {
             robots_blue_.at(i) =
-                WorldRobot(calc_time, WorldRobot::Team::BLUE, i, kalman_robots_blue.at(i));
+                WorldRobot(calc_time, WorldRobot::Team::BLUE, i, best_kalman_robots_blue_.at(i));
         }
     }
 }
@@ -171,10 +177,17 @@ void World::detect_kicks(RJ::Time calc_time) {
     KickEvent fast_event;
     KickEvent slow_event;
 
-    bool is_fast_kick =
-        fast_kick_.add_record(calc_time, ball_, robots_yellow_, robots_blue_, fast_event);
-    bool is_slow_kick =
-        slow_kick_.add_record(calc_time, ball_, robots_yellow_, robots_blue_, &slow_event);
+    // Both detectors look back over the same history, sized for the longer
+    const auto history_length = static_cast<size_t>(
+        std::max(PARAM_fast_kick_hist_length, PARAM_slow_kick_hist_length));
+    if (kick_history_.capacity() != history_length) {
+        kick_history_ = KickHistory(history_length);
+    }
+
+    kick_history_.add(calc_time, ball_, robots_yellow_, robots_blue_);
+
+    bool is_fast_kick = fast_kick_.detect(kick_history_, &fast_event);
+    bool is_slow_kick = slow_kick_.detect(kick_history_, &slow_event);
 
     // If there isn't a kick recorded already
     if (!best_kick_estimate_.get_is_valid()) {
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <rj_vision_filter/filter/gated_assignment.hpp>
+
+namespace vision_filter {
+namespace {
+// Cost of pairing a track with a measurement outside its gate. Much larger
+// than any sum of real distances, so the solver only pairs outside the gate
+// when it has no choice, and those pairs get thrown away afterwards.
+constexpr double kInfeasible = 1e6;
+}  // namespace
+
+void GatedAssignment::clear() {
+    track_pos_.clear();
+    track_gate_.clear();
+    measurement_pos_.clear();
+    track_assignments_.clear();
+    measurement_gated_.clear();
+}
+
+void GatedAssignment::add_track(rj_geometry::Point pos, double gate_radius) {
+    track_pos_.push_back(pos);
+    track_gate_.push_back(gate_radius);
+}
+
+void GatedAssignment::add_measurement(rj_geometry::Point pos) { measurement_pos_.push_back(pos); }
+
+void GatedAssignment::solve() {
+    const int num_tracks = static_cast<int>(track_pos_.size());
+    const int num_measurements = static_cast<int>(measurement_pos_.size());
+
+    track_assignments_.assign(num_tracks, kUnassigned);
+    measurement_gated_.assign(num_measurements, false);
+
+    if (num_tracks == 0 || num_measurements == 0) {
+        return;
+    }
+
+    // Sort the measurements by x so each track only has to look at the ones
+    // in the vertical strip its gate covers
+    measurements_by_x_.resize(num_measurements);
+    std::iota(measurements_by_x_.begin(), measurements_by_x_.end(), 0);
+    std::sort(measurements_by_x_.begin(), measurements_by_x_.end(),
+              [this](int a, int b) { return measurement_pos_[a].x() < measurement_pos_[b].x(); });
+
+    cluster_parent_.resize(num_tracks + num_measurements);
+    std::iota(cluster_parent_.begin(), cluster_parent_.end(), 0);
+    gated_pairs_.clear();
+
+    for (int track = 0; track < num_tracks; track++) {
+        const rj_geometry::Point pos = track_pos_[track];
+        const double gate = track_gate_[track];
+
+        auto it = std::lower_bound(
+            measurements_by_x_.begin(), measurements_by_x_.end(), pos.x() - gate,
+            [this](int measurement, double x) { return measurement_pos_[measurement].x() < x; });
+
+        for (; it != measurements_by_x_.end() && measurement_pos_[*it].x() <= pos.x() + gate;
+             ++it) {
+            if (pos.dist_to(measurement_pos_[*it]) < gate) {
+                gated_pairs_.emplace_back(track, *it);
+                measurement_gated_[*it] = true;
+                cluster_parent_[find_cluster(num_tracks + *it)] = find_cluster(track);
+            }
+        }
+    }
+
+    // Group the gated pairs by cluster and solve each one on its own
+    for (int node = 0; node < num_tracks + num_measurements; node++) {
+        cluster_parent_[node] = find_cluster(node);
+    }
+
+    std::sort(gated_pairs_.begin(), gated_pairs_.end(),
+              [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                  return cluster_parent_[a.first] < cluster_parent_[b.first];
+              });
+
+    local_index_.assign(num_tracks + num_measurements, -1);
+
+    size_t begin = 0;
+    while (begin < gated_pairs_.size()) {
+        const int cluster = cluster_parent_[gated_pairs_[begin].first];
+
+        size_t end = begin + 1;
+        while (end < gated_pairs_.size() && cluster_parent_[gated_pairs_[end].first] == cluster) {
+            end++;
+        }
+
+        solve_cluster(begin, end);
+        begin = end;
+    }
+}
+
+int GatedAssignment::get_measurement_for_track(size_t track) const {
+    return track_assignments_.at(track);
+}
+
+bool GatedAssignment::is_gated(size_t measurement) const {
+    return measurement_gated_.at(measurement);
+}
+
+int GatedAssignment::find_cluster(int node) {
+    while (cluster_parent_[node] != node) {
+        cluster_parent_[node] = cluster_parent_[cluster_parent_[node]];
+        node = cluster_parent_[node];
+    }
+
+    return node;
+}
+
+void GatedAssignment::solve_cluster(size_t begin, size_t end) {
+    const int num_tracks = static_cast<int>(track_pos_.size());
+
+    // By far the most common case: one object seen once
+    if (end - begin == 1) {
+        track_assignments_[gated_pairs_[begin].first] = gated_pairs_[begin].second;
+        return;
+    }
+
+    cluster_tracks_.clear();
+    cluster_measurements_.clear();
+
+    for (size_t i = begin; i < end; i++) {
+        const auto [track, measurement] = gated_pairs_[i];
+
+        if (local_index_[track] < 0) {
+            local_index_[track] = static_cast<int>(cluster_tracks_.size());
+            cluster_tracks_.push_back(track);
+        }
+
+        if (local_index_[num_tracks + measurement] < 0) {
+            local_index_[num_tracks + measurement] = static_cast<int>(cluster_measurements_.size());
+            cluster_measurements_.push_back(measurement);
+        }
+    }
+
+    // The solver needs at least as many columns as rows
+    const bool tracks_are_rows = cluster_tracks_.size() <= cluster_measurements_.size();
+    const int rows =
+        static_cast<int>(tracks_are_rows ? cluster_tracks_.size() : cluster_measurements_.size());
+    const int cols =
+        static_cast<int>(tracks_are_rows ? cluster_measurements_.size() : cluster_tracks_.size());
+
+    cost_.assign(static_cast<size_t>(rows) * cols, kInfeasible);
+
+    for (size_t i = begin; i < end; i++) {
+        const auto [track, measurement] = gated_pairs_[i];
+        const int local_track = local_index_[track];
+        const int local_measurement = local_index_[num_tracks + measurement];
+
+        const int row = tracks_are_rows ? local_track : local_measurement;
+        const int col = tracks_are_rows ? local_measurement : local_track;
+
+        cost_[row * cols + col] = track_pos_[track].dist_to(measurement_pos_[measurement]);
+    }
+
+    hungarian(rows, cols);
+
+    for (int col = 1; col <= cols; col++) {
+        const int row = column_rows_[col];
+
+        if (row == 0 || cost_[(row - 1) * cols + (col - 1)] >= kInfeasible) {
+            continue;
+        }
+
+        const int local_track = tracks_are_rows ? row - 1 : col - 1;
+        const int local_measurement = tracks_are_rows ? col - 1 : row - 1;
+        track_assignments_[cluster_tracks_[local_track]] = cluster_measurements_[local_measurement];
+    }
+
+    for (int track : cluster_tracks_) {
+        local_index_[track] = -1;
+    }
+
+    for (int measurement : cluster_measurements_) {
+        local_index_[num_tracks + measurement] = -1;
+    }
+}
+
+void GatedAssignment::hungarian(int rows, int cols) {
+    // Shortest augmenting path version of the Hungarian algorithm, O(rows^2 *
+    // cols). Everything is 1-indexed, with column 0 as a dummy that holds the
+    // row currently being added.
+    //
+    // See https://en.wikipedia.org/wiki/Hungarian_algorithm
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+
+    row_potential_.assign(rows + 1, 0);
+    column_potential_.assign(cols + 1, 0);
+    column_rows_.assign(cols + 1, 0);
+    column_way_.assign(cols + 1, 0);
+
+    for (int row = 1; row <= rows; row++) {
+        column_rows_[0] = row;
+        int col0 = 0;
+        min_slack_.assign(cols + 1, kInf);
+        column_used_.assign(cols + 1, false);
+
+        do {
+            column_used_[col0] = true;
+            const int row0 = column_rows_[col0];
+            double delta = kInf;
+            int col1 = 0;
+
+            for (int col = 1; col <= cols; col++) {
+                if (column_used_[col]) {
+                    continue;
+                }
+
+                const double slack = cost_[(row0 - 1) * cols + (col - 1)] -
+                                     row_potential_[row0] - column_potential_[col];
+                if (slack < min_slack_[col]) {
+                    min_slack_[col] = slack;
+                    column_way_[col] = col0;
+                }
+
+                if (min_slack_[col] < delta) {
+                    delta = min_slack_[col];
+                    col1 = col;
+                }
+            }
+
+            for (int col = 0; col <= cols; col++) {
+                if (column_used_[col]) {
+                    row_potential_[column_rows_[col]] += delta;
+                    column_potential_[col] -= delta;
+                } else {
+                    min_slack_[col] -= delta;
+                }
+            }
+
+            col0 = col1;
+        } while (column_rows_[col0] != 0);
+
+        // Flip the augmenting path
+        do {
+            const int col1 = column_way_[col0];
+            column_rows_[col0] = column_rows_[col1];
+            col0 = col1;
+        } while (col0 != 0);
+    }
+}
+}  // namespace vision_filter
@@ -1,7 +1,8 @@
 #include <rj_vision_filter/filter/kalman_filter.hpp>
 
 namespace vision_filter {
-void KalmanFilter::predict() {
+template <int StateSize, int ObservationSize>
+void KalmanFilter<StateSize, ObservationSize>::predict() {
     x_k1_k1_ = x_k_k_;
     P_k1_k1_ = P_k_k_;
 
@@ -13,7 +14,8 @@ void KalmanFilter::predict() {
     P_k_k_ = P_k_k1_;
 }
 
-void KalmanFilter::predict_with_update() {
+template <int StateSize, int ObservationSize>
+void KalmanFilter<StateSize, ObservationSize>::predict_with_update() {
     x_k1_k1_ = x_k_k_;
     P_k1_k1_ = P_k_k_;
 
@@ -28,9 +30,14 @@ void KalmanFilter::predict_with_update() {
     K_k_ = P_k_k1_ * H_k_.transpose() * S_k_.inverse();
 
     x_k_k_ = x_k_k1_ + K_k_ * y_k_k1_;
-    P_k_k_ = (identity_ - K_k_ * H_k_) * P_k_k1_ * (identity_ - K_k_ * H_k_).transpose() +
-             K_k_ * R_k_ * K_k_.transpose();
+    const StateMatrix i_kh = StateMatrix::Identity() - K_k_ * H_k_;
+    P_k_k_ = i_kh * P_k_k1_ * i_kh.transpose() + K_k_ * R_k_ * K_k_.transpose();
 
     y_k_k_ = z_k_ - H_k_ * x_k_k_;
 }
-}  // namespace vision_filter
\ No newline at end of file
+
+// Ball: X pos, X vel, Y pos, Y vel observed through X/Y position
+template class KalmanFilter<4, 2>;
+// Robot: the above plus theta and omega, observed through X/Y/theta
+template class KalmanFilter<6, 3>;
+}  // namespace vision_filter
@@ -16,10 +16,9 @@ DEFINE_NS_FLOAT64(kVisionFilterParamModule, robot, orientation_scale, 1.0,
                   "Scales the covariance and noise to radians instead of "
                   "meters. Shouldn't matter too much, but it's here.")
 
-KalmanFilter3D::KalmanFilter3D() : KalmanFilter(1, 1) {}
+KalmanFilter3D::KalmanFilter3D() = default;
 
-KalmanFilter3D::KalmanFilter3D(rj_geometry::Pose init_pose, rj_geometry::Twist init_twist)
-    : KalmanFilter(6, 3) {
+KalmanFilter3D::KalmanFilter3D(rj_geometry::Pose init_pose, rj_geometry::Twist init_twist) {
     // States are X pos, X vel, Y pos, Y vel, theta, omega
     x_k1_k1_ << init_pose.position().x(), init_twist.linear().x(), init_pose.position().y(),
         init_twist.linear().y(), init_pose.heading(), init_twist.angular();
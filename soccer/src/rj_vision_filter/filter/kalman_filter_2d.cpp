@@ -13,10 +13,9 @@ DEFINE_NS_FLOAT64(kVisionFilterParamModule, ball, process_noise, 0.1,
 DEFINE_NS_FLOAT64(kVisionFilterParamModule, ball, observation_noise, 2.0,
                   "Controls how much it trusts measurements from the camera.")
 
-KalmanFilter2D::KalmanFilter2D() : KalmanFilter(1, 1) {}
+KalmanFilter2D::KalmanFilter2D() = default;
 
-KalmanFilter2D::KalmanFilter2D(rj_geometry::Point init_pos, rj_geometry::Point init_vel)
-    : KalmanFilter(4, 2) {
+KalmanFilter2D::KalmanFilter2D(rj_geometry::Point init_pos, rj_geometry::Point init_vel) {
     // clang-format off
     // States are X pos, X vel, Y pos, Y vel
     x_k1_k1_ << init_pos.x(),
@@ -1,8 +1,8 @@
+#include <algorithm>
 #include <cmath>
-#include <deque>
-#include <iterator>
 #include <limits>
 
+#include <rj_constants/constants.hpp>
 #include <rj_geometry/point.hpp>
 #include <rj_vision_filter/kick/detector/fast_kick_detector.hpp>
 #include <rj_vision_filter/params.hpp>
@@ -14,62 +14,52 @@ DEFINE_NS_FLOAT64(kVisionFilterParamModule, kick::detector, fast_acceleration_tr
                   "detector in m/s^2. ")
 using kick::detector::PARAM_fast_acceleration_trigger;
 
-bool FastKickDetector::add_record(RJ::Time calc_time, const WorldBall& ball,
-                                  const std::vector<WorldRobot>& yellow_robots,
-                                  const std::vector<WorldRobot>& blue_robots,
-                                  KickEvent& kick_event) {
-    // Keep it a certain length
-    state_history_.emplace_back(calc_time, ball, yellow_robots, blue_robots);
-    if (state_history_.size() > static_cast<size_t>(kick::detector::PARAM_fast_kick_hist_length)) {
-        state_history_.pop_front();
-    }
+bool FastKickDetector::detect(const KickHistory& history, KickEvent* kick_event) const {
+    const auto count = static_cast<size_t>(kick::detector::PARAM_fast_kick_hist_length);
 
     // If we don't have enough, just return
-    if (state_history_.size() < static_cast<size_t>(kick::detector::PARAM_fast_kick_hist_length)) {
+    if (count < 2 || history.size() < count) {
         return false;
     }
 
+    KickHistory::BallTrack ball = history.ball_track(count);
+
     // Make sure all the balls are valid
     // Otherwise we can't do anything
-    bool all_valid = std::all_of(state_history_.begin(), state_history_.end(),
-                                 [](VisionState& v) { return v.ball.get_is_valid(); });
+    bool all_valid = std::all_of(ball.valid, ball.valid + count, [](uint8_t v) { return v; });
 
     if (!all_valid) {
         return false;
     }
 
     // If we didn't kick, just return
-    if (!detect_kick()) {
+    if (!detect_kick(ball.pos, count)) {
         return false;
     }
 
     // Assume the kick happened in the middle of the history
-    int mid_idx = static_cast<int>(std::floor(state_history_.size() / 2));
+    size_t mid_idx = count / 2;
 
-    WorldRobot closest_robot = get_closest_robot();
-    RJ::Time kick_time = state_history_.at(mid_idx).calc_time;
-    std::deque<VisionState> states_since_kick(std::next(state_history_.begin(), mid_idx),
-                                              state_history_.end());
+    WorldRobot::Team closest_team = WorldRobot::Team::YELLOW;
+    int closest_id = get_closest_robot(history, count, mid_idx, &closest_team);
 
-    kick_event = KickEvent(kick_time, closest_robot, states_since_kick);
+    *kick_event = KickEvent(history, count, mid_idx, closest_team, closest_id);
 
     return true;
 }
 
-bool FastKickDetector::detect_kick() {
+bool FastKickDetector::detect_kick(const rj_geometry::Point* ball_pos, size_t count) {
     // Note: This may be weird at camera frame intersections
     // It may be a good idea to look at the kalman balls
     // and checking kalman balls for velocity jumps
 
     // Returns true on a large velocity jump across the first and last
     // velocity calc
-    int end_idx = state_history_.size() - 1;
+    size_t end_idx = count - 1;
 
     // Change in position between two adjacent measurements
-    rj_geometry::Point dp_start =
-        state_history_.at(1).ball.get_pos() - state_history_.at(0).ball.get_pos();
-    rj_geometry::Point dp_end =
-        state_history_.at(end_idx).ball.get_pos() - state_history_.at(end_idx - 1).ball.get_pos();
+    rj_geometry::Point dp_start = ball_pos[1] - ball_pos[0];
+    rj_geometry::Point dp_end = ball_pos[end_idx] - ball_pos[end_idx - 1];
 
     // Velocity at the start and end measurements
     rj_geometry::Point v_start = dp_start / PARAM_vision_loop_dt;
@@ -81,44 +71,40 @@ bool FastKickDetector::detect_kick() {
     // Acceleration between the start and final velocity
     // This is weird when the history length is > 3, but it allows you not to
     // have to retune it
-    rj_geometry::Point accel = dv / (PARAM_vision_loop_dt * state_history_.size());
+    rj_geometry::Point accel = dv / (PARAM_vision_loop_dt * count);
 
     // Check for large accelerations and only going from slow->fast transitions
     return accel.mag() > PARAM_fast_acceleration_trigger && v_start.mag() < v_end.mag();
 }
 
-WorldRobot FastKickDetector::get_closest_robot() {
+int FastKickDetector::get_closest_robot(const KickHistory& history, size_t count, size_t kick_idx,
+                                        WorldRobot::Team* team) {
     // Get's the closest robot to the ball position in the center measurement
     // Assumes kick is in the center
     // Valid assumption as long as history length is small
 
-    int mid_idx = (int)floor(state_history_.size() / 2);
-    rj_geometry::Point mid_ball_pos = state_history_.at(mid_idx).ball.get_pos();
+    rj_geometry::Point mid_ball_pos = history.ball_track(count).pos[kick_idx];
 
-    WorldRobot min_robot;
+    int min_id = -1;
     double min_dist = std::numeric_limits<double>::infinity();
 
     // Finds closest robot to ball at assumed kick time
-    for (WorldRobot& robot : state_history_.at(mid_idx).yellow_robots) {
-        if (robot.get_is_valid()) {
-            double dist = (mid_ball_pos - robot.get_pos()).mag();
-
-            if (dist < min_dist) {
-                min_robot = robot;
-            }
-        }
-    }
-
-    for (WorldRobot& robot : state_history_.at(mid_idx).blue_robots) {
-        if (robot.get_is_valid()) {
-            double dist = (mid_ball_pos - robot.get_pos()).mag();
-
-            if (dist < min_dist) {
-                min_robot = robot;
+    for (WorldRobot::Team robot_team : {WorldRobot::Team::YELLOW, WorldRobot::Team::BLUE}) {
+        for (size_t id = 0; id < kNumShells; id++) {
+            KickHistory::RobotTrack robot = history.robot_track(robot_team, id, count);
+
+            if (robot.valid[kick_idx]) {
+                double dist = (mid_ball_pos - robot.pos[kick_idx]).mag();
+
+                if (dist < min_dist) {
+                    min_dist = dist;
+                    min_id = static_cast<int>(id);
+                    *team = robot_team;
+                }
             }
         }
     }
 
-    return min_robot;
+    return min_id;
 }
-}  // namespace vision_filter
\ No newline at end of file
+}  // namespace vision_filter
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include <rj_constants/constants.hpp>
 #include <rj_geometry/point.hpp>
 #include <rj_vision_filter/kick/detector/slow_kick_detector.hpp>
 #include <rj_vision_filter/params.hpp>
@@ -19,152 +20,103 @@ DEFINE_NS_FLOAT64(kVisionFilterParamModule, kick::detector, slow_max_kick_angle,
                   "Max angle difference between velocity vector and robot heading.")
 using namespace kick::detector;
 
-bool SlowKickDetector::add_record(RJ::Time calc_time, const WorldBall& ball,
-                                  const std::vector<WorldRobot>& yellow_robots,
-                                  const std::vector<WorldRobot>& blue_robots,
-                                  KickEvent* kick_event) {
-    // Keep it a certain length
-    state_history_.emplace_back(calc_time, ball, yellow_robots, blue_robots);
-    if (state_history_.size() > static_cast<size_t>(kick::detector::PARAM_slow_kick_hist_length)) {
-        state_history_.pop_front();
-    }
+bool SlowKickDetector::detect(const KickHistory& history, KickEvent* kick_event) const {
+    // Look at up to the last slow_kick_hist_length records
+    const size_t count =
+        std::min(history.size(), static_cast<size_t>(kick::detector::PARAM_slow_kick_hist_length));
 
     // If we don't have enough, just return
-    if (state_history_.size() < static_cast<size_t>(kick::detector::PARAM_fast_kick_hist_length)) {
+    if (count == 0 || count < static_cast<size_t>(kick::detector::PARAM_fast_kick_hist_length)) {
         return false;
     }
 
+    KickHistory::BallTrack ball = history.ball_track(count);
+
     // Make sure all the balls are valid
     // Otherwise we can't do anything
-    bool all_valid = std::all_of(state_history_.begin(), state_history_.end(),
-                                 [](VisionState& v) { return v.ball.get_is_valid(); });
+    bool all_valid = std::all_of(ball.valid, ball.valid + count, [](uint8_t v) { return v; });
 
     if (!all_valid) {
         return false;
     }
 
-    return detect_kick(kick_event);
-}
-
-bool SlowKickDetector::detect_kick(KickEvent* kick_event) {
     // Find all the robots who have enough samples
     // Cut out any that are too far
     // Test validators on all of them
-
-    std::vector<WorldBall> ball_list(state_history_.size());
-    for (size_t i = 0; i < state_history_.size(); i++) {
-        ball_list.at(i) = state_history_.at(i).ball;
-    }
-
-    // Check all robots if they have enough measurements
-    for (size_t i = 0; i < state_history_.at(0).yellow_robots.size(); i++) {
-        bool all_valid =
-            std::all_of(state_history_.begin(), state_history_.end(),
-                        [i](VisionState& v) { return v.yellow_robots.at(i).get_is_valid(); });
-
-        // If not all the robots of this specific id are valid
-        // check the next one
-        if (!all_valid) {
-            continue;
-        }
-
-        std::vector<WorldRobot> robot_list(state_history_.size());
-        for (size_t j = 0; j < state_history_.size(); j++) {
-            robot_list.at(j) = state_history_.at(j).yellow_robots.at(i);
-        }
-
-        // Valid kick robot
-        // Just take this and return a kick event
-        if (check_all_validators(robot_list, ball_list)) {
-            *kick_event = KickEvent(state_history_.at(0).calc_time,
-                                    state_history_.at(0).yellow_robots.at(i), state_history_);
-
-            return true;
-        }
-    }
-
-    // Check all robots if they have enough measurements
-    // Same as above, need a better way to do this
-    for (size_t i = 0; i < state_history_.at(0).blue_robots.size(); i++) {
-        bool all_valid =
-            std::all_of(state_history_.begin(), state_history_.end(),
-                        [i](VisionState& v) { return v.blue_robots.at(i).get_is_valid(); });
-
-        // If not all the robots of this specific id are valid
-        // check the next one
-        if (!all_valid) {
-            continue;
-        }
-
-        std::vector<WorldRobot> robot_list(state_history_.size());
-        for (size_t j = 0; j < state_history_.size(); j++) {
-            robot_list.at(j) = state_history_.at(j).blue_robots.at(i);
-        }
-
-        // Valid kick robot
-        // Just take this and return a kick event
-        if (check_all_validators(robot_list, ball_list)) {
-            *kick_event = KickEvent(state_history_.at(0).calc_time,
-                                    state_history_.at(0).blue_robots.at(i), state_history_);
-
-            return true;
+    for (WorldRobot::Team team : {WorldRobot::Team::YELLOW, WorldRobot::Team::BLUE}) {
+        for (size_t i = 0; i < kNumShells; i++) {
+            KickHistory::RobotTrack robot = history.robot_track(team, i, count);
+
+            // If not all the robots of this specific id are valid
+            // check the next one
+            if (!std::all_of(robot.valid, robot.valid + count, [](uint8_t v) { return v; })) {
+                continue;
+            }
+
+            // Valid kick robot
+            // Just take this and return a kick event
+            if (check_all_validators(robot, ball, count)) {
+                *kick_event = KickEvent(history, count, 0, team, static_cast<int>(i));
+
+                return true;
+            }
         }
     }
 
     return false;
 }
 
-bool SlowKickDetector::check_all_validators(const std::vector<WorldRobot>& robot,
-                                            const std::vector<WorldBall>& ball) {
-    return distance_validator(robot, ball) && velocity_validator(robot, ball) &&
-           distance_increasing_validator(robot, ball) && in_front_validator(robot, ball);
+bool SlowKickDetector::check_all_validators(const KickHistory::RobotTrack& robot,
+                                            const KickHistory::BallTrack& ball, size_t count) {
+    return distance_validator(robot, ball, count) && velocity_validator(robot, ball, count) &&
+           distance_increasing_validator(robot, ball, count) &&
+           in_front_validator(robot, ball, count);
 }
 
-bool SlowKickDetector::distance_validator(const std::vector<WorldRobot>& robot,
-                                          const std::vector<WorldBall>& ball) {
+bool SlowKickDetector::distance_validator(const KickHistory::RobotTrack& robot,
+                                          const KickHistory::BallTrack& ball, size_t count) {
     // Make sure the first one is very close
     // And all the others are not
     // and if one or more are past the far distance
+    int num_close = 0;
+    int num_far = 0;
 
-    // robot and ball are supposed to be the same size so this is ok
-    std::vector<double> dist(robot.size(), 0);
+    for (size_t i = 0; i < count; i++) {
+        double dist = (robot.pos[i] - ball.pos[i]).mag();
 
-    for (size_t i = 0; i < robot.size(); i++) {
-        dist.at(i) = (robot.at(i).get_pos() - ball.at(i).get_pos()).mag();
-    }
+        if (dist < PARAM_slow_one_robot_within_dist) {
+            num_close++;
+        }
 
-    int num_close = std::count_if(dist.begin(), dist.end(),
-                                  [](double i) { return i < PARAM_slow_one_robot_within_dist; });
-    int num_far = std::count_if(dist.begin(), dist.end(),
-                                [](double i) { return i > PARAM_slow_any_robot_past_dist; });
+        if (dist > PARAM_slow_any_robot_past_dist) {
+            num_far++;
+        }
+    }
 
     return num_close == 1 && num_far > 0;
 }
 
-bool SlowKickDetector::velocity_validator(const std::vector<WorldRobot>& /*robot*/,
-                                          const std::vector<WorldBall>& ball) {
+bool SlowKickDetector::velocity_validator(const KickHistory::RobotTrack& /*robot*/,
+                                          const KickHistory::BallTrack& ball, size_t count) {
     // Make sure all ball velocities are above a certain amount
+    for (size_t i = 0; i + 1 < count; i++) {
+        double vel = (ball.pos[i + 1] - ball.pos[i]).mag() / PARAM_vision_loop_dt;
 
-    std::vector<double> vel(ball.size() - 1, 0);
-
-    for (size_t i = 0; i < ball.size() - 1; i++) {
-        vel.at(i) = (ball.at(i + 1).get_pos() - ball.at(i).get_pos()).mag() / PARAM_vision_loop_dt;
+        if (vel <= PARAM_slow_min_ball_speed) {
+            return false;
+        }
     }
 
-    bool all_above =
-        std::all_of(vel.begin(), vel.end(), [](double i) { return i > PARAM_slow_min_ball_speed; });
-
-    return all_above;
+    return true;
 }
 
-bool SlowKickDetector::distance_increasing_validator(const std::vector<WorldRobot>& robot,
-                                                     const std::vector<WorldBall>& ball) {
+bool SlowKickDetector::distance_increasing_validator(const KickHistory::RobotTrack& robot,
+                                                     const KickHistory::BallTrack& ball,
+                                                     size_t count) {
     // Make sure derivative of position is positive
-
-    // robot and ball are the same size
-    for (size_t i = 0; i < robot.size() - 1; i++) {
-        double dist1 = (robot.at(i).get_pos() - ball.at(i).get_pos()).magsq();
-        double dist2 = (robot.at(i + 1).get_pos() - ball.at(i + 1).get_pos()).magsq();
+    for (size_t i = 0; i + 1 < count; i++) {
+        double dist1 = (robot.pos[i] - ball.pos[i]).magsq();
+        double dist2 = (robot.pos[i + 1] - ball.pos[i + 1]).magsq();
 
         if (dist2 - dist1 < 0) {
             return false;
@@ -174,16 +126,13 @@ bool SlowKickDetector::distance_increasing_validator(const std::vector<WorldRobo
     return true;
 }
 
-bool SlowKickDetector::in_front_validator(const std::vector<WorldRobot>& robot,
-                                          const std::vector<WorldBall>& ball) {
+bool SlowKickDetector::in_front_validator(const KickHistory::RobotTrack& robot,
+                                          const KickHistory::BallTrack& ball, size_t count) {
     // Make sure the ball is within a certain angle of the mouth
+    for (size_t i = 0; i < count; i++) {
+        rj_geometry::Point normal = rj_geometry::Point(cos(robot.theta[i]), sin(robot.theta[i]));
 
-    // robot and ball are the same
-    for (size_t i = 0; i < robot.size(); i++) {
-        rj_geometry::Point normal =
-            rj_geometry::Point(cos(robot.at(i).get_theta()), sin(robot.at(i).get_theta()));
-
-        rj_geometry::Point robot_to_ball = ball.at(i).get_pos() - robot.at(i).get_pos();
+        rj_geometry::Point robot_to_ball = ball.pos[i] - robot.pos[i];
 
         double angle = normal.angle_between(robot_to_ball);
 
@@ -194,4 +143,4 @@ bool SlowKickDetector::in_front_validator(const std::vector<WorldRobot>& robot,
 
     return true;
 }
-}  // namespace vision_filter
\ No newline at end of file
+}  // namespace vision_filter
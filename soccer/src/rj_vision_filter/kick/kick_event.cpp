@@ -1,19 +1,38 @@
 #include <rj_vision_filter/kick/kick_event.hpp>
 
 namespace vision_filter {
-void KickEvent::add_state(RJ::Time calc_time, const WorldBall& ball,
-                          const std::vector<WorldRobot>& yellow_robots,
-                          const std::vector<WorldRobot>& blue_robots) {
-    states_since_kick_.emplace_back(calc_time, ball, yellow_robots, blue_robots);
+KickEvent::KickEvent(const KickHistory& history, size_t count, size_t kick_idx,
+                     WorldRobot::Team kicking_team, int kicking_robot_id)
+    : is_valid_(true), kicking_team_(kicking_team), kicking_robot_id_(kicking_robot_id) {
+    KickHistory::BallTrack ball = history.ball_track(count);
+    kick_time_ = ball.time[kick_idx];
+
+    if (kicking_robot_id >= 0) {
+        KickHistory::RobotTrack robot = history.robot_track(kicking_team, kicking_robot_id, count);
+        kicking_robot_pose_ = rj_geometry::Pose(robot.pos[kick_idx], robot.theta[kick_idx]);
+    }
+
+    ball_since_kick_.reserve(count - kick_idx);
+    for (size_t i = kick_idx; i < count; i++) {
+        ball_since_kick_.push_back(BallSample{ball.time[i], ball.pos[i], ball.vel[i]});
+    }
+}
+
+void KickEvent::add_state(RJ::Time calc_time, const WorldBall& ball) {
+    ball_since_kick_.push_back(BallSample{calc_time, ball.get_pos(), ball.get_vel()});
 }
 
 bool KickEvent::get_is_valid() const { return is_valid_; }
 
 RJ::Time KickEvent::get_kick_time() const { return kick_time_; }
 
-WorldRobot KickEvent::get_kicking_robot() const { return kicking_robot_; }
+WorldRobot::Team KickEvent::get_kicking_team() const { return kicking_team_; }
+
+int KickEvent::get_kicking_robot_id() const { return kicking_robot_id_; }
+
+rj_geometry::Pose KickEvent::get_kicking_robot_pose() const { return kicking_robot_pose_; }
 
-const std::deque<VisionState>& KickEvent::get_states_since_kick() const {
-    return states_since_kick_;
+const std::vector<KickEvent::BallSample>& KickEvent::get_ball_since_kick() const {
+    return ball_since_kick_;
 }
-}  // namespace vision_filter
\ No newline at end of file
+}  // namespace vision_filter
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <rj_constants/constants.hpp>
+#include <rj_vision_filter/kick/kick_history.hpp>
+
+namespace vision_filter {
+namespace {
+// Both teams
+constexpr size_t kNumRobots = 2 * kNumShells;
+}  // namespace
+
+KickHistory::KickHistory(size_t capacity)
+    : capacity_(capacity),
+      time_(2 * capacity),
+      ball_valid_(2 * capacity),
+      ball_pos_(2 * capacity),
+      ball_vel_(2 * capacity),
+      robot_valid_(2 * capacity * kNumRobots),
+      robot_pos_(2 * capacity * kNumRobots),
+      robot_theta_(2 * capacity * kNumRobots),
+      robot_vel_(2 * capacity * kNumRobots) {}
+
+void KickHistory::add(RJ::Time calc_time, const WorldBall& ball,
+                      const std::vector<WorldRobot>& yellow_robots,
+                      const std::vector<WorldRobot>& blue_robots) {
+    if (capacity_ == 0) {
+        return;
+    }
+
+    // Write each sample to its slot and its mirror
+    for (size_t slot : {head_, head_ + capacity_}) {
+        time_[slot] = calc_time;
+        ball_valid_[slot] = ball.get_is_valid();
+        ball_pos_[slot] = ball.get_pos();
+        ball_vel_[slot] = ball.get_vel();
+
+        for (WorldRobot::Team team : {WorldRobot::Team::YELLOW, WorldRobot::Team::BLUE}) {
+            const std::vector<WorldRobot>& robots =
+                team == WorldRobot::Team::YELLOW ? yellow_robots : blue_robots;
+
+            for (size_t id = 0; id < kNumShells; id++) {
+                const size_t i = robot_offset(team, id) + slot;
+                const bool valid = id < robots.size() && robots[id].get_is_valid();
+
+                robot_valid_[i] = valid;
+                if (valid) {
+                    robot_pos_[i] = robots[id].get_pos();
+                    robot_theta_[i] = robots[id].get_theta();
+                    robot_vel_[i] = robots[id].get_vel();
+                }
+            }
+        }
+    }
+
+    head_ = (head_ + 1) % capacity_;
+    size_ = std::min(size_ + 1, capacity_);
+}
+
+KickHistory::BallTrack KickHistory::ball_track(size_t count) const {
+    const size_t i = start(count);
+    return BallTrack{&time_[i], &ball_valid_[i], &ball_pos_[i], &ball_vel_[i]};
+}
+
+KickHistory::RobotTrack KickHistory::robot_track(WorldRobot::Team team, size_t robot_id,
+                                                 size_t count) const {
+    const size_t i = robot_offset(team, robot_id) + start(count);
+    return RobotTrack{&robot_valid_[i], &robot_pos_[i], &robot_theta_[i], &robot_vel_[i]};
+}
+
+size_t KickHistory::start(size_t count) const {
+    if (count == 0 || count > size_) {
+        throw std::out_of_range("KickHistory: asked for more samples than it has");
+    }
+
+    // The newest sample is at head_ - 1 and its mirror at head_ + capacity_ - 1
+    return head_ + capacity_ - count;
+}
+
+size_t KickHistory::robot_offset(WorldRobot::Team team, size_t robot_id) const {
+    const size_t robot = (team == WorldRobot::Team::YELLOW ? 0 : kNumShells) + robot_id;
+    return robot * 2 * capacity_;
+}
+}  // namespace vision_filter
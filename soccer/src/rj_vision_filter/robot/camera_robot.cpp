@@ -22,7 +22,7 @@ int CameraRobot::get_robot_id() const { return robot_id_; }
 
 rj_geometry::Pose CameraRobot::get_pose() const { return pose_; }
 
-CameraRobot CameraRobot::combine_robots(const std::list<CameraRobot>& robots) {
+CameraRobot CameraRobot::combine_robots(const std::vector<CameraRobot>& robots) {
     // Make sure we don't divide by zero due to some weird error
     if (robots.empty()) {
         SPDLOG_ERROR("Number of robots to combine is zero");
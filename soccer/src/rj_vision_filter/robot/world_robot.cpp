@@ -15,7 +15,7 @@ using world_robot::PARAM_robot_merger_power;
 WorldRobot::WorldRobot() : is_valid_(false) {}
 
 WorldRobot::WorldRobot(RJ::Time calc_time, Team team, int robot_id,
-                       const std::list<KalmanRobot>& kalman_robots)
+                       const std::vector<KalmanRobot>& kalman_robots)
     : team_(team), robot_id_(robot_id), is_valid_(true), time_(calc_time) {
     // Theta's are converted to rect coords then back to polar to convert
     rj_geometry::Point pos_cartesian_avg;
@@ -113,7 +113,7 @@ double WorldRobot::get_pos_cov() const { return pos_cov_; }
 
 double WorldRobot::get_vel_cov() const { return vel_cov_; }
 
-const std::list<KalmanRobot>& WorldRobot::get_robot_components() const { return robot_components_; }
+const std::vector<KalmanRobot>& WorldRobot::get_robot_components() const { return robot_components_; }
 
 RJ::Time WorldRobot::get_time() const { return time_; }
 }  // namespace vision_filter
\ No newline at end of file
@@ -1,8 +1,12 @@
 
+#include <rclcpp_components/register_node_macro.hpp>
+
 #include <rj_common/time.hpp>
 #include <rj_constants/constants.hpp>
 #include <rj_constants/topic_names.hpp>
 #include <rj_msgs/msg/detection_frame.hpp>
+#include <rj_utils/intra_process.hpp>
+#include <rj_utils/latency_recorder.hpp>
 #include <rj_utils/logging_macros.hpp>
 #include <rj_vision_filter/params.hpp>
 #include <rj_vision_filter/vision_filter.hpp>
@@ -13,15 +17,28 @@ namespace vision_filter {
 DEFINE_FLOAT64(kVisionFilterParamModule, publish_hz, 60.0,
                "The rate in Hz at which VisionFilter publishes ball and robot "
                "observations.")
+DEFINE_FLOAT64(kVisionFilterParamModule, frame_batch_window, 0.005,
+               "Longest time in seconds to wait for the rest of the cameras before "
+               "updating the world with the frames we have. 0 updates on every frame.")
+DEFINE_FLOAT64(kVisionFilterParamModule, camera_timeout, 0.1,
+               "Stop waiting on a camera for a batch of frames when it hasn't sent a "
+               "frame for this long. In seconds.")
 
 VisionFilter::VisionFilter(const rclcpp::NodeOptions& options)
-    : rclcpp::Node{"vision_filter", options},
+    : rclcpp::Node{"vision_filter", rclcpp::NodeOptions{options}
+                                         .allow_undeclared_parameters(true)
+                                         .automatically_declare_parameters_from_overrides(true)},
       config_client_{this},
       team_color_queue_{this, referee::topics::kTeamColorTopic},
-      param_provider_{this, kVisionFilterParamModule} {
+      param_provider_{this, kVisionFilterParamModule},
+      frame_aggregator_{RJ::Seconds(PARAM_frame_batch_window), RJ::Seconds(PARAM_camera_timeout)} {
     // Create a timer that calls predict on all of the Kalman filters.
     const std::chrono::duration<double> predict_timer_period(PARAM_vision_loop_dt);
-    auto publish_callback = [this]() { publish_state(); };
+    auto publish_callback = [this]() {
+        // Don't sit on a partial batch if the missing cameras never show up
+        process_frames(RJ::now());
+        publish_state();
+    };
     publish_timer_ = create_wall_timer(predict_timer_period, publish_callback);
 
     // Create a subscriber for the DetectionFrameMsg
@@ -35,13 +52,34 @@ VisionFilter::VisionFilter(const rclcpp::NodeOptions& options)
         const double current_team_angle = team_angle();
         const rj_geometry::TransformMatrix current_world_to_team = world_to_team();
         auto frame = CameraFrame(*msg, current_world_to_team, current_team_angle);
-        world_.update_single_camera(RJ::now(), frame);
+        const RJ::Time now = RJ::now();
+        if (frame_aggregator_.add(std::move(frame), now)) {
+            rj_utils::LatencyRecorder::global().record(rj_utils::LatencyStage::kCaptureToReceive,
+                                                       msg->t_capture, msg->t_received);
+            pending_trace_.frame_id = (static_cast<uint64_t>(msg->camera_id) << 32) |
+                                      static_cast<uint64_t>(msg->frame_number);
+            pending_trace_.t_capture = msg->t_capture;
+            pending_trace_.t_received = msg->t_received;
+        }
+        process_frames(now);
     };
     detection_frame_sub_ = create_subscription<DetectionFrameMsg>(
-        vision_receiver::topics::kDetectionFrameTopic, rclcpp::QoS(kQueueSize), callback);
+        vision_receiver::topics::kDetectionFrameTopic, rclcpp::QoS(kQueueSize), callback,
+        rj_utils::intra_process_subscription_options());
 
     // Create publishers.
-    world_state_pub_ = create_publisher<WorldStateMsg>(topics::kWorldStateTopic, 10);
+    world_state_pub_ = create_publisher<WorldStateMsg>(topics::kWorldStateTopic, 10,
+                                                       rj_utils::intra_process_publisher_options());
+}
+
+void VisionFilter::process_frames(RJ::Time now) {
+    if (!frame_aggregator_.ready(now)) {
+        return;
+    }
+
+    frame_aggregator_.take(&frame_batch_);
+    world_.update_with_camera_frame(now, frame_batch_, false);
+    trace_ = pending_trace_;
 }
 
 VisionFilter::WorldStateMsg VisionFilter::build_world_state_msg(bool us_blue) const {
@@ -49,7 +87,8 @@ VisionFilter::WorldStateMsg VisionFilter::build_world_state_msg(bool us_blue) co
         .last_update_time(rj_convert::convert_to_ros(world_.last_update_time()))
         .their_robots(build_robot_state_msgs(!us_blue))
         .our_robots(build_robot_state_msgs(us_blue))
-        .ball(build_ball_state_msg());
+        .ball(build_ball_state_msg())
+        .trace(trace_);
 }
 
 VisionFilter::BallStateMsg VisionFilter::build_ball_state_msg() const {
@@ -95,7 +134,17 @@ void VisionFilter::publish_state() {
 
     WorldStateMsg::UniquePtr msg = std::make_unique<WorldStateMsg>();
     *msg = build_world_state_msg(team_color->is_blue);
+    msg->trace.t_filtered = rj_convert::convert_to_ros(RJ::now());
+
+    if (trace_.frame_id != last_traced_frame_id_) {
+        rj_utils::LatencyRecorder::global().record(rj_utils::LatencyStage::kReceiveToFilter,
+                                                   msg->trace.t_received, msg->trace.t_filtered);
+        last_traced_frame_id_ = trace_.frame_id;
+    }
+
     world_state_pub_->publish(std::move(msg));
 }
 
 }  // namespace vision_filter
+
+RCLCPP_COMPONENTS_REGISTER_NODE(vision_filter::VisionFilter)
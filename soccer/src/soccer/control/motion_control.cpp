@@ -5,9 +5,12 @@
 #include <context.hpp>
 #include <rj_common/utils.hpp>
 #include <rj_geometry/util.hpp>
+#include <rj_utils/intra_process.hpp>
+#include <rj_utils/latency_recorder.hpp>
 #include <rj_utils/logging.hpp>
 
 #include "planning/instant.hpp"
+#include "world_state_cache.hpp"
 
 namespace control {
 
@@ -45,28 +48,41 @@ MotionControl::MotionControl(int shell_id, rclcpp::Node* node)
           node->create_publisher<rj_drawing_msgs::msg::DebugDraw>(viz::topics::kDebugDrawTopic, 10),
           fmt::format("motion_control/{}", std::to_string(shell_id))) {
     motion_setpoint_pub_ = node->create_publisher<MotionSetpoint::Msg>(
-        topics::motion_setpoint_topic(shell_id_), rclcpp::QoS(1));
+        topics::motion_setpoint_topic(shell_id_), rclcpp::QoS(1),
+        rj_utils::intra_process_publisher_options());
     target_state_pub_ = node->create_publisher<RobotState::Msg>(
         topics::desired_state_topic(shell_id_), rclcpp::QoS(1));
     // Update motion control triggered on world state publish.
     trajectory_sub_ = node->create_subscription<planning::Trajectory::Msg>(
         planning::topics::trajectory_topic(shell_id), rclcpp::QoS(1),
-        [this](planning::Trajectory::Msg::SharedPtr trajectory) {  // NOLINT
+        [this](planning::Trajectory::Msg::ConstSharedPtr trajectory) {  // NOLINT
             trajectory_ = rj_convert::convert_from_ros(*trajectory);
-        });
+            trajectory_trace_ = trajectory->trace;
+        },
+        rj_utils::intra_process_subscription_options());
     world_state_sub_ = node->create_subscription<WorldState::Msg>(
         vision_filter::topics::kWorldStateTopic, rclcpp::QoS(1),
-        [this](WorldState::Msg::SharedPtr world_state_msg) {  // NOLINT
-            RobotState state =
-                rj_convert::convert_from_ros(world_state_msg->our_robots.at(shell_id_));
+        [this](WorldState::Msg::ConstSharedPtr world_state_msg) {  // NOLINT
+            const RobotStateView state =
+                WorldStateCache::global().our_robot(*world_state_msg, shell_id_);
 
             // TODO(Kyle): Handle the joystick-controlled case here. In the long run we want to
             // convert this to an action. Should we do that now?
             bool is_joystick_controlled = false;
             MotionSetpoint setpoint;
-            run(state, trajectory_, play_state_, is_joystick_controlled, &setpoint);
-            motion_setpoint_pub_->publish(rj_convert::convert_to_ros(setpoint));
-        });
+            run(*state, trajectory_, play_state_, is_joystick_controlled, &setpoint);
+
+            auto setpoint_msg =
+                std::make_unique<MotionSetpoint::Msg>(rj_convert::convert_to_ros(setpoint));
+            setpoint_msg->trace = world_state_msg->trace;
+            setpoint_msg->trace.t_planned = trajectory_trace_.t_planned;
+            setpoint_msg->trace.t_controlled = rj_convert::convert_to_ros(RJ::now());
+            rj_utils::LatencyRecorder::global().record(rj_utils::LatencyStage::kFilterToControl,
+                                                       setpoint_msg->trace.t_filtered,
+                                                       setpoint_msg->trace.t_controlled);
+            motion_setpoint_pub_->publish(std::move(setpoint_msg));
+        },
+        rj_utils::intra_process_subscription_options());
     play_state_sub_ = node->create_subscription<PlayState::Msg>(
         referee::topics::kPlayStateTopic, rclcpp::QoS(1).transient_local(),
         [this](PlayState::Msg::SharedPtr play_state_msg) {  // NOLINT
@@ -88,6 +88,8 @@ private:
     PlayState::State play_state_ = PlayState::State::Halt;
 
     planning::Trajectory trajectory_;
+    // Trace of the trajectory we're following, to stamp when it was planned
+    rj_msgs::msg::FrameTrace trajectory_trace_;
 
     rclcpp::Subscription<planning::Trajectory::Msg>::SharedPtr trajectory_sub_;
     rclcpp::Subscription<WorldState::Msg>::SharedPtr world_state_sub_;
@@ -1,9 +1,11 @@
 #include "motion_control_node.hpp"
 
+#include <rclcpp_components/register_node_macro.hpp>
+
 namespace control {
 
-MotionControlNode::MotionControlNode()
-    : rclcpp::Node("control", rclcpp::NodeOptions{}
+MotionControlNode::MotionControlNode(const rclcpp::NodeOptions& options)
+    : rclcpp::Node("control", rclcpp::NodeOptions{options}
                                   .automatically_declare_parameters_from_overrides(true)
                                   .allow_undeclared_parameters(true)),
       param_provider_(this, params::kMotionControlParamModule) {
@@ -16,4 +18,6 @@ MotionControlNode::MotionControlNode()
     }
 }
 
-}  // namespace control
\ No newline at end of file
+}  // namespace control
+
+RCLCPP_COMPONENTS_REGISTER_NODE(control::MotionControlNode)
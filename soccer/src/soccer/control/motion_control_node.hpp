@@ -19,7 +19,7 @@ namespace control {
  */
 class MotionControlNode : public rclcpp::Node {
 public:
-    explicit MotionControlNode();
+    explicit MotionControlNode(const rclcpp::NodeOptions& options = rclcpp::NodeOptions{});
 
 private:
     ::params::LocalROS2ParamProvider param_provider_;
@@ -33,7 +33,8 @@ struct RosConverter<MotionSetpoint, MotionSetpoint::Msg> {
         return rj_msgs::build<MotionSetpoint::Msg>()
             .velocity_x_mps(from.xvelocity)
             .velocity_y_mps(from.yvelocity)
-            .velocity_z_radps(from.avelocity);
+            .velocity_z_radps(from.avelocity)
+            .trace(rj_msgs::msg::FrameTrace{});
     }
 
     static MotionSetpoint from_ros(const MotionSetpoint::Msg& from) {
@@ -1,5 +1,9 @@
 #include <global_params.hpp>
 
+#include <rclcpp_components/register_node_macro.hpp>
+
+#include <rj_utils/logging.hpp>
+
 DEFINE_BOOL(kGlobalParamModule, use_sim_time, false, "Use sim time.")
 DEFINE_NS_FLOAT64(kGlobalParamModule, soccer::physics, ball_decay_constant, 0.180,
                   "Ball decay constant.")
@@ -19,6 +23,9 @@ DEFINE_NS_FLOAT64(kGlobalParamModule, soccer::robot, max_chip_speed, 7.0,
 DEFINE_NS_FLOAT64(kGlobalParamModule, soccer::robot, robot_radius, 0.09, "Robot radius, m")
 DEFINE_NS_INT64(kGlobalParamModule, soccer::robot, min_safe_kick_power, 64,
                 "Minimum safe discharge power for the kicker (0-255)");
+DEFINE_NS_INT64(kGlobalParamModule, soccer::logs, history_memory_mb, 512,
+                "Roughly how much memory the soccer UI may use for log history, MiB. "
+                "Frames the UI is currently showing come on top of this.");
 
 void start_global_param_provider(rclcpp::Node* node, const std::string& global_param_server) {
     static std::unique_ptr<params::ROS2GlobalParamProvider> provider;
@@ -37,4 +44,14 @@ void start_global_param_provider(const std::string& program_id,
     gpp_thread = std::make_unique<std::thread>([]() { rclcpp::spin(node); });
 }
 
+GlobalParamReceiver::GlobalParamReceiver(const rclcpp::NodeOptions& options)
+    : rclcpp::Node("global_param_receiver", options) {
+    // This is the one node per container, so do the per-process setup the
+    // standalone nodes do in main()
+    rj_utils::set_spdlog_default_ros2("processor");
+    start_global_param_provider(this, kGlobalParamServerNode);
+}
+
 void global_params_server_dummy_function() {}
+
+RCLCPP_COMPONENTS_REGISTER_NODE(GlobalParamReceiver)
@@ -21,12 +21,23 @@ DECLARE_NS_FLOAT64(kGlobalParamModule, soccer::robot, min_chip_speed)
 DECLARE_NS_FLOAT64(kGlobalParamModule, soccer::robot, max_chip_speed)
 DECLARE_NS_INT64(kGlobalParamModule, soccer::robot, min_safe_kick_power)
 DECLARE_NS_FLOAT64(kGlobalParamModule, soccer::robot, robot_radius)
+DECLARE_NS_INT64(kGlobalParamModule, soccer::logs, history_memory_mb)
 
 void start_global_param_provider(rclcpp::Node* node, const std::string& global_param_server);
 
 void start_global_param_provider(const std::string& program_id,
                                  const std::string& global_param_server);
 
+/**
+ * Receives the global params for a component container. Every node loaded
+ * into the container shares these, so load this once in place of calling
+ * start_global_param_provider() from each node's main().
+ */
+class GlobalParamReceiver : public rclcpp::Node {
+public:
+    explicit GlobalParamReceiver(const rclcpp::NodeOptions& options);
+};
+
 /**
  * Call this function to guarantee that all of the static variables will be initialized.
  * This is a horrible hack.
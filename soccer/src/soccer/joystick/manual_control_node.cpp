@@ -106,7 +106,8 @@ void ManualControlNode::publish(int robot_id, const ControllerCommand& command)
     motion_setpoint_pubs_.at(robot_id)->publish(rj_msgs::build<rj_msgs::msg::MotionSetpoint>()
                                                     .velocity_x_mps(command.translation.x())
                                                     .velocity_y_mps(command.translation.y())
-                                                    .velocity_z_radps(command.rotation));
+                                                    .velocity_z_radps(command.rotation)
+                                                    .trace(rj_msgs::msg::FrameTrace{}));
     uint8_t trigger_mode = PARAM_kick_on_break_beam
                                ? rj_msgs::msg::ManipulatorSetpoint::TRIGGER_MODE_ON_BREAK_BEAM
                                : rj_msgs::msg::ManipulatorSetpoint::TRIGGER_MODE_IMMEDIATE;
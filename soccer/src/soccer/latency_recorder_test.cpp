@@ -0,0 +1,79 @@
+#include <rj_utils/latency_recorder.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using rj_utils::LatencyRecorder;
+using rj_utils::LatencyStage;
+
+TEST(LatencyRecorder, Summary) {
+    LatencyRecorder recorder;
+
+    // 99 fast frames and one slow one, recorded from several threads at once
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&recorder]() {
+            for (int i = 0; i < 99; i++) {
+                recorder.record(LatencyStage::kEndToEnd, std::chrono::microseconds(5050));
+            }
+            recorder.record(LatencyStage::kEndToEnd, std::chrono::milliseconds(12));
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    LatencyRecorder::Summary summary = recorder.summary(LatencyStage::kEndToEnd);
+    EXPECT_EQ(summary.count, 400);
+    EXPECT_NEAR(summary.mean_ms, (99 * 5.05 + 12) / 100, 1e-6);
+    EXPECT_NEAR(summary.max_ms, 12, 1e-6);
+    EXPECT_NEAR(summary.p50_ms, 5.1, 1e-6);
+    EXPECT_NEAR(summary.p99_ms, 5.1, 1e-6);
+
+    // Other stages are untouched
+    EXPECT_EQ(recorder.summary(LatencyStage::kFilterToPlan).count, 0);
+}
+
+TEST(LatencyRecorder, TraceStamps) {
+    LatencyRecorder recorder;
+
+    builtin_interfaces::msg::Time start;
+    start.sec = 100;
+    start.nanosec = 999'000'000;
+    builtin_interfaces::msg::Time end;
+    end.sec = 101;
+    end.nanosec = 1'000'000;
+
+    recorder.record(LatencyStage::kFilterToControl, start, end);
+
+    // Untraced messages leave the start at zero, and shouldn't be counted
+    recorder.record(LatencyStage::kFilterToControl, builtin_interfaces::msg::Time{}, end);
+
+    // Clock skew shows up as zero latency rather than wrapping around
+    recorder.record(LatencyStage::kFilterToControl, end, start);
+
+    LatencyRecorder::Summary summary = recorder.summary(LatencyStage::kFilterToControl);
+    EXPECT_EQ(summary.count, 2);
+    EXPECT_NEAR(summary.max_ms, 2, 1e-6);
+
+    std::ostringstream csv;
+    recorder.write_csv(csv);
+    EXPECT_EQ(csv.str(),
+              "stage,bucket_end_ms,count\n"
+              "filter_to_control,0.1,1\n"
+              "filter_to_control,2.1,1\n");
+}
+
+// Buckets past the end of the histogram all land in the last one
+TEST(LatencyRecorder, Overflow) {
+    LatencyRecorder recorder;
+    recorder.record(LatencyStage::kCaptureToReceive, std::chrono::seconds(10));
+
+    LatencyRecorder::Summary summary = recorder.summary(LatencyStage::kCaptureToReceive);
+    EXPECT_EQ(summary.count, 1);
+    EXPECT_NEAR(summary.max_ms, 10000, 1e-6);
+    EXPECT_NEAR(summary.p99_ms, 25.6, 1e-6);
+}
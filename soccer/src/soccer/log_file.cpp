@@ -0,0 +1,202 @@
+#include "log_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+using google::protobuf::internal::WireFormatLite;
+
+/**
+ * Reads a frame's size prefix at the start of data.
+ *
+ * \return false if the prefix or the frame runs past the end of the data.
+ */
+bool read_frame_extent(const uint8_t* data, size_t available, size_t* header_size,
+                       size_t* frame_size) {
+    google::protobuf::io::CodedInputStream input(
+        data, static_cast<int>(std::min<size_t>(available, INT_MAX)));
+    uint32_t size = 0;
+    if (!input.ReadVarint32(&size)) {
+        return false;
+    }
+    *header_size = input.CurrentPosition();
+    *frame_size = size;
+    return *header_size + *frame_size <= available;
+}
+
+/**
+ * Pulls LogFrame::timestamp out of an encoded frame, skipping over everything
+ * else without decoding it.
+ */
+int64_t read_timestamp(const uint8_t* data, size_t size) {
+    google::protobuf::io::CodedInputStream input(data, static_cast<int>(size));
+    uint32_t tag = 0;
+    while ((tag = input.ReadTag()) != 0) {
+        if (WireFormatLite::GetTagFieldNumber(tag) == Packet::LogFrame::kTimestampFieldNumber &&
+            WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_VARINT) {
+            uint64_t timestamp = 0;
+            return input.ReadVarint64(&timestamp) ? static_cast<int64_t>(timestamp) : 0;
+        }
+        if (!WireFormatLite::SkipField(&input, tag)) {
+            break;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+std::shared_ptr<LogFile> LogFile::open(const std::string& filename) {
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SPDLOG_ERROR("Failed to open log file {}: {}", filename, std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0) {
+        SPDLOG_ERROR("Failed to stat log file {}: {}", filename, std::strerror(errno));
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<LogFile> file{new LogFile()};
+    file->file_size_ = static_cast<size_t>(file_stat.st_size);
+    if (file->file_size_ > 0) {
+        void* mapping = mmap(nullptr, file->file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            SPDLOG_ERROR("Failed to map log file {}: {}", filename, std::strerror(errno));
+            ::close(fd);
+            return nullptr;
+        }
+        file->mapping_ = mapping;
+        file->data_ = static_cast<const uint8_t*>(mapping);
+        file->data_size_ = file->file_size_;
+    }
+    // The mapping keeps the file open.
+    ::close(fd);
+
+    const bool compressed =
+        file->data_size_ >= 2 && file->data_[0] == 0x1f && file->data_[1] == 0x8b;
+    if (compressed) {
+        // There's no seeking in a gzip stream, so inflate the whole thing.
+        google::protobuf::io::ArrayInputStream raw(file->data_,
+                                                   static_cast<int>(file->data_size_));
+        google::protobuf::io::GzipInputStream gzip(&raw);
+        const void* chunk = nullptr;
+        int chunk_size = 0;
+        while (gzip.Next(&chunk, &chunk_size)) {
+            file->inflated_.append(static_cast<const char*>(chunk), chunk_size);
+        }
+
+        munmap(file->mapping_, file->file_size_);
+        file->mapping_ = nullptr;
+        file->data_ = reinterpret_cast<const uint8_t*>(file->inflated_.data());
+        file->data_size_ = file->inflated_.size();
+    }
+
+    file->indexed_ = !compressed && file->read_index();
+    if (!file->indexed_) {
+        file->scan();
+    }
+    file->decoded_.resize(file->index_.size());
+
+    return file;
+}
+
+LogFile::~LogFile() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, file_size_);
+    }
+}
+
+size_t LogFile::find(int64_t timestamp) const {
+    auto it = std::lower_bound(
+        index_.begin(), index_.end(), timestamp,
+        [](const IndexEntry& entry, int64_t value) { return entry.timestamp < value; });
+    return it - index_.begin();
+}
+
+std::shared_ptr<Packet::LogFrame> LogFile::frame(size_t index) const {
+    const IndexEntry& entry = index_.at(index);
+
+    std::lock_guard lock{mutex_};
+    std::shared_ptr<Packet::LogFrame> frame = decoded_[index].lock();
+    if (frame != nullptr) {
+        return frame;
+    }
+
+    frame = std::make_shared<Packet::LogFrame>();
+
+    size_t header_size = 0;
+    size_t frame_size = 0;
+    // Parse partial so we can recover from corrupt data
+    if (entry.offset >= data_size_ ||
+        !read_frame_extent(data_ + entry.offset, data_size_ - entry.offset, &header_size,
+                           &frame_size) ||
+        !frame->ParsePartialFromArray(data_ + entry.offset + header_size,
+                                      static_cast<int>(frame_size))) {
+        SPDLOG_WARN("Log frame {} is corrupt", index);
+        frame->Clear();
+        frame->set_timestamp(entry.timestamp);
+    }
+
+    decoded_[index] = frame;
+    return frame;
+}
+
+bool LogFile::read_index() {
+    Footer footer{};
+    if (data_size_ < sizeof(footer)) {
+        return false;
+    }
+    std::memcpy(&footer, data_ + data_size_ - sizeof(footer), sizeof(footer));
+
+    const size_t index_size = footer.num_frames * sizeof(IndexEntry);
+    if (footer.magic != kFooterMagic || footer.index_offset > data_size_ ||
+        footer.num_frames > data_size_ / sizeof(IndexEntry) ||
+        footer.index_offset + index_size + sizeof(footer) != data_size_) {
+        return false;
+    }
+
+    index_.resize(footer.num_frames);
+    std::memcpy(index_.data(), data_ + footer.index_offset, index_size);
+
+    // Only ever look for frames in front of the index.
+    data_size_ = footer.index_offset;
+    return true;
+}
+
+void LogFile::scan() {
+    index_.clear();
+
+    size_t offset = 0;
+    while (offset < data_size_) {
+        size_t header_size = 0;
+        size_t frame_size = 0;
+        if (!read_frame_extent(data_ + offset, data_size_ - offset, &header_size,
+                               &frame_size)) {
+            SPDLOG_WARN("Log ends with a partial frame; ignoring the last {} bytes",
+                        data_size_ - offset);
+            break;
+        }
+
+        const int64_t timestamp = read_timestamp(data_ + offset + header_size, frame_size);
+        index_.push_back(IndexEntry{timestamp, offset});
+        offset += header_size + frame_size;
+    }
+}
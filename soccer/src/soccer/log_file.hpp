@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <rj_protos/LogFrame.pb.h>
+
+/**
+ * \brief A log file opened for random access.
+ *
+ * The file is memory-mapped and frames are only decoded when asked for, so
+ * opening a long match is quick and only the frames someone is holding on to
+ * take up memory.
+ *
+ * Log files are a sequence of size-delimited LogFrames. LogWriter follows the
+ * frames with an index and a footer:
+ *
+ *     frame 0 | frame 1 | ... | IndexEntry[num_frames] | Footer
+ *
+ * so a file cut short (say, by a crash) is still a plain sequence of frames.
+ * Files with no footer (older logs, or cut short) and gzip-compressed logs are
+ * still readable: they are scanned once when opened to build the index, which
+ * only reads each frame's size and timestamp.
+ */
+class LogFile {
+public:
+    /**
+     * \brief One frame's entry in the index.
+     */
+    struct IndexEntry {
+        // LogFrame::timestamp, in microseconds since the epoch
+        int64_t timestamp;
+        // Offset of the frame's size prefix from the start of the file
+        uint64_t offset;
+    };
+
+    /**
+     * \brief The last bytes of an indexed log. Stored in host byte order.
+     */
+    struct Footer {
+        uint64_t index_offset;
+        uint64_t num_frames;
+        uint64_t magic;
+    };
+
+    // "RJLOGIDX"
+    static constexpr uint64_t kFooterMagic = 0x584449474f4c4a52;
+
+    /**
+     * \brief Open and index a log file.
+     *
+     * \return nullptr if the file couldn't be opened.
+     */
+    static std::shared_ptr<LogFile> open(const std::string& filename);
+
+    ~LogFile();
+
+    LogFile(const LogFile&) = delete;
+    LogFile& operator=(const LogFile&) = delete;
+    LogFile(LogFile&&) = delete;
+    LogFile& operator=(LogFile&&) = delete;
+
+    [[nodiscard]] size_t size() const { return index_.size(); }
+
+    [[nodiscard]] bool empty() const { return index_.empty(); }
+
+    /**
+     * \brief Whether the file had an index, rather than being scanned.
+     */
+    [[nodiscard]] bool indexed() const { return indexed_; }
+
+    /**
+     * \brief Size of the file on disk.
+     */
+    [[nodiscard]] size_t size_bytes() const { return file_size_; }
+
+    /**
+     * \brief The timestamp of a frame, without decoding it.
+     */
+    [[nodiscard]] int64_t timestamp(size_t index) const { return index_.at(index).timestamp; }
+
+    /**
+     * \brief Index of the first frame at or after the given timestamp, or
+     * size() if there is none.
+     */
+    [[nodiscard]] size_t find(int64_t timestamp) const;
+
+    /**
+     * \brief Decode a frame.
+     *
+     * Frames are shared rather than decoded again while anything still holds
+     * them. Thread-safe.
+     *
+     * \return The frame, or an empty one with just the timestamp if it's
+     * corrupt.
+     */
+    [[nodiscard]] std::shared_ptr<Packet::LogFrame> frame(size_t index) const;
+
+private:
+    LogFile() = default;
+
+    bool read_index();
+    void scan();
+
+    void* mapping_ = nullptr;
+    size_t file_size_ = 0;
+
+    // Either the mapping, or inflated_ for compressed logs.
+    const uint8_t* data_ = nullptr;
+    size_t data_size_ = 0;
+    std::string inflated_;
+
+    std::vector<IndexEntry> index_;
+    bool indexed_ = false;
+
+    mutable std::mutex mutex_;
+    mutable std::vector<std::weak_ptr<Packet::LogFrame>> decoded_;
+};
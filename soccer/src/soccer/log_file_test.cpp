@@ -0,0 +1,117 @@
+#include <filesystem>
+#include <fstream>
+
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <gtest/gtest.h>
+
+#include "log_file.hpp"
+#include "log_writer.hpp"
+
+namespace {
+
+std::shared_ptr<Packet::LogFrame> make_frame(int64_t timestamp) {
+    auto frame = std::make_shared<Packet::LogFrame>();
+    frame->set_timestamp(timestamp);
+    frame->set_command_time(timestamp + 1);
+    frame->add_debug_layers("layer");
+    return frame;
+}
+
+std::string temp_path(const std::string& filename) {
+    return (std::filesystem::temp_directory_path() / filename).string();
+}
+
+// Frames 0..num_frames-1 with timestamps 100, 110, ...
+void write_log(const std::string& path, int num_frames) {
+    LogWriter writer{path};
+    for (int i = 0; i < num_frames; i++) {
+        writer.push(make_frame(100 + 10 * i));
+    }
+}
+
+// The same frames, as the logger wrote them before logs had an index.
+void write_unindexed_log(const std::string& path, int num_frames) {
+    std::ofstream out{path, std::ios::binary};
+    google::protobuf::io::OstreamOutputStream output{&out};
+    for (int i = 0; i < num_frames; i++) {
+        write_delimited_to(*make_frame(100 + 10 * i), &output);
+    }
+}
+
+void check_frames(const LogFile& file, size_t num_frames) {
+    ASSERT_EQ(file.size(), num_frames);
+    for (size_t i = 0; i < num_frames; i++) {
+        EXPECT_EQ(file.timestamp(i), static_cast<int64_t>(100 + 10 * i));
+        std::shared_ptr<Packet::LogFrame> frame = file.frame(i);
+        ASSERT_NE(frame, nullptr);
+        EXPECT_EQ(frame->timestamp(), 100 + 10 * i);
+        EXPECT_EQ(frame->command_time(), 101 + 10 * i);
+    }
+
+    EXPECT_EQ(file.find(0), 0u);
+    EXPECT_EQ(file.find(110), 1u);
+    EXPECT_EQ(file.find(115), 2u);
+    EXPECT_EQ(file.find(100000), file.size());
+}
+
+}  // namespace
+
+TEST(LogFile, ReadsIndexedLog) {
+    const std::string path = temp_path("log_file_test_indexed.log");
+    write_log(path, 50);
+
+    std::shared_ptr<LogFile> file = LogFile::open(path);
+    std::filesystem::remove(path);
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(file->indexed());
+    check_frames(*file, 50);
+}
+
+TEST(LogFile, ScansUnindexedLog) {
+    const std::string path = temp_path("log_file_test_unindexed.log");
+    write_unindexed_log(path, 50);
+
+    std::shared_ptr<LogFile> file = LogFile::open(path);
+    std::filesystem::remove(path);
+    ASSERT_NE(file, nullptr);
+    EXPECT_FALSE(file->indexed());
+    check_frames(*file, 50);
+}
+
+TEST(LogFile, ScansCompressedLog) {
+    const std::string path = temp_path("log_file_test.log.gz");
+    write_log(path, 50);
+
+    std::shared_ptr<LogFile> file = LogFile::open(path);
+    std::filesystem::remove(path);
+    ASSERT_NE(file, nullptr);
+    EXPECT_FALSE(file->indexed());
+    check_frames(*file, 50);
+}
+
+TEST(LogFile, IgnoresPartialLastFrame) {
+    const std::string path = temp_path("log_file_test_truncated.log");
+    write_unindexed_log(path, 10);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    std::shared_ptr<LogFile> file = LogFile::open(path);
+    std::filesystem::remove(path);
+    ASSERT_NE(file, nullptr);
+    check_frames(*file, 9);
+}
+
+TEST(LogFile, SharesDecodedFrames) {
+    const std::string path = temp_path("log_file_test_shared.log");
+    write_log(path, 5);
+
+    std::shared_ptr<LogFile> file = LogFile::open(path);
+    std::filesystem::remove(path);
+    ASSERT_NE(file, nullptr);
+
+    std::shared_ptr<Packet::LogFrame> frame = file->frame(3);
+    EXPECT_EQ(file->frame(3), frame);
+}
+
+TEST(LogFile, MissingFile) {
+    EXPECT_EQ(LogFile::open(temp_path("log_file_test_missing.log")), nullptr);
+}
@@ -0,0 +1,211 @@
+#include "log_history.hpp"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "log_writer.hpp"
+
+LogHistory::LogHistory(const LogHistory& other)
+    : memory_limit_{other.memory_limit_},
+      blocks_{other.blocks_},
+      packed_frames_{other.packed_frames_},
+      packed_bytes_{other.packed_bytes_},
+      recent_{other.recent_},
+      recent_sizes_{other.recent_sizes_},
+      recent_bytes_{other.recent_bytes_},
+      dropped_{other.dropped_} {}
+
+LogHistory& LogHistory::operator=(const LogHistory& other) {
+    if (this != &other) {
+        LogHistory copy{other};
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+LogHistory::LogHistory(LogHistory&& other) noexcept
+    : memory_limit_{other.memory_limit_},
+      blocks_{std::move(other.blocks_)},
+      packed_frames_{other.packed_frames_},
+      packed_bytes_{other.packed_bytes_},
+      recent_{std::move(other.recent_)},
+      recent_sizes_{std::move(other.recent_sizes_)},
+      recent_bytes_{other.recent_bytes_},
+      dropped_{other.dropped_} {
+    other.clear();
+}
+
+LogHistory& LogHistory::operator=(LogHistory&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    memory_limit_ = other.memory_limit_;
+    blocks_ = std::move(other.blocks_);
+    packed_frames_ = other.packed_frames_;
+    packed_bytes_ = other.packed_bytes_;
+    recent_ = std::move(other.recent_);
+    recent_sizes_ = std::move(other.recent_sizes_);
+    recent_bytes_ = other.recent_bytes_;
+    dropped_ = other.dropped_;
+    other.clear();
+
+    std::lock_guard lock{unpacked_mutex_};
+    unpacked_.clear();
+    unpacked_bytes_ = 0;
+    return *this;
+}
+
+void LogHistory::push_back(std::shared_ptr<Packet::LogFrame> frame) {
+    // Much cheaper than SpaceUsedLong(), and this runs on the Processor thread
+    // every frame.
+    const size_t frame_size = frame->ByteSizeLong();
+    recent_.emplace_back(std::move(frame));
+    recent_sizes_.push_back(frame_size);
+    recent_bytes_ += frame_size;
+
+    // Pack a whole block at a time, once there's a block's worth of frames
+    // past the recent ones.
+    if (recent_.size() >= kRecentFrames + kBlockFrames) {
+        pack_oldest_block();
+    }
+
+    enforce_memory_limit();
+}
+
+std::shared_ptr<Packet::LogFrame> LogHistory::at(size_t index) const {
+    if (index >= packed_frames_) {
+        return recent_.at(index - packed_frames_);
+    }
+
+    const std::shared_ptr<const Block>& block = blocks_.at(index / kBlockFrames);
+
+    std::lock_guard lock{unpacked_mutex_};
+    auto it = std::find_if(unpacked_.begin(), unpacked_.end(),
+                           [&](const UnpackedBlock& unpacked) { return unpacked.block == block; });
+    if (it == unpacked_.end()) {
+        UnpackedBlock unpacked{block, {}, 0};
+        unpacked.frames = unpack(*block, &unpacked.bytes);
+        unpacked_bytes_ += unpacked.bytes;
+        unpacked_.push_back(std::move(unpacked));
+        if (unpacked_.size() > kUnpackedBlocks) {
+            unpacked_bytes_ -= unpacked_.front().bytes;
+            unpacked_.pop_front();
+        }
+        shrink_unpacked(1);
+        it = std::prev(unpacked_.end());
+    }
+    return it->frames.at(index % kBlockFrames);
+}
+
+size_t LogHistory::memory_usage() const {
+    std::lock_guard lock{unpacked_mutex_};
+    return recent_bytes_ + packed_bytes_ + unpacked_bytes_;
+}
+
+void LogHistory::shrink_unpacked(size_t keep) const {
+    while (unpacked_.size() > keep &&
+           recent_bytes_ + packed_bytes_ + unpacked_bytes_ > memory_limit_) {
+        unpacked_bytes_ -= unpacked_.front().bytes;
+        unpacked_.pop_front();
+    }
+}
+
+void LogHistory::clear() {
+    {
+        std::lock_guard lock{unpacked_mutex_};
+        unpacked_.clear();
+        unpacked_bytes_ = 0;
+    }
+    blocks_.clear();
+    packed_frames_ = 0;
+    packed_bytes_ = 0;
+    recent_.clear();
+    recent_sizes_.clear();
+    recent_bytes_ = 0;
+    dropped_ = 0;
+}
+
+void LogHistory::pack_oldest_block() {
+    auto block = std::make_shared<Block>();
+    {
+        google::protobuf::io::StringOutputStream raw{&block->data};
+        google::protobuf::io::GzipOutputStream::Options options;
+        options.format = google::protobuf::io::GzipOutputStream::ZLIB;
+        // This runs on the Processor thread, so favor speed over size.
+        options.compression_level = 1;
+        google::protobuf::io::GzipOutputStream deflate{&raw, options};
+        for (size_t i = 0; i < kBlockFrames; i++) {
+            write_delimited_to(*recent_.front(), &deflate);
+            recent_.pop_front();
+            recent_bytes_ -= recent_sizes_.front();
+            recent_sizes_.pop_front();
+        }
+        deflate.Close();
+    }
+    block->data.shrink_to_fit();
+
+    packed_bytes_ += block->data.size();
+    packed_frames_ += kBlockFrames;
+    blocks_.emplace_back(std::move(block));
+}
+
+void LogHistory::enforce_memory_limit() {
+    // Unpacked blocks can always be unpacked again, so they go first.
+    {
+        std::lock_guard lock{unpacked_mutex_};
+        shrink_unpacked(0);
+    }
+
+    while (memory_usage() > memory_limit_ && !blocks_.empty()) {
+        packed_bytes_ -= blocks_.front()->data.size();
+        packed_frames_ -= kBlockFrames;
+        dropped_ += kBlockFrames;
+        blocks_.pop_front();
+    }
+
+    // If the limit is too small to even hold the recent frames, drop those
+    // too, but always keep the latest one.
+    while (memory_usage() > memory_limit_ && recent_.size() > 1) {
+        recent_bytes_ -= recent_sizes_.front();
+        recent_sizes_.pop_front();
+        recent_.pop_front();
+        dropped_++;
+    }
+}
+
+std::vector<std::shared_ptr<Packet::LogFrame>> LogHistory::unpack(const Block& block,
+                                                                  size_t* bytes) const {
+    std::string serialized;
+    {
+        google::protobuf::io::ArrayInputStream raw{block.data.data(),
+                                                   static_cast<int>(block.data.size())};
+        google::protobuf::io::GzipInputStream inflate{&raw,
+                                                      google::protobuf::io::GzipInputStream::ZLIB};
+        const void* chunk = nullptr;
+        int chunk_size = 0;
+        while (inflate.Next(&chunk, &chunk_size)) {
+            serialized.append(static_cast<const char*>(chunk), chunk_size);
+        }
+    }
+
+    std::vector<std::shared_ptr<Packet::LogFrame>> frames;
+    frames.reserve(kBlockFrames);
+    google::protobuf::io::CodedInputStream input{
+        reinterpret_cast<const uint8_t*>(serialized.data()), static_cast<int>(serialized.size())};
+    for (size_t i = 0; i < kBlockFrames; i++) {
+        auto frame = std::make_shared<Packet::LogFrame>();
+        uint32_t size = 0;
+        if (input.ReadVarint32(&size)) {
+            *bytes += size;
+            const auto limit = input.PushLimit(static_cast<int>(size));
+            frame->MergePartialFromCodedStream(&input);
+            input.PopLimit(limit);
+        }
+        frames.emplace_back(std::move(frame));
+    }
+    return frames;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <rj_protos/LogFrame.pb.h>
+
+/**
+ * \brief The log frames kept in memory, within a memory budget.
+ *
+ * The newest kRecentFrames frames are kept as they are, since the UI looks at
+ * those every update. Older frames are packed kBlockFrames at a time: the
+ * block is serialized and deflated together, so anything a frame repeats from
+ * the frame before it is nearly free. That only holds while frames are smaller
+ * than deflate's 32 KiB window; bigger frames are effectively compressed one
+ * at a time. Packed frames are decoded again when asked for, a block at a
+ * time.
+ *
+ * When the estimated memory use (see memory_usage()) goes over the limit,
+ * unpacked blocks are forgotten first, then the oldest blocks are dropped and
+ * counted in dropped().
+ *
+ * Copies are cheap (packed blocks are shared and never modified), so a copy
+ * can be handed to another thread as a snapshot.
+ */
+class LogHistory {
+public:
+    // Thirty seconds at 60Hz
+    static constexpr size_t kRecentFrames = 60 * 30;
+    // One second at 60Hz
+    static constexpr size_t kBlockFrames = 60;
+    static constexpr size_t kDefaultMemoryLimit = size_t{512} << 20;
+    // Enough unpacked blocks to scroll back through kRecentFrames worth of
+    // packed frames without unpacking any block twice.
+    static constexpr size_t kUnpackedBlocks = kRecentFrames / kBlockFrames + 1;
+
+    explicit LogHistory(size_t memory_limit = kDefaultMemoryLimit)
+        : memory_limit_{memory_limit} {}
+
+    LogHistory(const LogHistory& other);
+    LogHistory& operator=(const LogHistory& other);
+    LogHistory(LogHistory&& other) noexcept;
+    LogHistory& operator=(LogHistory&& other) noexcept;
+    ~LogHistory() = default;
+
+    /**
+     * \brief Add a frame to the end of the history, packing and dropping
+     * older frames as needed.
+     */
+    void push_back(std::shared_ptr<Packet::LogFrame> frame);
+
+    /**
+     * \brief The frame at the given position, 0 being the oldest one still
+     * kept. Decodes the frame's block if it's packed; hold on to the result
+     * rather than asking again.
+     */
+    [[nodiscard]] std::shared_ptr<Packet::LogFrame> at(size_t index) const;
+
+    [[nodiscard]] size_t size() const { return packed_frames_ + recent_.size(); }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    void clear();
+
+    /**
+     * \brief How many frames have been dropped from the front to stay under
+     * the memory limit.
+     */
+    [[nodiscard]] size_t dropped() const { return dropped_; }
+
+    /**
+     * \brief Estimated memory use: the serialized size of recent frames and
+     * of the blocks unpacked by at(), plus the packed size of everything else.
+     * Decoded frames take somewhat more than their serialized size.
+     *
+     * Frames still held by callers after they've left the history or the
+     * unpacked blocks aren't counted.
+     */
+    [[nodiscard]] size_t memory_usage() const;
+
+    void set_memory_limit(size_t bytes) { memory_limit_ = bytes; }
+
+private:
+    struct Block {
+        // kBlockFrames size-delimited frames, deflated together
+        std::string data;
+    };
+
+    void pack_oldest_block();
+    void enforce_memory_limit();
+    // Decodes a block, adding the serialized size of its frames to *bytes.
+    std::vector<std::shared_ptr<Packet::LogFrame>> unpack(const Block& block,
+                                                          size_t* bytes) const;
+
+    size_t memory_limit_;
+
+    std::deque<std::shared_ptr<const Block>> blocks_;
+    size_t packed_frames_ = 0;
+    size_t packed_bytes_ = 0;
+
+    std::deque<std::shared_ptr<Packet::LogFrame>> recent_;
+    // Serialized size of each recent frame
+    std::deque<size_t> recent_sizes_;
+    size_t recent_bytes_ = 0;
+
+    size_t dropped_ = 0;
+
+    struct UnpackedBlock {
+        std::shared_ptr<const Block> block;
+        std::vector<std::shared_ptr<Packet::LogFrame>> frames;
+        // Serialized size of frames
+        size_t bytes;
+    };
+
+    // Forgets the oldest unpacked blocks until the history fits in the
+    // limit, keeping at least `keep` of them.
+    void shrink_unpacked(size_t keep) const;
+
+    // The most recently unpacked blocks, since the UI looks at a window of
+    // neighboring frames every update.
+    mutable std::mutex unpacked_mutex_;
+    mutable std::deque<UnpackedBlock> unpacked_;
+    mutable size_t unpacked_bytes_ = 0;
+};
@@ -0,0 +1,143 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "log_history.hpp"
+
+namespace {
+
+std::shared_ptr<Packet::LogFrame> make_frame(uint64_t timestamp) {
+    auto frame = std::make_shared<Packet::LogFrame>();
+    frame->set_timestamp(timestamp);
+    frame->set_command_time(timestamp);
+    for (int i = 0; i < 10; i++) {
+        frame->add_debug_layers("layer " + std::to_string(i));
+    }
+    return frame;
+}
+
+// About 16 KiB, most of it the same from one frame to the next: a planned
+// path per robot that only moves a little, plus a static drawing.
+std::shared_ptr<Packet::LogFrame> make_realistic_frame(uint64_t timestamp) {
+    auto frame = make_frame(timestamp);
+    for (int robot = 0; robot < 12; robot++) {
+        Packet::DebugPath* path = frame->add_debug_paths();
+        path->set_layer(robot % 3);
+        for (int i = 0; i < 100; i++) {
+            Packet::Point* point = path->add_points();
+            point->set_x(static_cast<float>(robot) + 0.01f * static_cast<float>(i + timestamp));
+            point->set_y(0.02f * static_cast<float>(i));
+        }
+    }
+    Packet::DebugPath* outline = frame->add_debug_paths();
+    for (int i = 0; i < 400; i++) {
+        Packet::Point* point = outline->add_points();
+        point->set_x(std::cos(static_cast<float>(i)));
+        point->set_y(std::sin(static_cast<float>(i)));
+    }
+    return frame;
+}
+
+}  // namespace
+
+TEST(LogHistory, PacksOlderFrames) {
+    LogHistory history;
+    constexpr size_t kNumFrames = LogHistory::kRecentFrames + 3 * LogHistory::kBlockFrames + 10;
+
+    size_t serialized_bytes = 0;
+    for (size_t i = 0; i < kNumFrames; i++) {
+        auto frame = make_frame(i);
+        serialized_bytes += frame->ByteSizeLong();
+        history.push_back(std::move(frame));
+    }
+
+    ASSERT_EQ(history.size(), kNumFrames);
+    EXPECT_EQ(history.dropped(), 0u);
+    EXPECT_LT(history.memory_usage(), serialized_bytes);
+
+    for (size_t i = 0; i < kNumFrames; i++) {
+        std::shared_ptr<Packet::LogFrame> frame = history.at(i);
+        ASSERT_NE(frame, nullptr);
+        EXPECT_EQ(frame->timestamp(), i);
+        EXPECT_EQ(frame->debug_layers_size(), 10);
+    }
+
+    // Frames from the same block are only unpacked once
+    EXPECT_EQ(history.at(0), history.at(0));
+}
+
+TEST(LogHistory, PacksSimilarFramesSmall) {
+    const size_t frame_size = make_realistic_frame(0)->ByteSizeLong();
+    ASSERT_GT(frame_size, size_t{12} << 10);
+    ASSERT_LT(frame_size, size_t{32} << 10);
+
+    LogHistory history{size_t{1} << 30};
+    constexpr size_t kPackedFrames = 10 * LogHistory::kBlockFrames;
+    for (size_t i = 0; i < LogHistory::kRecentFrames + kPackedFrames; i++) {
+        history.push_back(make_realistic_frame(i));
+    }
+    ASSERT_EQ(history.dropped(), 0u);
+
+    const size_t recent_bytes = LogHistory::kRecentFrames * frame_size;
+    ASSERT_GE(history.memory_usage(), recent_bytes);
+    const size_t packed_bytes_per_frame = (history.memory_usage() - recent_bytes) / kPackedFrames;
+    RecordProperty("frame_bytes", static_cast<int>(frame_size));
+    RecordProperty("packed_bytes_per_frame", static_cast<int>(packed_bytes_per_frame));
+    // One of these frames deflated on its own is about half its size, so this
+    // only passes if frames share their repeated parts.
+    EXPECT_LT(packed_bytes_per_frame, frame_size / 3);
+}
+
+TEST(LogHistory, DropsOldestFramesOverLimit) {
+    const size_t frame_size = make_frame(0)->ByteSizeLong();
+    LogHistory history{frame_size * LogHistory::kRecentFrames};
+
+    constexpr size_t kNumFrames = 2 * LogHistory::kRecentFrames;
+    for (size_t i = 0; i < kNumFrames; i++) {
+        history.push_back(make_frame(i));
+    }
+
+    EXPECT_GT(history.dropped(), 0u);
+    EXPECT_EQ(history.size() + history.dropped(), kNumFrames);
+    EXPECT_LE(history.memory_usage(), frame_size * LogHistory::kRecentFrames);
+    EXPECT_EQ(history.at(0)->timestamp(), history.dropped());
+    EXPECT_EQ(history.at(history.size() - 1)->timestamp(), kNumFrames - 1);
+}
+
+TEST(LogHistory, CountsUnpackedBlocks) {
+    const size_t frame_size = make_frame(0)->ByteSizeLong();
+    const size_t limit = frame_size * (LogHistory::kRecentFrames + 2 * LogHistory::kBlockFrames);
+    LogHistory history{limit};
+
+    constexpr size_t kNumFrames = 2 * LogHistory::kRecentFrames;
+    for (size_t i = 0; i < kNumFrames; i++) {
+        history.push_back(make_frame(i));
+    }
+    ASSERT_GT(history.size(), LogHistory::kRecentFrames + LogHistory::kBlockFrames);
+
+    // Unpacking a block costs its serialized size
+    const size_t before = history.memory_usage();
+    ASSERT_NE(history.at(0), nullptr);
+    EXPECT_GT(history.memory_usage(), before);
+
+    // Reading through every packed frame doesn't unpack past the limit
+    for (size_t i = 0; i < history.size(); i++) {
+        ASSERT_EQ(history.at(i)->timestamp(), history.dropped() + i);
+        EXPECT_LE(history.memory_usage(), limit + LogHistory::kBlockFrames * frame_size);
+    }
+}
+
+TEST(LogHistory, CopiesAreSnapshots) {
+    LogHistory history;
+    for (size_t i = 0; i < LogHistory::kRecentFrames + LogHistory::kBlockFrames; i++) {
+        history.push_back(make_frame(i));
+    }
+
+    LogHistory snapshot{history};
+    history.push_back(make_frame(12345));
+    history.clear();
+
+    ASSERT_EQ(snapshot.size(), LogHistory::kRecentFrames + LogHistory::kBlockFrames);
+    EXPECT_EQ(snapshot.at(0)->timestamp(), 0u);
+    EXPECT_TRUE(history.empty());
+}
@@ -2,7 +2,6 @@
 #include <cstdio>
 
 #include <QApplication>
-#include <QFile>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
 #include <log_viewer.hpp>
@@ -61,43 +60,18 @@ LogViewer::LogViewer(QWidget* parent) : QMainWindow(parent) {
 }
 
 bool LogViewer::readFrames(const char* filename) {
-    frames.clear();
     ui.timeSlider->setMaximum(0);
 
-    QFile file(filename);
-    if (!file.open(QFile::ReadOnly)) {
-        fprintf(stderr, "Can't open %s: %s\n", filename,
-                (const char*)file.errorString().toLatin1());
+    log = LogFile::open(filename);
+    if (log == nullptr) {
+        fprintf(stderr, "Can't open %s\n", filename);
         return false;
     }
 
-    int n = 0;
-    while (!file.atEnd()) {
-        uint32_t size = 0;
-        if (file.read((char*)&size, sizeof(size)) != sizeof(size)) {
-            // Broken length
-            printf("Broken length\n");
-            return false;
-        }
-
-        string str(size, 0);
-        if (file.read(&str[0], size) != size) {
-            // Broken packet at end of file
-            printf("Broken packet\n");
-            return false;
-        }
-
-        std::shared_ptr<LogFrame> frame = std::make_shared<LogFrame>();
-        frames.push_back(frame);
-        // Parse partial so we can recover from corrupt data
-        if (!frame->ParsePartialFromString(str)) {
-            printf("Failed: %s\n", frame->InitializationErrorString().c_str());
-            return false;
-        }
-        ++n;
+    if (!log->empty()) {
+        _startCommandTime = log->frame(0)->command_time();
     }
-
-    ui.timeSlider->setMaximum(frames.size());
+    ui.timeSlider->setMaximum(log->size());
     return true;
 }
 
@@ -109,27 +83,33 @@ void LogViewer::updateViews() {
     }
     _lastUpdateTime = time;
 
+    if (log == nullptr || log->empty()) {
+        return;
+    }
+
     // Limit to available data
     _doubleFrameNumber = max(0.0, _doubleFrameNumber);
-    _doubleFrameNumber = min(frames.size() - 1.0, _doubleFrameNumber);
+    _doubleFrameNumber = min(log->size() - 1.0, _doubleFrameNumber);
 
     int f = frameNumber();
-    const LogFrame& currentFrame = *frames[f];
+    const std::shared_ptr<LogFrame> current = log->frame(f);
+    const LogFrame& currentFrame = *current;
 
     ui.timeSlider->setValue(f);
 
-    // Copy recent history into the FieldView
-    int n = min(f, (int)_history.size());
+    // Copy recent history into the FieldView. Fill a new list while the old
+    // one still holds the frames, so LogFile hands back the same decoded
+    // frames instead of decoding them again.
+    std::vector<std::shared_ptr<LogFrame>> history(_history.size());
+    int n = min(f, (int)history.size());
     for (int i = 0; i < n; ++i) {
-        _history[i] = frames[f - i];
-    }
-    for (int i = n; i < (int)_history.size(); ++i) {
-        _history[i].reset();
+        history[i] = log->frame(f - i);
     }
+    _history.swap(history);
 
     // Update non-message tree items
     _frameNumberItem->setData(ProtobufTree::Column_Value, Qt::DisplayRole, frameNumber());
-    int elapsedMillis = (currentFrame.command_time() - frames[0]->command_time() + 500) / 1000;
+    int elapsedMillis = (currentFrame.command_time() - _startCommandTime + 500) / 1000;
     QTime elapsedTime = QTime::fromMSecsSinceStartOfDay(elapsedMillis);
     _elapsedTimeItem->setText(ProtobufTree::Column_Value, elapsedTime.toString("hh:mm:ss.zzz"));
 
@@ -186,4 +166,8 @@ void LogViewer::on_logPrev_clicked() {
 
 void LogViewer::on_logBeginning_clicked() { frameNumber(0); }
 
-void LogViewer::on_logEnd_clicked() { frameNumber(frames.size() - 1); }
+void LogViewer::on_logEnd_clicked() {
+    if (log != nullptr) {
+        frameNumber(static_cast<int>(log->size()) - 1);
+    }
+}
@@ -3,6 +3,8 @@
 #include <rj_protos/LogFrame.pb.h>
 #include <ui_LogViewer.h>
 
+#include "log_file.hpp"
+
 #include <QTime>
 #include <QTimer>
 #include <vector>
@@ -20,7 +22,8 @@ public:
     // This is called when
     bool readFrames(const char* filename);
 
-    std::vector<std::shared_ptr<Packet::LogFrame> > frames;
+    // Frames are decoded from here as they come into view.
+    std::shared_ptr<LogFile> log;
 
 public Q_SLOTS:
     void updateViews();
@@ -50,6 +53,9 @@ private:
     QTime _lastUpdateTime;
     double _doubleFrameNumber;
 
+    // command_time of the first frame, for the elapsed time display
+    uint64_t _startCommandTime = 0;
+
     // Recent history.
     // Yeah, it's copied, but if it works in soccer then it works here.
     std::vector<std::shared_ptr<Packet::LogFrame> > _history;
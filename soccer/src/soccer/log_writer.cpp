@@ -0,0 +1,161 @@
+#include "log_writer.hpp"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+bool ends_with(const std::string& str, const std::string& suffix) {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+// Protobuf helper function from: https://stackoverflow.com/a/22927149:
+// From Comment:
+// (I am the author of the C++ and Java protobuf libraries, but I no longer work
+// for Google. Sorry that this code never made it into the official lib. This is
+// what it would look like if it had.)
+bool write_delimited_to(const google::protobuf::MessageLite& message,
+                        google::protobuf::io::ZeroCopyOutputStream* raw_output) {
+    // We create a new coded stream for each message.  Don't worry, this is
+    // fast.
+    google::protobuf::io::CodedOutputStream output(raw_output);
+
+    // Write the size.
+    const auto size = static_cast<int>(message.ByteSizeLong());
+    output.WriteVarint32(size);
+
+    uint8_t* buffer = output.GetDirectBufferForNBytesAndAdvance(size);
+    if (buffer != nullptr) {
+        // Optimization:  The message fits in one buffer, so use the faster
+        // direct-to-array serialization path.
+        message.SerializeWithCachedSizesToArray(buffer);
+    } else {
+        // Slightly-slower path when the message is multiple buffers.
+        message.SerializeWithCachedSizes(&output);
+        if (output.HadError()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+LogWriter::LogWriter(const std::string& filename, LogHistory backlog)
+    : file_{filename, std::ios::out | std::ios::binary},
+      compress_{ends_with(filename, ".gz")},
+      backlog_{std::move(backlog)} {
+    if (!file_.good()) {
+        SPDLOG_ERROR("Failed to open log file {}", filename);
+        failed_ = true;
+    }
+    thread_ = std::thread{[this]() { run(); }};
+}
+
+LogWriter::~LogWriter() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+
+    if (!compress_) {
+        write_index();
+    }
+}
+
+bool LogWriter::push(FramePtr frame) {
+    {
+        std::lock_guard lock{mutex_};
+        if (pending_.size() >= kMaxPendingFrames) {
+            dropped_frames_++;
+            return false;
+        }
+        pending_.emplace_back(std::move(frame));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void LogWriter::run() {
+    // Write the backlog a block at a time, so that only one block of it is
+    // ever unpacked.
+    for (size_t i = 0; i < backlog_.size(); i++) {
+        batch_.push_back(backlog_.at(i));
+        if (batch_.size() == LogHistory::kBlockFrames || i + 1 == backlog_.size()) {
+            write_batch(batch_);
+            batch_.clear();
+        }
+    }
+    backlog_.clear();
+
+    while (true) {
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;
+            }
+            // Hand the empty buffer back to push() and take the full one.
+            std::swap(pending_, batch_);
+        }
+
+        write_batch(batch_);
+        batch_.clear();
+    }
+}
+
+void LogWriter::write_batch(const std::vector<FramePtr>& batch) {
+    if (failed_) {
+        dropped_frames_ += batch.size();
+        return;
+    }
+
+    buffer_.clear();
+    {
+        google::protobuf::io::StringOutputStream raw{&buffer_};
+        if (compress_) {
+            google::protobuf::io::GzipOutputStream gzip{&raw};
+            for (const auto& frame : batch) {
+                write_delimited_to(*frame, &gzip);
+            }
+            gzip.Close();
+        } else {
+            for (const auto& frame : batch) {
+                index_.push_back(LogFile::IndexEntry{static_cast<int64_t>(frame->timestamp()),
+                                                     bytes_written_ + raw.ByteCount()});
+                write_delimited_to(*frame, &raw);
+            }
+        }
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.flush();
+    if (!file_.good()) {
+        SPDLOG_ERROR("Failed writing to log file; no more frames will be written");
+        failed_ = true;
+        dropped_frames_ += batch.size();
+        return;
+    }
+    bytes_written_ += buffer_.size();
+}
+
+void LogWriter::write_index() {
+    if (failed_) {
+        return;
+    }
+
+    const LogFile::Footer footer{bytes_written_, index_.size(), LogFile::kFooterMagic};
+    file_.write(reinterpret_cast<const char*>(index_.data()),
+                static_cast<std::streamsize>(index_.size() * sizeof(LogFile::IndexEntry)));
+    file_.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    file_.flush();
+    if (!file_.good()) {
+        SPDLOG_ERROR("Failed writing the log index; the log will be scanned when opened");
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <google/protobuf/io/zero_copy_stream.h>
+#include <google/protobuf/message_lite.h>
+#include <rj_protos/LogFrame.pb.h>
+
+#include "log_file.hpp"
+#include "log_history.hpp"
+
+/**
+ * \brief Write a message to an output stream, prefixed by its size.
+ */
+bool write_delimited_to(const google::protobuf::MessageLite& message,
+                        google::protobuf::io::ZeroCopyOutputStream* raw_output);
+
+/**
+ * \brief Writes log frames to a file on its own thread.
+ *
+ * The Processor hands frames over with push(), which never touches the disk
+ * and never blocks on the writer. The writer thread swaps the whole pending
+ * list out at once, serializes it into one buffer, and writes that with a
+ * single call, so a slow disk only ever stalls this thread.
+ *
+ * If the writer falls kMaxPendingFrames behind, new frames are dropped (and
+ * counted) rather than queued without bound.
+ *
+ * When the writer is destroyed it appends a frame index, so that LogFile can
+ * open the log without reading through it (see LogFile for the layout).
+ *
+ * Files whose names end in ".gz" are written as a series of gzip members, one
+ * per batch, so everything up to the last complete batch can still be read
+ * back if the program dies mid-write. These aren't indexed.
+ */
+class LogWriter {
+public:
+    using FramePtr = std::shared_ptr<const Packet::LogFrame>;
+
+    // Ten seconds of frames at 60Hz
+    static constexpr size_t kMaxPendingFrames = 60 * 10;
+
+    /**
+     * \brief Open the file and start the writer thread.
+     *
+     * \param backlog Frames to write before anything pushed later. These are
+     * never dropped, and packed frames are only unpacked a block at a time
+     * as they're written.
+     */
+    explicit LogWriter(const std::string& filename, LogHistory backlog = LogHistory{});
+
+    /**
+     * \brief Write out everything still pending and the index, then stop the
+     * thread.
+     */
+    ~LogWriter();
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+    LogWriter(LogWriter&&) = delete;
+    LogWriter& operator=(LogWriter&&) = delete;
+
+    /**
+     * \brief Whether the file opened and every write so far has succeeded.
+     */
+    [[nodiscard]] bool good() const { return !failed_; }
+
+    /**
+     * \brief Queue a frame to be written.
+     *
+     * \return false if the frame was dropped because too many are pending.
+     */
+    bool push(FramePtr frame);
+
+    /**
+     * \brief Number of frames that didn't make it into the file: those
+     * dropped by push() because too many were pending, and whole batches
+     * thrown away because the file stopped accepting writes.
+     */
+    [[nodiscard]] size_t dropped_frames() const { return dropped_frames_; }
+
+    /**
+     * \brief Number of bytes written to the file so far.
+     */
+    [[nodiscard]] size_t bytes_written() const { return bytes_written_; }
+
+private:
+    void run();
+    void write_batch(const std::vector<FramePtr>& batch);
+    void write_index();
+
+    std::ofstream file_;
+    bool compress_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    // Filled by push() and swapped out whole by the writer thread.
+    std::vector<FramePtr> pending_;
+    bool stopping_ = false;
+
+    // Only touched by the writer thread.
+    LogHistory backlog_;
+    std::vector<FramePtr> batch_;
+    std::string buffer_;
+    std::vector<LogFile::IndexEntry> index_;
+
+    std::atomic_bool failed_{false};
+    std::atomic<size_t> dropped_frames_{0};
+    std::atomic<size_t> bytes_written_{0};
+
+    std::thread thread_;
+};
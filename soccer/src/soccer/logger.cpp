@@ -6,6 +6,7 @@
 #include <spdlog/spdlog.h>
 
 #include <context.hpp>
+#include <global_params.hpp>
 #include <radio/packet_convert.hpp>
 #include <rj_utils/logging.hpp>
 
@@ -13,41 +14,6 @@
 
 using namespace Packet;
 
-// Protobuf helper function from: https://stackoverflow.com/a/22927149:
-// From Comment:
-// (I am the author of the C++ and Java protobuf libraries, but I no longer work
-// for Google. Sorry that this code never made it into the official lib. This is
-// what it would look like if it had.)
-
-/**
- * Write a message to an output stream, delimited by size.
- */
-bool write_delimited_to(const google::protobuf::MessageLite& message,
-                        google::protobuf::io::ZeroCopyOutputStream* raw_output) {
-    // We create a new coded stream for each message.  Don't worry, this is
-    // fast.
-    google::protobuf::io::CodedOutputStream output(raw_output);
-
-    // Write the size.
-    const int size = message.ByteSize();
-    output.WriteVarint32(size);
-
-    uint8_t* buffer = output.GetDirectBufferForNBytesAndAdvance(size);
-    if (buffer != nullptr) {
-        // Optimization:  The message fits in one buffer, so use the faster
-        // direct-to-array serialization path.
-        message.SerializeWithCachedSizesToArray(buffer);
-    } else {
-        // Slightly-slower path when the message is multiple buffers.
-        message.SerializeWithCachedSizes(&output);
-        if (output.HadError()) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
 /**
  * Read a message from an input stream, delimited by size.
  */
@@ -98,61 +64,66 @@ void Logger::start() {
 }
 
 void Logger::run() {
+    // While reading, the frames come from the file instead.
+    if (context_->logs.state == Logs::State::kReading) {
+        return;
+    }
+
     std::shared_ptr<Packet::LogFrame> log_frame = create_log_frame(context_);
 
     if (context_->logs.state == Logs::State::kWriting) {
-        context_->logs.size_bytes += log_frame->ByteSize();
-        google::protobuf::io::OstreamOutputStream output(&log_file_.value());
-        write_to_file(log_frame.get(), &output);
-    }
-
-    while (context_->logs.frames.size() + 1 >= kMaxLogFrames) {
-        context_->logs.frames.pop_front();
+        log_writer_->push(log_frame);
+        context_->logs.size_bytes = log_writer_->bytes_written();
+        context_->logs.dropped_write_frames = log_writer_->dropped_frames();
     }
 
-    context_->logs.frames.emplace_back(std::move(log_frame));
+    context_->logs.frames.set_memory_limit(
+        static_cast<size_t>(soccer::logs::PARAM_history_memory_mb) << 20);
+    context_->logs.frames.push_back(std::move(log_frame));
+    context_->logs.dropped_frames = context_->logs.frames.dropped();
 }
 
 void Logger::stop() {}
 
 void Logger::read(const std::string& filename) {
-    log_file_ = std::fstream();
-    log_file_->open(filename, std::fstream::in | std::fstream::binary);
     context_->logs.filename = filename;
     context_->logs.state = Logs::State::kReading;
-
     context_->logs.frames.clear();
 
-    if (!log_file_->good()) {
+    // Frames are decoded from the file as they're viewed, rather than all up
+    // front.
+    context_->logs.file = LogFile::open(filename);
+    if (context_->logs.file == nullptr) {
         FATAL_THROW("Log file {} does not exist.", filename);
     }
+    context_->logs.size_bytes = context_->logs.file->size_bytes();
+}
+
+bool Logger::write(const std::string& filename) {
+    // Finish off any file we're already writing before starting another. This
+    // waits on the old writer; Processor::open_log closes it first instead.
+    close();
 
-    // Populate the entire logs struct.
-    auto frame = std::make_shared<LogFrame>();
-    google::protobuf::io::IstreamInputStream input(&log_file_.value());
-    while (read_from_file(frame.get(), &input)) {
-        context_->logs.size_bytes += frame->ByteSize();
-        context_->logs.frames.emplace_back(std::move(frame));
-        frame = std::make_shared<LogFrame>();
+    // Everything already in the history goes out first, on the writer thread.
+    log_writer_ = std::make_unique<LogWriter>(filename, context_->logs.frames);
+    if (!log_writer_->good()) {
+        log_writer_.reset();
+        return false;
     }
-}
 
-void Logger::write(const std::string& filename) {
-    log_file_ = std::fstream();
-    log_file_->open(filename, std::fstream::out | std::fstream::binary);
+    context_->logs.file = nullptr;
     context_->logs.filename = filename;
     context_->logs.state = Logs::State::kWriting;
-
-    google::protobuf::io::OstreamOutputStream output(&log_file_.value());
-    for (const auto& frame : context_->logs.frames) {
-        write_to_file(frame.get(), &output);
-    }
+    context_->logs.size_bytes = 0;
+    context_->logs.dropped_write_frames = 0;
+    return true;
 }
 
-void Logger::close() {
-    log_file_ = std::nullopt;
+std::unique_ptr<LogWriter> Logger::close() {
+    context_->logs.file = nullptr;
     context_->logs.filename = std::nullopt;
     context_->logs.state = Logs::State::kNoFile;
+    return std::move(log_writer_);
 }
 
 std::shared_ptr<Packet::LogFrame> Logger::create_log_frame(Context* context) {
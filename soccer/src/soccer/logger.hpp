@@ -1,7 +1,5 @@
 #pragma once
 
-#include <deque>
-#include <fstream>
 #include <optional>
 
 #include <control/motion_setpoint.hpp>
@@ -9,6 +7,9 @@
 #include <rj_common/time.hpp>
 #include <rj_protos/LogFrame.pb.h>
 
+#include "log_file.hpp"
+#include "log_history.hpp"
+#include "log_writer.hpp"
 #include "node.hpp"
 #include "robot_intent.hpp"
 #include "world_state.hpp"
@@ -16,13 +17,10 @@
 // For FRIEND_TEST
 #include <gtest/gtest_prod.h>
 
-// Keep the past thirty minutes of logs by default.
-constexpr size_t kMaxLogFrames = 60 * 60 * 30;
-
 struct Logs {
     /**
-     * \brief A list of all log frames. This will contain at most
-     * `kMaxLogFrames` frames.
+     * \brief The log frames kept in memory, up to soccer.logs.history_memory_mb
+     * worth (not counting frames the UI holds on to). See LogHistory.
      *
      * This should not be accessed from the Processor thread, other
      * than to add frames. The container may be accessed by the MainWindow
@@ -30,7 +28,30 @@ struct Logs {
      * and used even while the mutex is not locked (provided a shared_ptr
      * is kept).
      */
-    std::deque<std::shared_ptr<Packet::LogFrame>> frames;
+    LogHistory frames;
+
+    /**
+     * \brief The log being viewed, while reading. Its frames are decoded on
+     * demand instead of being copied into `frames`.
+     */
+    std::shared_ptr<LogFile> file;
+
+    /**
+     * \brief The number of frames in the history (not counting dropped ones),
+     * from `file` if we're reading one and `frames` otherwise.
+     */
+    [[nodiscard]] size_t num_frames() const {
+        return file != nullptr ? file->size() : frames.size();
+    }
+
+    /**
+     * \brief The frame at the given position in the history (not counting
+     * dropped ones). Keep the returned pointer rather than calling this again,
+     * since frames from a file are decoded here.
+     */
+    [[nodiscard]] std::shared_ptr<Packet::LogFrame> frame(size_t index) const {
+        return file != nullptr ? file->frame(index) : frames.at(index);
+    }
 
     enum class State { kNoFile, kWriting, kReading };
 
@@ -59,6 +80,12 @@ struct Logs {
      * but were dropped.
      */
     size_t dropped_frames = 0;
+
+    /**
+     * \brief Frames that never made it into the log file, because the
+     * writer fell too far behind or the file stopped accepting writes.
+     */
+    size_t dropped_write_frames = 0;
 };
 
 // Forward-declare context, which needs to use Logs as above
@@ -74,23 +101,29 @@ public:
     Logger(Context* context) : context_(context) {}
 
     /**
-     * \brief Open the given file for reading
+     * \brief Open the given file for reading. See LogFile.
      */
     void read(const std::string& filename);
 
     /**
-     * \brief Open the given file for writing.
-     */
-    void write(const std::string& filename);
-
-    /**
-     * \brief Close the current log file.
+     * \brief Open the given file for writing, starting with every frame
+     * already in the history. Frames are written on a separate thread; see
+     * LogWriter. The file is gzip-compressed if its name ends in ".gz".
+     *
+     * Call close() first if a file is already being written.
+     *
+     * \return false if the file could not be opened.
      */
-    void close();
+    bool write(const std::string& filename);
 
     /**
-     * \brief Flush the file to disk.
+     * \brief Stop logging to the current file.
+     *
+     * \return the writer for that file, if there was one. Destroying it waits
+     * for any frames still queued to be written, so callers holding the loop
+     * mutex should let it go out of scope after releasing the lock.
      */
+    std::unique_ptr<LogWriter> close();
 
     void start() override;
     void run() override;
@@ -109,7 +142,8 @@ private:
     FRIEND_TEST(Logger, SaveContext);
     FRIEND_TEST(Logger, SerializeDeserialize);
 
-    std::optional<std::fstream> log_file_;
+    // Writes to the log file, if we're writing one.
+    std::unique_ptr<LogWriter> log_writer_;
 
     Context* context_;
 };
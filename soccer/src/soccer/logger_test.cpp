@@ -1,3 +1,5 @@
+#include <filesystem>
+
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/util/message_differencer.h>
 #include <gtest/gtest.h>
@@ -81,4 +83,45 @@ TEST(Logger, SerializeDeserialize) {
     std::cout << diff << std::endl;
 
     EXPECT_EQ(kExpected, count);
-}
\ No newline at end of file
+}
+namespace {
+
+std::shared_ptr<Packet::LogFrame> make_frame(int64_t timestamp) {
+    auto frame = std::make_shared<Packet::LogFrame>();
+    frame->set_timestamp(timestamp);
+    frame->set_command_time(timestamp);
+    return frame;
+}
+
+void check_round_trip(const std::string& filename) {
+    const std::string path = (std::filesystem::temp_directory_path() / filename).string();
+
+    {
+        LogHistory backlog;
+        backlog.push_back(make_frame(0));
+        backlog.push_back(make_frame(1));
+        LogWriter writer{path, backlog};
+        ASSERT_TRUE(writer.good());
+        for (int i = 2; i < 10; i++) {
+            EXPECT_TRUE(writer.push(make_frame(i)));
+        }
+    }
+
+    Context context;
+    Logger logger{&context};
+    logger.read(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(context.logs.num_frames(), 10u);
+    for (size_t i = 0; i < context.logs.num_frames(); i++) {
+        EXPECT_EQ(context.logs.frame(i)->timestamp(), static_cast<int64_t>(i));
+    }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(LogWriter, WritesBacklogThenPushedFrames) { check_round_trip("log_writer_test.log"); }
+
+// NOLINTNEXTLINE
+TEST(LogWriter, WritesCompressedBlocks) { check_round_trip("log_writer_test.log.gz"); }
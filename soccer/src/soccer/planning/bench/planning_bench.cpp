@@ -0,0 +1,391 @@
+/*
+ * Planning micro-benchmarks.
+ *
+ * Replays PlanRequests through each PathPlanner, and times the planning
+ * primitives they are built on. Besides Google Benchmark's own timing, every
+ * benchmark reports the p50/p99 latency of a single call and the number of
+ * heap allocations per call.
+ *
+ * Usage:
+ *   bench-planning [--corpus=<file>]... [benchmark flags]
+ *
+ * Corpus files are written by the planner node when planning.bench.record_path
+ * is set. Each request is replayed through the planner its MotionCommand names.
+ * Without a corpus, a fixed synthetic corpus is generated so that runs are
+ * comparable between builds.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <rj_constants/constants.hpp>
+
+#include "planning/planner/collect_path_planner.hpp"
+#include "planning/planner/escape_obstacles_path_planner.hpp"
+#include "planning/planner/intercept_path_planner.hpp"
+#include "planning/planner/line_kick_path_planner.hpp"
+#include "planning/planner/path_target_path_planner.hpp"
+#include "planning/planner/pivot_path_planner.hpp"
+#include "planning/planner/plan_request_log.hpp"
+#include "planning/planner/settle_path_planner.hpp"
+#include "planning/primitives/create_path.hpp"
+#include "planning/primitives/planning_rng.hpp"
+#include "planning/primitives/velocity_profiling.hpp"
+#include "planning/trajectory_utils.hpp"
+
+// Count every heap allocation made by the process, so benchmarks can report
+// allocations per call.
+namespace {
+std::atomic<uint64_t> num_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+using namespace planning;
+using namespace rj_geometry;
+
+namespace {
+
+constexpr uint64_t kCorpusSeed = 2022;
+constexpr int kSyntheticRequestsPerPlanner = 64;
+
+// Requests to replay, grouped by planner name.
+std::map<std::string, std::vector<RecordedPlanRequest>> corpus;
+
+/**
+ * Time @fn once per benchmark iteration, then report latency percentiles and
+ * allocations per call as counters.
+ */
+template <typename Fn>
+void run_timed(benchmark::State& state, Fn&& fn) {
+    std::vector<double> latencies_us;
+    latencies_us.reserve(state.max_iterations);
+    uint64_t allocations = 0;
+
+    for (auto _ : state) {
+        const uint64_t allocations_before = num_allocations.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        allocations += num_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    if (latencies_us.empty()) {
+        return;
+    }
+
+    const auto percentile = [&](double p) {
+        const auto index = static_cast<size_t>(p * static_cast<double>(latencies_us.size() - 1));
+        std::nth_element(latencies_us.begin(), latencies_us.begin() + index, latencies_us.end());
+        return latencies_us[index];
+    };
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["allocs_per_call"] =
+        static_cast<double>(allocations) / static_cast<double>(latencies_us.size());
+}
+
+double random_in(PlanningRng* rng, double lo, double hi) { return lo + (hi - lo) * rng->uniform(); }
+
+Point random_point(PlanningRng* rng) {
+    return Point{random_in(rng, -2.5, 2.5), random_in(rng, 0.5, 8.5)};
+}
+
+ShapeSet random_obstacles(PlanningRng* rng, int count) {
+    ShapeSet obstacles;
+    for (int i = 0; i < count; i++) {
+        obstacles.add(std::make_shared<Circle>(random_point(rng), kRobotRadius));
+    }
+    return obstacles;
+}
+
+/**
+ * A plausible request for the named planner: our robot somewhere on the
+ * field, a few opponents, and a ball that is moving for the planners that
+ * chase one.
+ */
+RecordedPlanRequest synthetic_request(PlanningRng* rng, const std::string& planner) {
+    RecordedPlanRequest record;
+    const RJ::Time now = RJ::now();
+
+    record.shell_id = 0;
+    record.start = RobotInstant{Pose{random_point(rng), random_in(rng, -M_PI, M_PI)},
+                                Twist{Point{random_in(rng, -1, 1), random_in(rng, -1, 1)}, 0},
+                                now};
+
+    WorldState& world = record.world_state;
+    world.last_updated_time = now;
+    world.our_robots.at(record.shell_id) = RobotState{record.start.pose, record.start.velocity,
+                                                      now, true};
+    for (int shell = 0; shell < 6; shell++) {
+        world.their_robots.at(shell) =
+            RobotState{Pose{random_point(rng), 0}, Twist::zero(), now, true};
+    }
+
+    const bool moving_ball = planner == "settle" || planner == "intercept";
+    const Point ball_velocity =
+        moving_ball ? Point{random_in(rng, -1, 1), random_in(rng, -3, -1)} : Point{};
+    world.ball = BallState{random_point(rng), ball_velocity, now};
+
+    record.field_obstacles = random_obstacles(rng, 4);
+
+    MotionCommand& command = record.motion_command;
+    command.name = planner;
+    command.target = LinearMotionInstant{random_point(rng)};
+    command.pivot_point = world.ball.position;
+    if (planner == "line_kick" || planner == "pivot") {
+        command.target = LinearMotionInstant{Point{0, 9}};
+    }
+
+    // The escape planner only does work when the robot starts in an obstacle.
+    if (planner == "halt") {
+        record.field_obstacles.add(std::make_shared<Circle>(record.start.position(), 0.3));
+    }
+
+    return record;
+}
+
+void build_synthetic_corpus() {
+    PlanningRng rng(kCorpusSeed);
+    for (const char* planner : {"path_target", "settle", "collect", "line_kick", "pivot",
+                                "intercept", "halt"}) {
+        auto& requests = corpus[planner];
+        for (int i = 0; i < kSyntheticRequestsPerPlanner; i++) {
+            requests.push_back(synthetic_request(&rng, planner));
+        }
+    }
+}
+
+void load_corpus(const std::string& path) {
+    for (RecordedPlanRequest& record : read_plan_requests(path)) {
+        corpus[record.motion_command.name].push_back(std::move(record));
+    }
+}
+
+/**
+ * Replay the corpus for one planner. Requests are replayed in order through a
+ * single planner instance (as on the field, where planners keep state between
+ * frames), shifted in time so they look current.
+ */
+template <typename Planner>
+void bm_planner(benchmark::State& state, const std::string& name) {
+    const auto it = corpus.find(name);
+    if (it == corpus.end() || it->second.empty()) {
+        state.SkipWithError(("no requests for planner " + name).c_str());
+        return;
+    }
+
+    std::vector<RecordedPlanRequest>& requests = it->second;
+    Planner planner;
+    PlanningRng rng(kCorpusSeed);
+    PlanningRng::ScopedBinding bind_rng(&rng);
+
+    size_t next = 0;
+    run_timed(state, [&]() {
+        RecordedPlanRequest& record = requests[next];
+        next = (next + 1) % requests.size();
+        if (next == 0) {
+            planner.reset();
+        }
+
+        record.shift_time(RJ::now() - record.start.stamp);
+        benchmark::DoNotOptimize(planner.plan(record.make_request()));
+    });
+}
+
+// A path across the field that has to go around a wall of robots.
+struct RrtProblem {
+    LinearMotionInstant start{Point{-2, 1}};
+    LinearMotionInstant goal{Point{2, 7}};
+    ShapeSet obstacles;
+
+    RrtProblem() {
+        for (int i = 0; i < 8; i++) {
+            obstacles.add(std::make_shared<Circle>(Point{-2.0 + 0.45 * i, 4}, kRobotRadius));
+        }
+    }
+};
+
+void bm_create_path_rrt(benchmark::State& state) {
+    RrtProblem problem;
+    PlanningRng rng(kCorpusSeed);
+    run_timed(state, [&]() {
+        benchmark::DoNotOptimize(CreatePath::rrt(problem.start, problem.goal, MotionConstraints{},
+                                                 RJ::now(), problem.obstacles, {}, {}, &rng));
+    });
+}
+
+void bm_profile_velocity(benchmark::State& state) {
+    const int num_points = static_cast<int>(state.range(0));
+    PlanningRng rng(kCorpusSeed);
+    std::vector<Point> points;
+    for (int i = 0; i < num_points; i++) {
+        points.push_back(random_point(&rng));
+    }
+    MotionConstraints constraints;
+    BezierPath path(points, Point{}, Point{}, constraints);
+
+    run_timed(state, [&]() {
+        benchmark::DoNotOptimize(profile_velocity(path, 0, 0, constraints, RJ::now()));
+    });
+}
+
+void bm_profile_velocity_batch(benchmark::State& state) {
+    const int num_paths = static_cast<int>(state.range(0));
+    constexpr int kPointsPerPath = 8;
+    PlanningRng rng(kCorpusSeed);
+    MotionConstraints constraints;
+    std::vector<BezierPath> paths;
+    for (int i = 0; i < num_paths; i++) {
+        std::vector<Point> points;
+        for (int j = 0; j < kPointsPerPath; j++) {
+            points.push_back(random_point(&rng));
+        }
+        paths.emplace_back(points, Point{}, Point{}, constraints);
+    }
+
+    std::vector<VelocityProfiler::Request> requests;
+    for (const BezierPath& path : paths) {
+        requests.push_back({&path, 0, 0});
+    }
+
+    VelocityProfiler profiler;
+    run_timed(state, [&]() {
+        benchmark::DoNotOptimize(profiler.profile_many(requests, constraints, RJ::now()));
+    });
+}
+
+Trajectory rrt_trajectory(RJ::Time start_time) {
+    RrtProblem problem;
+    PlanningRng rng(kCorpusSeed);
+    return CreatePath::rrt(problem.start, problem.goal, MotionConstraints{}, start_time,
+                           problem.obstacles, {}, {}, &rng);
+}
+
+// Sample a trajectory every 10ms, either one evaluate() at a time (arg 0) or
+// with a single evaluate_many() (arg 1).
+void bm_trajectory_sample(benchmark::State& state) {
+    const bool batched = state.range(0) != 0;
+    const RJ::Time start_time = RJ::now();
+    const Trajectory trajectory = rrt_trajectory(start_time);
+    constexpr RJ::Seconds kDt{0.01};
+    const auto num_samples = static_cast<size_t>(trajectory.duration() / kDt);
+    std::vector<RobotInstant> samples(num_samples);
+
+    run_timed(state, [&]() {
+        if (batched) {
+            trajectory.evaluate_many(start_time, kDt, num_samples, samples.data());
+        } else {
+            for (size_t i = 0; i < num_samples; i++) {
+                samples[i] = *trajectory.evaluate(start_time + kDt * static_cast<double>(i));
+            }
+        }
+        benchmark::DoNotOptimize(samples.data());
+    });
+}
+
+void bm_trajectory_hits_static(benchmark::State& state) {
+    const RJ::Time start_time = RJ::now();
+    const Trajectory trajectory = rrt_trajectory(start_time);
+    PlanningRng rng(kCorpusSeed);
+    const ShapeSet obstacles = random_obstacles(&rng, static_cast<int>(state.range(0)));
+
+    run_timed(state, [&]() {
+        RJ::Time hit_time;
+        benchmark::DoNotOptimize(
+            trajectory_hits_static(trajectory, obstacles, start_time, &hit_time));
+    });
+}
+
+void bm_trajectory_hits_dynamic(benchmark::State& state) {
+    const RJ::Time start_time = RJ::now();
+    const Trajectory trajectory = rrt_trajectory(start_time);
+
+    // Other robots crossing the field in straight lines.
+    PlanningRng rng(kCorpusSeed);
+    std::vector<Trajectory> paths;
+    for (int i = 0; i < state.range(0); i++) {
+        paths.push_back(CreatePath::simple(LinearMotionInstant{random_point(&rng)},
+                                           LinearMotionInstant{random_point(&rng)},
+                                           MotionConstraints{}, start_time));
+    }
+    std::vector<DynamicObstacle> obstacles;
+    for (const Trajectory& path : paths) {
+        obstacles.emplace_back(kRobotRadius, &path);
+    }
+
+    run_timed(state, [&]() {
+        Circle hit_circle;
+        RJ::Time hit_time;
+        benchmark::DoNotOptimize(
+            trajectory_hits_dynamic(trajectory, obstacles, start_time, &hit_circle, &hit_time));
+    });
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(bm_planner<PathTargetPathPlanner>, path_target, "path_target");
+BENCHMARK_CAPTURE(bm_planner<SettlePathPlanner>, settle, "settle");
+BENCHMARK_CAPTURE(bm_planner<CollectPathPlanner>, collect, "collect");
+BENCHMARK_CAPTURE(bm_planner<LineKickPathPlanner>, line_kick, "line_kick");
+BENCHMARK_CAPTURE(bm_planner<PivotPathPlanner>, pivot, "pivot");
+BENCHMARK_CAPTURE(bm_planner<InterceptPathPlanner>, intercept, "intercept");
+BENCHMARK_CAPTURE(bm_planner<EscapeObstaclesPathPlanner>, escape_obstacles, "halt");
+BENCHMARK(bm_create_path_rrt);
+BENCHMARK(bm_profile_velocity)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(bm_profile_velocity_batch)->Arg(1)->Arg(10);
+BENCHMARK(bm_trajectory_sample)->Arg(0)->Arg(1);
+BENCHMARK(bm_trajectory_hits_static)->Arg(8)->Arg(64);
+BENCHMARK(bm_trajectory_hits_dynamic)->Arg(1)->Arg(6);
+
+int main(int argc, char** argv) {
+    // Pull out our own flags before handing the rest to Google Benchmark.
+    std::vector<char*> benchmark_args;
+    bool have_corpus = false;
+    const std::string corpus_flag = "--corpus=";
+    for (int i = 0; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind(corpus_flag, 0) == 0) {
+            load_corpus(arg.substr(corpus_flag.size()));
+            have_corpus = true;
+        } else {
+            benchmark_args.push_back(argv[i]);
+        }
+    }
+    if (!have_corpus) {
+        build_synthetic_corpus();
+    }
+
+    int benchmark_argc = static_cast<int>(benchmark_args.size());
+    benchmark::Initialize(&benchmark_argc, benchmark_args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmark_argc, benchmark_args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
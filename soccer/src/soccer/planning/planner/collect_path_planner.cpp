@@ -212,6 +212,8 @@ Trajectory CollectPathPlanner::coarse_approach(
                                  dynamic_obstacles,
                                  plan_request.constraints,
                                  AngleFns::face_point(ball.position)};
+    params.deadline = plan_request.deadline;
+    params.cache = &plan_cache_;
     Trajectory coarse_path = Replanner::create_plan(params, previous_);
 
     if (plan_request.debug_drawer != nullptr) {
@@ -352,8 +354,9 @@ Trajectory CollectPathPlanner::control(const PlanRequest& plan_request, RobotIns
     // Try to use the RRTPathPlanner to generate the path first
     // It reaches the target better for some reason
     std::vector<Point> start_end_points{start.position(), target.position};
-    Trajectory path = CreatePath::rrt(start.linear_motion(), target, motion_constraints,
-                                      start.stamp, static_obstacles, dynamic_obstacles);
+    Trajectory path =
+        CreatePath::rrt(start.linear_motion(), target, motion_constraints, start.stamp,
+                        static_obstacles, dynamic_obstacles, {}, nullptr, plan_request.deadline);
 
     if (plan_request.debug_drawer != nullptr) {
         plan_request.debug_drawer->draw_segment(
@@ -397,6 +400,8 @@ Trajectory CollectPathPlanner::invalid(const PlanRequest& plan_request,
         plan_request.start,       target,
         static_obstacles,         dynamic_obstacles,
         plan_request.constraints, AngleFns::face_point(plan_request.world_state->ball.position)};
+    params.deadline = plan_request.deadline;
+    params.cache = &plan_cache_;
     Trajectory path = Replanner::create_plan(params, previous_);
     path.set_debug_text("Invalid state in collect");
 
@@ -405,6 +410,7 @@ Trajectory CollectPathPlanner::invalid(const PlanRequest& plan_request,
 
 void CollectPathPlanner::reset() {
     previous_ = Trajectory();
+    plan_cache_.clear();
     current_state_ = CollectPathPathPlannerStates::CoarseApproach;
     average_ball_vel_initialized_ = false;
     approach_direction_created_ = false;
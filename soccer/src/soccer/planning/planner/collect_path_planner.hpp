@@ -61,6 +61,7 @@ private:
                        const std::vector<DynamicObstacle>& dynamic_obstacles);
 
     Trajectory previous_;
+    PlanCache plan_cache_;
 
     CollectPathPathPlannerStates current_state_ = CollectPathPathPlannerStates::CoarseApproach;
 
@@ -51,6 +51,7 @@ Trajectory EscapeObstaclesPathPlanner::plan(const PlanRequest& plan_request) {
 Point EscapeObstaclesPathPlanner::find_non_blocked_goal(Point goal, std::optional<Point> prev_goal,
                                                         const ShapeSet& obstacles, int max_itr) {
     if (obstacles.hit(goal)) {
+        // samples from PlanningRng::current(), i.e. this robot's generator
         auto state_space =
             std::make_shared<RoboCupStateSpace>(FieldDimensions::current_dimensions, obstacles);
         RRT::Tree<Point> rrt(state_space, Point::hash, 2);
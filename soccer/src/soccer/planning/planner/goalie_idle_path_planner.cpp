@@ -31,7 +31,8 @@ Trajectory GoalieIdlePathPlanner::plan(const PlanRequest& plan_request) {
     // call Replanner to generate a Trajectory
     Trajectory trajectory = Replanner::create_plan(
         Replanner::PlanParams{plan_request.start, target, static_obstacles, dynamic_obstacles,
-                              plan_request.constraints, angle_function, RJ::Seconds(3.0)},
+                              plan_request.constraints, angle_function, RJ::Seconds(3.0),
+                              plan_request.deadline, &plan_cache_},
         std::move(previous_));
 
     // Debug drawing
@@ -58,7 +59,7 @@ rj_geometry::Point GoalieIdlePathPlanner::get_idle_pt(const WorldState* world_st
     return idle_pt;
 }
 
-void GoalieIdlePathPlanner::reset() {}
+void GoalieIdlePathPlanner::reset() { plan_cache_.clear(); }
 
 bool GoalieIdlePathPlanner::is_done() const { return false; }
 
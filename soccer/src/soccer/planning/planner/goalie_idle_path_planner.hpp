@@ -42,6 +42,7 @@ public:
 
 private:
     Trajectory previous_{};
+    PlanCache plan_cache_;
 };
 
 }  // namespace planning
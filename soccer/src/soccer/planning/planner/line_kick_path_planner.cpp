@@ -119,6 +119,8 @@ Trajectory LineKickPathPlanner::plan(const PlanRequest& plan_request) {
                 dynamic_obstacles,
                 plan_request.constraints,
                 AngleFns::face_angle(ball.position.angle_to(command.target.position))};
+            params.deadline = plan_request.deadline;
+            params.cache = &plan_cache_;
             path = Replanner::create_plan(params, prev_path_);
             path.set_debug_text("slow ball 1");
         } else {
@@ -140,6 +142,8 @@ Trajectory LineKickPathPlanner::plan(const PlanRequest& plan_request) {
                                          dynamic_obstacles,
                                          plan_request.constraints,
                                          AngleFns::face_point(command.target.position)};
+            params.deadline = plan_request.deadline;
+            params.cache = &plan_cache_;
             path = Replanner::create_plan(params, prev_path_);
             path.set_debug_text("slow ball 2");
         }
@@ -169,6 +173,8 @@ Trajectory LineKickPathPlanner::plan(const PlanRequest& plan_request) {
                                          dynamic_obstacles,
                                          plan_request.constraints,
                                          AngleFns::face_point(command.target.position)};
+            params.deadline = plan_request.deadline;
+            params.cache = &plan_cache_;
             Trajectory path = Replanner::create_plan(params, prev_path_);
 
             if (!path.empty()) {
@@ -261,6 +267,8 @@ Trajectory LineKickPathPlanner::plan(const PlanRequest& plan_request) {
                                  dynamic_obstacles,
                                  plan_request.constraints,
                                  AngleFns::face_point(command.target.position)};
+    params.deadline = plan_request.deadline;
+    params.cache = &plan_cache_;
     Trajectory path = Replanner::create_plan(params, prev_path_);
 
     path.set_debug_text("Approaching cautious");
@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "planning/planner/path_planner.hpp"
+#include "planning/primitives/plan_cache.hpp"
 #include "planning/trajectory.hpp"
 
 class Configuration;
@@ -29,6 +30,7 @@ public:
 
     void reset() override {
         prev_path_ = {};
+        plan_cache_.clear();
         final_approach_ = false;
         target_kick_pos_ = std::nullopt;
         reuse_path_count_ = 0;
@@ -37,6 +39,7 @@ public:
 
 private:
     Trajectory prev_path_;
+    PlanCache plan_cache_;
     bool final_approach_ = false;
     std::optional<rj_geometry::Point> target_kick_pos_;
     int reuse_path_count_ = 0;
@@ -37,7 +37,10 @@ public:
     PathTargetPathPlanner& operator=(const PathTargetPathPlanner&) = default;
 
     Trajectory plan(const PlanRequest& request) override;
-    void reset() override { previous_ = Trajectory(); }
+    void reset() override {
+        previous_ = Trajectory();
+        plan_cache_.clear();
+    }
 
     [[nodiscard]] bool is_done() const override;
 
@@ -54,6 +57,7 @@ private:
     [[nodiscard]] static AngleFunction get_angle_function(const PlanRequest& request);
 
     Trajectory previous_;
+    PlanCache plan_cache_;
 
     // vars to tell if is_done
     std::optional<LinearMotionInstant> cached_start_instant_;
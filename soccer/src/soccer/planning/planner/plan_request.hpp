@@ -113,6 +113,13 @@ struct PlanRequest {
      * Dribbler Speed
      */
     float dribbler_speed = 0;
+
+    /**
+     * Time by which planning for this request should be finished. Planners
+     * that search (e.g. with an RRT) stop and return the best result found so
+     * far once it has passed.
+     */
+    RJ::Time deadline = RJ::Time::max();
 };
 
 /**
@@ -0,0 +1,129 @@
+#include "plan_request_log.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace planning {
+
+namespace {
+
+void encode_length(uint32_t length, std::array<char, 4>* out) {
+    for (size_t i = 0; i < out->size(); i++) {
+        (*out)[i] = static_cast<char>((length >> (8 * i)) & 0xff);
+    }
+}
+
+uint32_t decode_length(const std::array<char, 4>& bytes) {
+    uint32_t length = 0;
+    for (size_t i = 0; i < bytes.size(); i++) {
+        length |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    }
+    return length;
+}
+
+}  // namespace
+
+RecordedPlanRequest RecordedPlanRequest::from_request(const PlanRequest& request) {
+    RecordedPlanRequest result;
+    result.start = request.start;
+    result.motion_command = request.motion_command;
+    result.constraints = request.constraints;
+    result.field_obstacles = request.field_obstacles;
+    result.virtual_obstacles = request.virtual_obstacles;
+    result.shell_id = request.shell_id;
+    if (request.world_state != nullptr) {
+        result.world_state = *request.world_state;
+    }
+    result.priority = request.priority;
+    result.ball_sense = request.ball_sense;
+    result.min_dist_from_ball = request.min_dist_from_ball;
+    result.dribbler_speed = request.dribbler_speed;
+    return result;
+}
+
+PlanRequest RecordedPlanRequest::make_request() const {
+    return PlanRequest{start,
+                       motion_command,
+                       constraints,
+                       field_obstacles,
+                       virtual_obstacles,
+                       nullptr,
+                       shell_id,
+                       &world_state,
+                       priority,
+                       nullptr,
+                       ball_sense,
+                       min_dist_from_ball,
+                       dribbler_speed};
+}
+
+void RecordedPlanRequest::shift_time(RJ::Seconds offset) {
+    start.stamp = start.stamp + offset;
+    world_state.last_updated_time = world_state.last_updated_time + offset;
+    world_state.ball.timestamp = world_state.ball.timestamp + offset;
+    for (auto* robots : {&world_state.our_robots, &world_state.their_robots}) {
+        for (RobotState& robot : *robots) {
+            robot.timestamp = robot.timestamp + offset;
+        }
+    }
+}
+
+PlanRequestWriter::PlanRequestWriter(const std::string& path)
+    : path_(path), buffer_(kBufferSize) {
+    // The buffer has to be in place before the file is opened.
+    file_.rdbuf()->pubsetbuf(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.open(path, std::ios::binary | std::ios::app);
+    if (!file_) {
+        throw std::runtime_error("Could not open plan request log " + path);
+    }
+}
+
+void PlanRequestWriter::write(const PlanRequest& request) {
+    const auto msg = rj_convert::convert_to_ros(RecordedPlanRequest::from_request(request));
+
+    rclcpp::SerializedMessage serialized;
+    serialization_.serialize_message(&msg, &serialized);
+    const auto& buffer = serialized.get_rcl_serialized_message();
+
+    std::array<char, 4> length{};
+    encode_length(static_cast<uint32_t>(buffer.buffer_length), &length);
+    file_.write(length.data(), length.size());
+    file_.write(reinterpret_cast<const char*>(buffer.buffer), buffer.buffer_length);
+    if (!file_.good()) {
+        throw std::runtime_error("Could not write plan request log " + path_);
+    }
+}
+
+std::vector<RecordedPlanRequest> read_plan_requests(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not open plan request log " + path);
+    }
+
+    rclcpp::Serialization<RecordedPlanRequest::Msg> serialization;
+    std::vector<RecordedPlanRequest> result;
+
+    std::array<char, 4> length_bytes{};
+    while (file.read(length_bytes.data(), length_bytes.size())) {
+        const uint32_t length = decode_length(length_bytes);
+
+        rclcpp::SerializedMessage serialized(length);
+        auto& buffer = serialized.get_rcl_serialized_message();
+        if (!file.read(reinterpret_cast<char*>(buffer.buffer), length)) {
+            throw std::runtime_error("Truncated plan request log " + path);
+        }
+        buffer.buffer_length = length;
+
+        RecordedPlanRequest::Msg msg;
+        serialization.deserialize_message(&serialized, &msg);
+        result.push_back(rj_convert::convert_from_ros(msg));
+    }
+
+    if (file.gcount() != 0) {
+        throw std::runtime_error("Truncated plan request log " + path);
+    }
+
+    return result;
+}
+
+}  // namespace planning
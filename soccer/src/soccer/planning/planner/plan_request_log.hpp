@@ -0,0 +1,139 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <rclcpp/serialization.hpp>
+
+#include <rj_convert/ros_convert.hpp>
+#include <rj_geometry/geometry_conversions.hpp>
+#include <rj_msgs/msg/plan_request.hpp>
+
+#include "plan_request.hpp"
+#include "planning/instant.hpp"
+#include "planning/planner/motion_command.hpp"
+#include "world_state.hpp"
+
+namespace planning {
+
+/**
+ * @brief A PlanRequest together with everything it points to, so that it can
+ * be stored and replayed offline (e.g. by the planning benchmarks).
+ *
+ * Planned trajectories and the debug drawer are not recorded.
+ */
+struct RecordedPlanRequest {
+    using Msg = rj_msgs::msg::PlanRequest;
+
+    RobotInstant start;
+    MotionCommand motion_command;
+    RobotConstraints constraints;
+    rj_geometry::ShapeSet field_obstacles;
+    rj_geometry::ShapeSet virtual_obstacles;
+    unsigned shell_id = 0;
+    WorldState world_state;
+    int8_t priority = 0;
+    bool ball_sense = false;
+    float min_dist_from_ball = 0;
+    float dribbler_speed = 0;
+
+    /**
+     * @brief Copy a live request, including the world state it points to.
+     */
+    static RecordedPlanRequest from_request(const PlanRequest& request);
+
+    /**
+     * @brief Build a PlanRequest that refers to this record. The record must
+     * outlive the returned request.
+     */
+    [[nodiscard]] PlanRequest make_request() const;
+
+    /**
+     * @brief Shift every timestamp in the record by @offset, e.g. to replay a
+     * recording as if it had happened just now.
+     */
+    void shift_time(RJ::Seconds offset);
+};
+
+/**
+ * @brief Appends PlanRequests to a file, for later replay with
+ * read_plan_requests().
+ *
+ * The file is a sequence of records, each a little-endian uint32 length
+ * followed by a CDR-serialized rj_msgs::msg::PlanRequest.
+ *
+ * Records are buffered and only reach the disk when the buffer fills or the
+ * writer is destroyed, so that recording doesn't stall the planning thread.
+ */
+class PlanRequestWriter {
+public:
+    static constexpr size_t kBufferSize = 1 << 20;
+
+    /**
+     * @throws std::runtime_error if @path can't be opened.
+     */
+    explicit PlanRequestWriter(const std::string& path);
+
+    /**
+     * @throws std::runtime_error if the file can't be written.
+     */
+    void write(const PlanRequest& request);
+
+private:
+    std::string path_;
+    // Declared before file_ so that it outlives file_'s final flush.
+    std::vector<char> buffer_;
+    std::ofstream file_;
+    rclcpp::Serialization<RecordedPlanRequest::Msg> serialization_;
+};
+
+/**
+ * @brief Read every request in a file written by PlanRequestWriter.
+ *
+ * @throws std::runtime_error if @path can't be opened or is truncated.
+ */
+std::vector<RecordedPlanRequest> read_plan_requests(const std::string& path);
+
+}  // namespace planning
+
+namespace rj_convert {
+
+template <>
+struct RosConverter<planning::RecordedPlanRequest, planning::RecordedPlanRequest::Msg> {
+    static planning::RecordedPlanRequest::Msg to_ros(const planning::RecordedPlanRequest& from) {
+        planning::RecordedPlanRequest::Msg result;
+        convert_to_ros(from.start, &result.start);
+        convert_to_ros(from.motion_command, &result.motion_command);
+        result.max_speed = from.constraints.mot.max_speed;
+        convert_to_ros(from.field_obstacles, &result.field_obstacles);
+        convert_to_ros(from.virtual_obstacles, &result.virtual_obstacles);
+        result.shell_id = static_cast<uint8_t>(from.shell_id);
+        convert_to_ros(from.world_state, &result.world_state);
+        result.priority = from.priority;
+        result.ball_sense = from.ball_sense;
+        result.min_dist_from_ball = from.min_dist_from_ball;
+        result.dribbler_speed = from.dribbler_speed;
+        return result;
+    }
+
+    static planning::RecordedPlanRequest from_ros(const planning::RecordedPlanRequest::Msg& from) {
+        planning::RecordedPlanRequest result;
+        convert_from_ros(from.start, &result.start);
+        convert_from_ros(from.motion_command, &result.motion_command);
+        result.constraints.mot.max_speed = from.max_speed;
+        convert_from_ros(from.field_obstacles, &result.field_obstacles);
+        convert_from_ros(from.virtual_obstacles, &result.virtual_obstacles);
+        result.shell_id = from.shell_id;
+        convert_from_ros(from.world_state, &result.world_state);
+        result.priority = from.priority;
+        result.ball_sense = from.ball_sense;
+        result.min_dist_from_ball = from.min_dist_from_ball;
+        result.dribbler_speed = from.dribbler_speed;
+        return result;
+    }
+};
+
+ASSOCIATE_CPP_ROS(planning::RecordedPlanRequest, planning::RecordedPlanRequest::Msg);
+
+}  // namespace rj_convert
@@ -186,6 +186,11 @@ Trajectory SettlePathPlanner::intercept(const PlanRequest& plan_request, RobotIn
                   settle::PARAM_search_inc_dist);
 
     for (int iteration = 0; iteration < num_iterations; iteration++) {
+        // Out of time: go with the best intercept found so far.
+        if (iteration > 0 && RJ::now() >= plan_request.deadline) {
+            break;
+        }
+
         double dist = settle::PARAM_search_start_dist + iteration * settle::PARAM_search_inc_dist;
         // Time for ball to reach the target point
         std::optional<RJ::Seconds> maybe_ball_time = ball.query_seconds_to_dist(dist);
@@ -217,7 +222,8 @@ Trajectory SettlePathPlanner::intercept(const PlanRequest& plan_request, RobotIn
         // test location
         Trajectory path = CreatePath::rrt(start_instant.linear_motion(), target_robot_intersection,
                                           plan_request.constraints.mot, start_instant.stamp,
-                                          static_obstacles, dynamic_obstacles);
+                                          static_obstacles, dynamic_obstacles, {}, nullptr,
+                                          plan_request.deadline);
 
         // Calculate the
         RJ::Seconds buffer_duration = ball_time - path.duration();
@@ -328,7 +334,8 @@ Trajectory SettlePathPlanner::intercept(const PlanRequest& plan_request, RobotIn
 
         Trajectory shortcut =
             CreatePath::rrt(start_instant.linear_motion(), target, plan_request.constraints.mot,
-                            start_instant.stamp, static_obstacles, dynamic_obstacles);
+                            start_instant.stamp, static_obstacles, dynamic_obstacles, {}, nullptr,
+                            plan_request.deadline);
 
         if (!shortcut.empty()) {
             plan_angles(&shortcut, start_instant, AngleFns::face_point(face_pos),
@@ -358,6 +365,8 @@ Trajectory SettlePathPlanner::intercept(const PlanRequest& plan_request, RobotIn
     Replanner::PlanParams params{
         start_instant,     target_robot_intersection, static_obstacles,
         dynamic_obstacles, plan_request.constraints,  AngleFns::face_point(face_pos)};
+    params.deadline = plan_request.deadline;
+    params.cache = &plan_cache_;
     Trajectory new_target_path = Replanner::create_plan(params, previous_);
 
     RJ::Seconds time_of_arrival = new_target_path.duration();
@@ -483,6 +492,8 @@ Trajectory SettlePathPlanner::invalid(const PlanRequest& plan_request,
         plan_request.start,       target,
         static_obstacles,         dynamic_obstacles,
         plan_request.constraints, AngleFns::face_point(plan_request.world_state->ball.position)};
+    params.deadline = plan_request.deadline;
+    params.cache = &plan_cache_;
     Trajectory path = Replanner::create_plan(params, previous_);
     path.set_debug_text("Invalid state in settle");
     return path;
@@ -535,6 +546,7 @@ void SettlePathPlanner::reset() {
     path_created_for_dampen_ = false;
     target_bounce_direction_ = std::nullopt;
     previous_ = Trajectory{};
+    plan_cache_.clear();
 }
 
 bool SettlePathPlanner::is_done() const {
@@ -93,5 +93,6 @@ private:
     bool path_created_for_dampen_ = false;
 
     Trajectory previous_;
+    PlanCache plan_cache_;
 };
 }  // namespace planning
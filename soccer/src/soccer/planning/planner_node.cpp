@@ -1,9 +1,12 @@
 #include "planner_node.hpp"
 
 #include <boost/algorithm/string.hpp>
+#include <rclcpp_components/register_node_macro.hpp>
 #include <spdlog/spdlog.h>
 
 #include <rj_constants/topic_names.hpp>
+#include <rj_utils/intra_process.hpp>
+#include <rj_utils/latency_recorder.hpp>
 #include <ros_debug_drawer.hpp>
 
 #include "instant.hpp"
@@ -21,8 +24,8 @@ namespace planning {
 using RobotMove = rj_msgs::action::RobotMove;
 using GoalHandleRobotMove = rclcpp_action::ServerGoalHandle<RobotMove>;
 
-PlannerNode::PlannerNode()
-    : rclcpp::Node("planner", rclcpp::NodeOptions{}
+PlannerNode::PlannerNode(const rclcpp::NodeOptions& options)
+    : rclcpp::Node("planner", rclcpp::NodeOptions{options}
                                   .automatically_declare_parameters_from_overrides(true)
                                   .allow_undeclared_parameters(true)),
       global_state_(this),
@@ -45,28 +48,29 @@ PlannerNode::PlannerNode()
             std::make_unique<PlannerForRobot>(i, this, &robot_trajectories_, global_state_);
         robot_planners_.emplace_back(std::move(planner));
     }
+
+    frame_thread_ = std::thread{&PlannerNode::frame_loop, this};
+}
+
+PlannerNode::~PlannerNode() {
+    stop_frame_loop_ = true;
+    if (frame_thread_.joinable()) {
+        frame_thread_.join();
+    }
 }
 
 rclcpp_action::GoalResponse PlannerNode::handle_goal(const rclcpp_action::GoalUUID& uuid,
                                                      std::shared_ptr<const RobotMove::Goal> goal) {
     (void)uuid;
-    auto delay = std::chrono::milliseconds(1000 / 60);
-    rclcpp::Rate loop_rate(delay);
 
     // TODO(p-nayak): REJECT duplicate goal requests so we aren't constantly replanning them
 
-    // planning::MotionCommand motion_command_ = goal->robot_intent.motion_command;
-
+    // A previous goal for the same robot doesn't block this one; it gets
+    // preempted by the frame thread once this goal is accepted.
     int robot_id = goal->robot_intent.robot_id;
-    auto& robot_task = server_task_states_.at(robot_id);
-    auto& is_executing = robot_task.is_executing;
-    auto& new_task_waiting_signal = robot_task.new_task_waiting_signal;
-    while (is_executing) {
-        new_task_waiting_signal = true;
-        loop_rate.sleep();
+    if (robot_id < 0 || robot_id >= static_cast<int>(kNumShells)) {
+        return rclcpp_action::GoalResponse::REJECT;
     }
-    new_task_waiting_signal = false;
-    is_executing = true;
     return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
 }
 
@@ -78,70 +82,114 @@ rclcpp_action::CancelResponse PlannerNode::handle_cancel(
 }
 
 void PlannerNode::handle_accepted(const std::shared_ptr<GoalHandleRobotMove> goal_handle) {
-    // this needs to return quickly to avoid blocking the executor, so spin up a new thread
-    // execute() will block (loop) until completion (either success or canceled by client)
-    using namespace std::placeholders;
-    std::thread{std::bind(&PlannerNode::execute, this, _1), goal_handle}.detach();
+    // this needs to return quickly to avoid blocking the executor, so just
+    // hand the goal off to the frame thread
+    int robot_id = goal_handle->get_goal()->robot_intent.robot_id;
+    auto& robot_task = server_task_states_.at(robot_id);
+
+    std::lock_guard<std::mutex> lock(robot_task.mutex);
+    if (robot_task.pending_goal != nullptr) {
+        robot_task.preempted_goals.push_back(std::move(robot_task.pending_goal));
+    }
+    robot_task.pending_goal = goal_handle;
 }
 
-void PlannerNode::execute(const std::shared_ptr<GoalHandleRobotMove> goal_handle) {
+void PlannerNode::frame_loop() {
     // TODO(Kevin): rate-limit loop to whatever hz planning is limited to
-    auto delay = std::chrono::milliseconds(1000 / 60);
-    rclcpp::Rate loop_rate(delay);
+    const auto frame_period = std::chrono::milliseconds(1000 / 60);
 
-    // create ptrs to Goal, Result objects per ActionServer API
-    std::shared_ptr<const RobotMove::Goal> goal = goal_handle->get_goal();
-    std::shared_ptr<RobotMove::Result> result = std::make_shared<RobotMove::Result>();
+    auto next_frame = std::chrono::steady_clock::now();
+    while (!stop_frame_loop_ && rclcpp::ok()) {
+        run_frame();
 
-    // get correct PlannerForRobot object for this robot_id
-    int robot_id = goal->robot_intent.robot_id;
-    // reference to unique_ptr to avoid transferring ownership
-    PlannerForRobot& my_robot_planner = *robot_planners_[robot_id];
+        // If planning overran the frame, start the next one right away
+        // instead of trying to catch up.
+        next_frame = std::max(next_frame + frame_period, std::chrono::steady_clock::now());
+        std::this_thread::sleep_until(next_frame);
+    }
+}
 
-    auto& robot_task = server_task_states_.at(robot_id);
+void PlannerNode::run_frame() {
+    const uint64_t frame_number = frame_number_++;
+
+    std::shared_ptr<RobotMove::Result> abort_result = std::make_shared<RobotMove::Result>();
+    abort_result->is_done = false;
 
-    // loop until goal is done (SUCCEEDED or CANCELED)
-    for (;;) {
-        auto& new_task_ready = robot_task.new_task_waiting_signal;
-        // check if there is a new goal
-        if (new_task_ready) {
-            result->is_done = false;
-            goal_handle->abort(result);
-            break;
+    // Pick up new goals, and collect the ones they replace.
+    std::vector<std::shared_ptr<GoalHandleRobotMove>> preempted;
+    for (auto& robot_task : server_task_states_) {
+        std::lock_guard<std::mutex> lock(robot_task.mutex);
+        for (auto& goal_handle : robot_task.preempted_goals) {
+            preempted.push_back(std::move(goal_handle));
         }
+        robot_task.preempted_goals.clear();
 
-        // if the ActionClient is trying to cancel the goal, cancel it & terminate early
-        if (goal_handle->is_canceling()) {
-            result->is_done = false;
-            goal_handle->canceled(result);
-            break;
+        if (robot_task.pending_goal != nullptr) {
+            if (robot_task.active_goal != nullptr) {
+                preempted.push_back(std::move(robot_task.active_goal));
+            }
+            robot_task.active_goal = std::move(robot_task.pending_goal);
+            robot_task.pending_goal = nullptr;
         }
+    }
 
-        // pub Trajectory based on the RobotIntent
-        my_robot_planner.execute_intent(rj_convert::convert_from_ros(goal->robot_intent));
+    for (const auto& goal_handle : preempted) {
+        goal_handle->abort(abort_result);
+    }
 
-        /*
-        // TODO (PR #1970): fix TrajectoryCollection
-        // send feedback
-        std::shared_ptr<RobotMove::Feedback> feedback = std::make_shared<RobotMove::Feedback>();
-        if (auto time_left = my_robot_planner.get_time_left()) {
-            feedback->time_left = rj_convert::convert_to_ros(time_left.value());
-            goal_handle->publish_feedback(feedback);
+    // Plan for every robot with a live goal. Each task only touches its own
+    // robot's PlannerForRobot.
+    std::vector<std::function<void()>> tasks;
+    for (size_t robot_id = 0; robot_id < kNumShells; robot_id++) {
+        auto& robot_task = server_task_states_[robot_id];
+        if (robot_task.active_goal == nullptr) {
+            continue;
         }
-        */
 
-        // when done, tell client goal is done, break loop
-        // TODO(p-nayak): when done, publish empty motion command to this robot's trajectory
-        if (my_robot_planner.is_done()) {
-            if (rclcpp::ok()) {
-                result->is_done = true;
-                goal_handle->succeed(result);
-                break;
-            }
+        // if the ActionClient is trying to cancel the goal, cancel it & terminate early
+        if (robot_task.active_goal->is_canceling()) {
+            robot_task.active_goal->canceled(abort_result);
+            robot_task.active_goal = nullptr;
+            continue;
+        }
+
+        PlannerForRobot& my_robot_planner = *robot_planners_[robot_id];
+        std::shared_ptr<const RobotMove::Goal> goal = robot_task.active_goal->get_goal();
+        tasks.emplace_back([&my_robot_planner, goal, frame_number]() {
+            // pub Trajectory based on the RobotIntent
+            my_robot_planner.execute_intent(rj_convert::convert_from_ros(goal->robot_intent),
+                                            frame_number);
+        });
+    }
+
+    try {
+        worker_pool_.run_all(tasks);
+    } catch (const std::exception& e) {
+        SPDLOG_ERROR("PlannerNode: uncaught exception while planning: {}", e.what());
+    }
+
+    /*
+    // TODO (PR #1970): fix TrajectoryCollection
+    // send feedback
+    std::shared_ptr<RobotMove::Feedback> feedback = std::make_shared<RobotMove::Feedback>();
+    if (auto time_left = my_robot_planner.get_time_left()) {
+        feedback->time_left = rj_convert::convert_to_ros(time_left.value());
+        goal_handle->publish_feedback(feedback);
+    }
+    */
+
+    // when done, tell client goal is done
+    // TODO(p-nayak): when done, publish empty motion command to this robot's trajectory
+    for (size_t robot_id = 0; robot_id < kNumShells; robot_id++) {
+        auto& robot_task = server_task_states_[robot_id];
+        if (robot_task.active_goal != nullptr && robot_planners_[robot_id]->is_done() &&
+            rclcpp::ok()) {
+            std::shared_ptr<RobotMove::Result> result = std::make_shared<RobotMove::Result>();
+            result->is_done = true;
+            robot_task.active_goal->succeed(result);
+            robot_task.active_goal = nullptr;
         }
-        loop_rate.sleep();
     }
-    robot_task.is_executing = false;
 }
 
 PlannerForRobot::PlannerForRobot(int robot_id, rclcpp::Node* node,
@@ -167,7 +215,8 @@ PlannerForRobot::PlannerForRobot(int robot_id, rclcpp::Node* node,
 
     // publish paths to control
     trajectory_topic_ = node_->create_publisher<Trajectory::Msg>(
-        planning::topics::trajectory_topic(robot_id), rclcpp::QoS(1).transient_local());
+        planning::topics::trajectory_topic(robot_id), rclcpp::QoS(1),
+        rj_utils::intra_process_publisher_options());
 
     // publish kicker/dribbler cmds directly to radio
     manipulator_pub_ = node->create_publisher<rj_msgs::msg::ManipulatorSetpoint>(
@@ -189,13 +238,34 @@ PlannerForRobot::PlannerForRobot(int robot_id, rclcpp::Node* node,
         });
 }
 
-void PlannerForRobot::execute_intent(const RobotIntent& intent) {
-    if (robot_alive()) {
-        // plan a path and send it to control
-        auto plan_request = make_request(intent);
+void PlannerForRobot::execute_intent(const RobotIntent& intent, uint64_t frame_number) {
+    // pin one consistent view of the global state for this whole cycle
+    const std::shared_ptr<const GlobalState::Snapshot> state = global_state_.snapshot();
+
+    // Every RRT run on this thread until we return samples from this robot's
+    // own generator, so robots planned in parallel never share RNG state.
+    if (rrt::PARAM_deterministic) {
+        rng_ = PlanningRng::for_robot(robot_id_, frame_number);
+    }
+    const PlanningRng::ScopedBinding bind_rng(&rng_);
 
-        auto trajectory = safe_plan_for_robot(plan_request);
-        trajectory_topic_->publish(rj_convert::convert_to_ros(trajectory));
+    if (robot_alive(*state)) {
+        // plan a path and send it to control
+        auto plan_request = make_request(intent, *state);
+        record_request(plan_request);
+        plan_request.deadline = RJ::now() + RJ::Seconds(rrt::PARAM_time_budget);
+
+        auto trajectory = safe_plan_for_robot(plan_request, *state);
+
+        // pass the world state's trace along so control can see where this came from
+        auto trajectory_msg =
+            std::make_unique<Trajectory::Msg>(rj_convert::convert_to_ros(trajectory));
+        trajectory_msg->trace = state->world_state->trace;
+        trajectory_msg->trace.t_planned = rj_convert::convert_to_ros(RJ::now());
+        rj_utils::LatencyRecorder::global().record(rj_utils::LatencyStage::kFilterToPlan,
+                                                   trajectory_msg->trace.t_filtered,
+                                                   trajectory_msg->trace.t_planned);
+        trajectory_topic_->publish(std::move(trajectory_msg));
 
         // send the kick/dribble commands to the radio
         manipulator_pub_->publish(rj_msgs::build<rj_msgs::msg::ManipulatorSetpoint>()
@@ -239,25 +309,44 @@ std::optional<RJ::Seconds> PlannerForRobot::get_time_left() const {
     return std::nullopt;
 }
 
-PlanRequest PlannerForRobot::make_request(const RobotIntent& intent) {
-    // pass global_state_ directly
-    const auto* world_state = global_state_.world_state();
-    const auto goalie_id = global_state_.goalie_id();
-    const auto play_state = global_state_.play_state();
-    const auto min_dist_from_ball = global_state_.coach_state().global_override.min_dist_from_ball;
-    const auto max_robot_speed = global_state_.coach_state().global_override.max_speed;
-    const auto max_dribbler_speed = global_state_.coach_state().global_override.max_dribbler_speed;
+void PlannerForRobot::record_request(const PlanRequest& request) {
+    if (bench::PARAM_record_path.empty() || recording_failed_) {
+        return;
+    }
+
+    try {
+        if (request_writer_ == nullptr) {
+            request_writer_ = std::make_unique<PlanRequestWriter>(
+                fmt::format("{}_{}.bin", bench::PARAM_record_path, robot_id_));
+        }
+        request_writer_->write(request);
+    } catch (const std::runtime_error& e) {
+        // Give up on the first failure instead of retrying (and warning) every
+        // frame.
+        SPDLOG_WARN("PlannerForRobot {}: stopped recording plan requests: {}", robot_id_,
+                    e.what());
+        request_writer_ = nullptr;
+        recording_failed_ = true;
+    }
+}
+
+PlanRequest PlannerForRobot::make_request(const RobotIntent& intent,
+                                          const GlobalState::Snapshot& state) {
+    // world_state points into the pinned snapshot, which outlives the request
+    const auto* world_state = state.world_state.get();
+    const auto goalie_id = state.goalie_id;
+    const auto min_dist_from_ball = state.coach_state.global_override.min_dist_from_ball;
+    const auto max_robot_speed = state.coach_state.global_override.max_speed;
+    const auto max_dribbler_speed = state.coach_state.global_override.max_dribbler_speed;
     const auto& robot = world_state->our_robots.at(robot_id_);
     const auto start = RobotInstant{robot.pose, robot.velocity, robot.timestamp};
 
-    const auto global_obstacles = global_state_.global_obstacles();
-    rj_geometry::ShapeSet real_obstacles = global_obstacles;
+    rj_geometry::ShapeSet real_obstacles = *state.global_obstacles;
 
-    const auto def_area_obstacles = global_state_.def_area_obstacles();
     rj_geometry::ShapeSet virtual_obstacles = intent.local_obstacles;
     const bool is_goalie = goalie_id == robot_id_;
     if (!is_goalie) {
-        virtual_obstacles.add(def_area_obstacles);
+        virtual_obstacles.add(*state.def_area_obstacles);
     }
 
     /*
@@ -348,7 +437,8 @@ Trajectory PlannerForRobot::unsafe_plan_for_robot(const planning::PlanRequest& r
     return trajectory;
 }
 
-Trajectory PlannerForRobot::safe_plan_for_robot(const planning::PlanRequest& request) {
+Trajectory PlannerForRobot::safe_plan_for_robot(const planning::PlanRequest& request,
+                                                const GlobalState::Snapshot& state) {
     Trajectory trajectory;
     try {
         trajectory = unsafe_plan_for_robot(request);
@@ -376,16 +466,16 @@ Trajectory PlannerForRobot::safe_plan_for_robot(const planning::PlanRequest& req
 
     // draw obstacles for this robot
     // TODO: these will stack atop each other, since each robot draws obstacles
-    debug_draw_.draw_shapes(global_state_.global_obstacles(), QColor(255, 0, 0, 30));
+    debug_draw_.draw_shapes(*state.global_obstacles, QColor(255, 0, 0, 30));
     debug_draw_.draw_shapes(request.virtual_obstacles, QColor(255, 0, 0, 30));
     debug_draw_.publish();
 
     return trajectory;
 }
 
-bool PlannerForRobot::robot_alive() const {
-    return global_state_.world_state()->our_robots.at(robot_id_).visible &&
-           RJ::now() < global_state_.world_state()->last_updated_time + RJ::Seconds(PARAM_timeout);
+bool PlannerForRobot::robot_alive(const GlobalState::Snapshot& state) const {
+    return state.world_state->our_robots.at(robot_id_).visible &&
+           RJ::now() < state.world_state->last_updated_time + RJ::Seconds(PARAM_timeout);
 }
 
 bool PlannerForRobot::is_done() const {
@@ -398,3 +488,5 @@ bool PlannerForRobot::is_done() const {
 }
 
 }  // namespace planning
+
+RCLCPP_COMPONENTS_REGISTER_NODE(planning::PlannerNode)
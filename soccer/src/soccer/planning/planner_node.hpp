@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -17,16 +20,21 @@
 #include <rj_msgs/msg/robot_status.hpp>
 #include <rj_msgs/srv/plan_hypothetical_path.hpp>
 #include <rj_param_utils/ros2_local_param_provider.hpp>
+#include <rj_utils/intra_process.hpp>
+#include <rj_utils/worker_pool.hpp>
 
 #include "node.hpp"
 #include "planner/path_planner.hpp"
 #include "planner/plan_request.hpp"
 #include "planning/planner/escape_obstacles_path_planner.hpp"
+#include "planning/planner/plan_request_log.hpp"
+#include "planning/primitives/planning_rng.hpp"
 #include "planning/trajectory_collection.hpp"
 #include "planning_params.hpp"
 #include "robot_intent.hpp"
 #include "trajectory.hpp"
 #include "world_state.hpp"
+#include "world_state_cache.hpp"
 
 namespace planning {
 
@@ -36,70 +44,104 @@ namespace planning {
  *
  * ("Global state" in quotes since many of these fields can be changed by other
  * nodes; however, to PlannerNode these are immutable.)
+ *
+ * Subscription callbacks never modify state in place. Each one copies the
+ * latest Snapshot, replaces its own field, and atomically publishes the
+ * result. Planner threads pin one Snapshot per planning cycle, so everything
+ * they read comes from a single consistent update.
  */
 class GlobalState {
 public:
+    /**
+     * An immutable view of everything GlobalState tracks. The large fields
+     * are shared between snapshots rather than copied.
+     */
+    struct Snapshot {
+        PlayState play_state = PlayState::halt();
+        GameSettings game_settings;
+        // -1 until the referee tells us who the goalie is
+        int goalie_id = -1;
+        std::shared_ptr<const rj_geometry::ShapeSet> global_obstacles =
+            std::make_shared<const rj_geometry::ShapeSet>();
+        std::shared_ptr<const rj_geometry::ShapeSet> def_area_obstacles =
+            std::make_shared<const rj_geometry::ShapeSet>();
+        std::shared_ptr<const WorldState> world_state = std::make_shared<const WorldState>();
+        rj_msgs::msg::CoachState coach_state;
+    };
+
     GlobalState(rclcpp::Node* node) {
         play_state_sub_ = node->create_subscription<rj_msgs::msg::PlayState>(
             referee::topics::kPlayStateTopic, rclcpp::QoS(1),
             [this](rj_msgs::msg::PlayState::SharedPtr state) {  // NOLINT
-                last_play_state_ = rj_convert::convert_from_ros(*state);
+                auto play_state = rj_convert::convert_from_ros(*state);
+                update([&](Snapshot* snapshot) { snapshot->play_state = play_state; });
             });
         game_settings_sub_ = node->create_subscription<rj_msgs::msg::GameSettings>(
             config_server::topics::kGameSettingsTopic, rclcpp::QoS(1),
             [this](rj_msgs::msg::GameSettings::SharedPtr settings) {  // NOLINT
-                last_game_settings_ = rj_convert::convert_from_ros(*settings);
+                auto game_settings = rj_convert::convert_from_ros(*settings);
+                update([&](Snapshot* snapshot) { snapshot->game_settings = game_settings; });
             });
         goalie_sub_ = node->create_subscription<rj_msgs::msg::Goalie>(
             referee::topics::kGoalieTopic, rclcpp::QoS(1),
             [this](rj_msgs::msg::Goalie::SharedPtr goalie) {  // NOLINT
-                last_goalie_id_ = goalie->goalie_id;
+                update([&](Snapshot* snapshot) { snapshot->goalie_id = goalie->goalie_id; });
             });
         global_obstacles_sub_ = node->create_subscription<rj_geometry_msgs::msg::ShapeSet>(
             planning::topics::kGlobalObstaclesTopic, rclcpp::QoS(1),
             [this](rj_geometry_msgs::msg::ShapeSet::SharedPtr global_obstacles) {  // NOLINT
-                last_global_obstacles_ = rj_convert::convert_from_ros(*global_obstacles);
+                auto obstacles = std::make_shared<const rj_geometry::ShapeSet>(
+                    rj_convert::convert_from_ros(*global_obstacles));
+                update([&](Snapshot* snapshot) {
+                    snapshot->global_obstacles = std::move(obstacles);
+                });
             });
         def_area_obstacles_sub_ = node->create_subscription<rj_geometry_msgs::msg::ShapeSet>(
             planning::topics::kDefAreaObstaclesTopic, rclcpp::QoS(1),
             [this](rj_geometry_msgs::msg::ShapeSet::SharedPtr def_area_obstacles) {  // NOLINT
-                last_def_area_obstacles_ = rj_convert::convert_from_ros(*def_area_obstacles);
+                auto obstacles = std::make_shared<const rj_geometry::ShapeSet>(
+                    rj_convert::convert_from_ros(*def_area_obstacles));
+                update([&](Snapshot* snapshot) {
+                    snapshot->def_area_obstacles = std::move(obstacles);
+                });
             });
         world_state_sub_ = node->create_subscription<rj_msgs::msg::WorldState>(
             vision_filter::topics::kWorldStateTopic, rclcpp::QoS(1),
-            [this](rj_msgs::msg::WorldState::SharedPtr world_state) {  // NOLINT
-                last_world_state_ = rj_convert::convert_from_ros(*world_state);
-            });
+            [this](rj_msgs::msg::WorldState::ConstSharedPtr world_state) {  // NOLINT
+                auto world = WorldStateCache::global().get(*world_state);
+                update([&](Snapshot* snapshot) { snapshot->world_state = std::move(world); });
+            },
+            rj_utils::intra_process_subscription_options());
         coach_state_sub_ = node->create_subscription<rj_msgs::msg::CoachState>(
             "/strategy/coach_state", rclcpp::QoS(1),
             [this](rj_msgs::msg::CoachState::SharedPtr coach_state) {  // NOLINT
-                last_coach_state_ = *coach_state;
+                update([&](Snapshot* snapshot) { snapshot->coach_state = *coach_state; });
             });
     }
 
-    [[nodiscard]] PlayState play_state() const {
-        return last_play_state_;
-    }
-    [[nodiscard]] GameSettings game_settings() const {
-        return last_game_settings_;
-    }
-    [[nodiscard]] int goalie_id() const {
-        return last_goalie_id_;
-    }
-    [[nodiscard]] rj_geometry::ShapeSet global_obstacles() const {
-        return last_global_obstacles_;
-    }
-    [[nodiscard]] rj_geometry::ShapeSet def_area_obstacles() const {
-        return last_def_area_obstacles_;
-    }
-    [[nodiscard]] const WorldState* world_state() const {
-        return &last_world_state_;
-    }
-    [[nodiscard]] const rj_msgs::msg::CoachState coach_state() const {
-        return last_coach_state_;
+    /**
+     * @return the latest published state. Hold on to the returned pointer for
+     * as long as anything derived from it (e.g. a PlanRequest's world_state)
+     * is in use.
+     */
+    [[nodiscard]] std::shared_ptr<const Snapshot> snapshot() const {
+        return std::atomic_load(&snapshot_);
     }
 
 private:
+    /**
+     * Publish a new snapshot: a copy of the current one, modified by @fn.
+     */
+    template <typename Fn>
+    void update(Fn&& fn) {
+        // Only writers take the lock, so that two callbacks on a
+        // multi-threaded executor can't drop each other's changes.
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        auto next = std::make_shared<Snapshot>(*std::atomic_load(&snapshot_));
+        fn(next.get());
+        std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)));
+    }
+
     rclcpp::Subscription<rj_msgs::msg::PlayState>::SharedPtr play_state_sub_;
     rclcpp::Subscription<rj_msgs::msg::GameSettings>::SharedPtr game_settings_sub_;
     rclcpp::Subscription<rj_msgs::msg::Goalie>::SharedPtr goalie_sub_;
@@ -108,13 +150,8 @@ private:
     rclcpp::Subscription<rj_msgs::msg::WorldState>::SharedPtr world_state_sub_;
     rclcpp::Subscription<rj_msgs::msg::CoachState>::SharedPtr coach_state_sub_;
 
-    PlayState last_play_state_ = PlayState::halt();
-    GameSettings last_game_settings_;
-    int last_goalie_id_;
-    rj_geometry::ShapeSet last_global_obstacles_;
-    rj_geometry::ShapeSet last_def_area_obstacles_;
-    WorldState last_world_state_;
-    rj_msgs::msg::CoachState last_coach_state_;
+    std::mutex update_mutex_;
+    std::shared_ptr<const Snapshot> snapshot_ = std::make_shared<const Snapshot>();
 };
 
 /**
@@ -144,8 +181,11 @@ public:
      *
      * Creates and publishes a Trajectory based on the given RobotIntent. Also
      * publishes a ManipulatorSetpoint to control kicker/dribbler/chipper.
+     *
+     * @param frame_number The planning frame this runs in. With
+     * rrt::PARAM_deterministic set, the RRT is seeded from it and the robot id.
      */
-    void execute_intent(const RobotIntent& intent);
+    void execute_intent(const RobotIntent& intent, uint64_t frame_number);
 
     /*
      * @brief estimate the amount of time it would take for a robot to execute a robot intent
@@ -180,10 +220,19 @@ private:
      * how a Pivot skill goes to PivotPath planner).
      *
      * @param intent RobotIntent msg
+     * @param state Global state pinned for this planning cycle; must outlive
+     * the returned PlanRequest
      *
      * @return PlanRequest based on input RobotIntent
      */
-    PlanRequest make_request(const RobotIntent& intent);
+    PlanRequest make_request(const RobotIntent& intent, const GlobalState::Snapshot& state);
+
+    /**
+     * @brief Append @request to this robot's plan request log, if recording is
+     * enabled with bench::PARAM_record_path. Recording stops for good after the
+     * first failure to open or write the log.
+     */
+    void record_request(const PlanRequest& request);
 
     /*
      * @brief Get a Trajectory based on the string name given in MotionCommand.
@@ -195,11 +244,13 @@ private:
      * Exceptions that come up.
      *
      * @param request PlanRequest to create a Trajectory from
+     * @param state Global state the request was made from
      *
      * @return Trajectory (timestamped series of poses & twists) that satisfies
      * the PlanRequest as well as possible
      */
-    Trajectory safe_plan_for_robot(const planning::PlanRequest& request);
+    Trajectory safe_plan_for_robot(const planning::PlanRequest& request,
+                                   const GlobalState::Snapshot& state);
 
     /*
      * @brief Get a Trajectory based on the string name given in MotionCommand.
@@ -218,7 +269,7 @@ private:
      * @brief Check that robot is visible in world_state and that world_state has been
      * updated recently.
      */
-    [[nodiscard]] bool robot_alive() const;
+    [[nodiscard]] bool robot_alive(const GlobalState::Snapshot& state) const;
 
     rclcpp::Node* node_;
 
@@ -243,6 +294,15 @@ private:
 
     bool had_break_beam_ = false;
 
+    // Generator for this robot's sampling-based planners. It is bound to the
+    // planning thread for the duration of execute_intent().
+    PlanningRng rng_{PlanningRng::from_entropy()};
+
+    // Opened once bench::PARAM_record_path is set.
+    std::unique_ptr<PlanRequestWriter> request_writer_;
+    // Set if the log couldn't be opened or written, so we stop trying.
+    bool recording_failed_ = false;
+
     rclcpp::Subscription<RobotIntent::Msg>::SharedPtr intent_sub_;
     rclcpp::Subscription<rj_msgs::msg::RobotStatus>::SharedPtr robot_status_sub_;
     rclcpp::Publisher<Trajectory::Msg>::SharedPtr trajectory_topic_;
@@ -254,10 +314,20 @@ private:
 
 /**
  * ROS node that spawns many PlannerForRobots and helps coordinate them.
+ *
+ * Accepted RobotMove goals are handed to a single frame thread. Once per
+ * frame it runs every robot's active goal on a shared WorkerPool, waits for
+ * all of them to finish, and then reports results back to the action clients.
  */
 class PlannerNode : public rclcpp::Node {
 public:
-    PlannerNode();
+    explicit PlannerNode(const rclcpp::NodeOptions& options = rclcpp::NodeOptions{});
+    ~PlannerNode() override;
+
+    PlannerNode(const PlannerNode&) = delete;
+    PlannerNode& operator=(const PlannerNode&) = delete;
+    PlannerNode(PlannerNode&&) = delete;
+    PlannerNode& operator=(PlannerNode&&) = delete;
 
     using RobotMove = rj_msgs::action::RobotMove;
     using GoalHandleRobotMove = rclcpp_action::ServerGoalHandle<RobotMove>;
@@ -274,18 +344,30 @@ private:
                                             std::shared_ptr<const RobotMove::Goal> goal);
     rclcpp_action::CancelResponse handle_cancel(
         const std::shared_ptr<GoalHandleRobotMove> goal_handle);
+
+    /*
+     * @brief Queue a newly accepted goal for its robot. The goal it replaces
+     * (if any) is aborted at the start of the next frame. Never blocks.
+     */
     void handle_accepted(const std::shared_ptr<GoalHandleRobotMove> goal_handle);
 
     /*
-     * @brief Upon being given a RobotIntent, publish an appropriate
-     * Trajectory, send time remaining as feedback, and return success when
-     * done. Blocking (as in, will loop until complete).
+     * @brief Run planning frames at a fixed rate until the node is destroyed.
+     */
+    void frame_loop();
+
+    /*
+     * @brief Publish an appropriate Trajectory for every robot with an active
+     * goal, in parallel, then succeed/cancel goals that have finished.
      */
-    void execute(const std::shared_ptr<GoalHandleRobotMove> goal_handle);
+    void run_frame();
 
     /*
      * @brief Track the current state of a robot's task. This is how
      * PlannerNode ensures each robot only has one task running.
+     *
+     * handle_accepted() only ever touches pending_goal and preempted_goals;
+     * active_goal belongs to the frame thread.
      */
     struct ServerTaskState {
         ServerTaskState() = default;
@@ -296,13 +378,24 @@ private:
         ServerTaskState(const ServerTaskState&& state) = delete;
         ServerTaskState& operator=(const ServerTaskState&& state) = delete;
 
-        volatile std::atomic_bool is_executing{false};
-        volatile std::atomic_bool new_task_waiting_signal{false};
+        std::mutex mutex;
+        // newest accepted goal, not yet picked up by the frame thread
+        std::shared_ptr<GoalHandleRobotMove> pending_goal;
+        // accepted goals that were replaced before they ever ran
+        std::vector<std::shared_ptr<GoalHandleRobotMove>> preempted_goals;
+
+        std::shared_ptr<GoalHandleRobotMove> active_goal;
     };
 
     // create an array, kNumShells long, of ServerTaskState structs for
     // PlannerNode to use
     std::array<ServerTaskState, kNumShells> server_task_states_;
+
+    rj_utils::WorkerPool worker_pool_;
+    // Only touched by the frame thread.
+    uint64_t frame_number_ = 0;
+    std::atomic_bool stop_frame_loop_{false};
+    std::thread frame_thread_;
 };
 
 }  // namespace planning
@@ -40,6 +40,16 @@ DEFINE_NS_INT64(kPlanningParamModule, rrt, min_iterations, 50,
                 "Minimum number of RRT iterations to run (unused without RRT* enabled)");
 DEFINE_NS_INT64(kPlanningParamModule, rrt, max_iterations, 500,
                 "Maximum number of RRT iterations to run before giving up");
+DEFINE_NS_BOOL(kPlanningParamModule, rrt, deterministic, false,
+               "Whether to seed each robot's RRT from its robot id and the planning frame "
+               "number, so that planning runs are reproducible");
+DEFINE_NS_FLOAT64(kPlanningParamModule, rrt, time_budget, 0.012,
+                  "Time (s) each robot may spend planning per frame. Once it is used up, "
+                  "sampling-based planners return the best path found so far.");
+
+DEFINE_NS_STRING(kPlanningParamModule, bench, record_path, "",
+                 "If nonempty, every robot's PlanRequests are appended to <record_path>_<robot "
+                 "id>.bin for replay in the planning benchmarks");
 
 DEFINE_NS_FLOAT64(
     kPlanningParamModule, escape, step_size, 0.1,
@@ -24,6 +24,10 @@ DECLARE_NS_FLOAT64(kPlanningParamModule, rrt, goal_bias);
 DECLARE_NS_FLOAT64(kPlanningParamModule, rrt, waypoint_bias);
 DECLARE_NS_INT64(kPlanningParamModule, rrt, min_iterations);
 DECLARE_NS_INT64(kPlanningParamModule, rrt, max_iterations);
+DECLARE_NS_BOOL(kPlanningParamModule, rrt, deterministic);
+DECLARE_NS_FLOAT64(kPlanningParamModule, rrt, time_budget);
+
+DECLARE_NS_STRING(kPlanningParamModule, bench, record_path);
 
 DECLARE_NS_FLOAT64(kPlanningParamModule, escape, step_size);
 DECLARE_NS_FLOAT64(kPlanningParamModule, escape, goal_change_threshold);
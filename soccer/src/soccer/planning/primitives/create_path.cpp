@@ -29,10 +29,21 @@ Trajectory rrt(const LinearMotionInstant& start, const LinearMotionInstant& goal
                const MotionConstraints& motion_constraints, RJ::Time start_time,
                const ShapeSet& static_obstacles,
                const std::vector<DynamicObstacle>& dynamic_obstacles,
-               const std::vector<Point>& bias_waypoints) {
+               const std::vector<Point>& bias_waypoints, PlanningRng* rng, RJ::Time deadline,
+               RrtStats* out_stats) {
+    const RJ::Time call_start = RJ::now();
+    RrtStats stats;
+    const auto finish = [&](Trajectory path) {
+        if (out_stats != nullptr) {
+            stats.time_used = RJ::now() - call_start;
+            *out_stats = stats;
+        }
+        return path;
+    };
+
     // if already on goal, no need to move
     if (start.position.dist_to(goal.position) < 1e-6) {
-        return Trajectory{{RobotInstant{Pose(start.position, 0), Twist(), start_time}}};
+        return finish(Trajectory{{RobotInstant{Pose(start.position, 0), Twist(), start_time}}});
     }
 
     // maybe we don't need an RRT
@@ -45,34 +56,55 @@ Trajectory rrt(const LinearMotionInstant& start, const LinearMotionInstant& goal
         (!trajectory_hits_static(straight_trajectory, static_obstacles, start_time, nullptr) &&
          !trajectory_hits_dynamic(straight_trajectory, dynamic_obstacles, start_time, nullptr,
                                   nullptr))) {
-        return straight_trajectory;
+        return finish(std::move(straight_trajectory));
     }
 
     ShapeSet obstacles = static_obstacles;
-    Trajectory path{{}};
+    Trajectory best{{}};
+    RJ::Time best_hit_time = RJ::Time::min();
     constexpr int kAttemptsToAvoidDynamics = 10;
     for (int i = 0; i < kAttemptsToAvoidDynamics; i++) {
+        // Always make one attempt, so that there is something to return.
+        if (i > 0 && RJ::now() >= deadline) {
+            stats.deadline_hit = true;
+            break;
+        }
+
         std::vector<Point> points =
-            generate_rrt(start.position, goal.position, obstacles, bias_waypoints);
+            generate_rrt(start.position, goal.position, obstacles, bias_waypoints, rng);
+        stats.num_rrt_runs++;
 
         BezierPath post_bezier(points, start.velocity, goal.velocity, motion_constraints);
 
-        path = profile_velocity(post_bezier, start.velocity.mag(), goal.velocity.mag(),
-                                motion_constraints, start_time);
+        Trajectory path = profile_velocity(post_bezier, start.velocity.mag(),
+                                           goal.velocity.mag(), motion_constraints, start_time);
+
+        // The RRT failed; more attempts would only add obstacles.
+        if (path.empty()) {
+            break;
+        }
 
         Circle hit_circle;
+        RJ::Time hit_time;
         if (!trajectory_hits_dynamic(path, dynamic_obstacles, path.begin_time(), &hit_circle,
-                                     nullptr)) {
+                                     &hit_time)) {
+            best = std::move(path);
             break;
         }
 
+        // Until we find a clear path, keep the one that stays clear longest.
+        if (best.empty() || hit_time > best_hit_time) {
+            best = path;
+            best_hit_time = hit_time;
+        }
+
         // Inflate the radius slightly so we don't try going super close to
         // it and hitting it again.
         hit_circle.radius(hit_circle.radius() * 1.5f);
         obstacles.add(std::make_shared<Circle>(hit_circle));
     }
 
-    return path;
+    return finish(std::move(best));
 }
 
 }  // namespace planning::CreatePath
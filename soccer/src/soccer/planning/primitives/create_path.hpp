@@ -3,18 +3,46 @@
 #include "planning/motion_constraints.hpp"
 #include "planning/trajectory.hpp"
 #include "planning/primitives/path_smoothing.hpp"
+#include "planning/primitives/planning_rng.hpp"
 
 namespace planning::CreatePath {
 
+/**
+ * What a call to CreatePath::rrt() spent.
+ */
+struct RrtStats {
+    /// Number of BiRRT runs made.
+    int num_rrt_runs = 0;
+
+    /// Wall-clock time spent in the call.
+    RJ::Seconds time_used{0};
+
+    /// Whether the call gave up early because the deadline passed.
+    bool deadline_hit = false;
+};
+
 /**
  * Generate a smooth path from start to goal avoiding obstacles.
+ *
+ * If the first path hits a dynamic obstacle, the RRT is rerun with that
+ * obstacle added, until a clear path is found or @deadline passes. In the
+ * latter case the path found so far that stays clear the longest is returned.
+ * At least one RRT is always run, and a single run is bounded by
+ * rrt::PARAM_max_iterations rather than by the deadline.
+ *
+ * @param rng The generator used by the RRT. If nullptr, uses
+ *     PlanningRng::current().
+ * @param deadline Time after which no new RRT is started.
+ * @param out_stats If non-null, filled in with what this call spent.
  */
 Trajectory rrt(const LinearMotionInstant& start,
                const LinearMotionInstant& goal,
                const MotionConstraints& motion_constraints, RJ::Time start_time,
                const rj_geometry::ShapeSet& static_obstacles,
                const std::vector<DynamicObstacle>& dynamic_obstacles = {},
-               const std::vector<rj_geometry::Point>& bias_waypoints = {});
+               const std::vector<rj_geometry::Point>& bias_waypoints = {},
+               PlanningRng* rng = nullptr, RJ::Time deadline = RJ::Time::max(),
+               RrtStats* out_stats = nullptr);
 
 /**
  * Generate a smooth path from start to goal disregarding obstacles.
@@ -66,6 +66,14 @@ public:
             : p0(p0), p1(p1), p2(p2), p3(p3) {}
     };
 
+    /**
+     * @brief The control points of each cubic segment, in order. Segment i
+     * covers s in [i / size(), (i + 1) / size()].
+     */
+    [[nodiscard]] const std::vector<CubicBezierControlPoints>& control_points() const {
+        return control_;
+    }
+
 private:
     std::vector<CubicBezierControlPoints> control_;
 };
@@ -0,0 +1,168 @@
+#include "plan_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/functional/hash.hpp>
+
+#include <rj_constants/constants.hpp>
+#include <rj_geometry/circle.hpp>
+#include <rj_geometry/composite_shape.hpp>
+#include <rj_geometry/polygon.hpp>
+
+namespace planning {
+
+namespace {
+
+void hash_quantized(size_t* seed, double value, double quantum) {
+    boost::hash_combine(*seed, std::llround(value / quantum));
+}
+
+void hash_point(size_t* seed, rj_geometry::Point point) {
+    hash_quantized(seed, point.x(), PlanCache::kPositionQuantum);
+    hash_quantized(seed, point.y(), PlanCache::kPositionQuantum);
+}
+
+/**
+ * Hash the shape's actual geometry, rather than just where it is, so that a
+ * shape that changes within its bounding box still changes the fingerprint.
+ *
+ * @return false if the shape is of a kind we don't know how to hash.
+ */
+bool hash_shape(size_t* seed, const rj_geometry::Shape& shape) {
+    if (const auto* circle = dynamic_cast<const rj_geometry::Circle*>(&shape)) {
+        boost::hash_combine(*seed, 'c');
+        hash_point(seed, circle->center);
+        hash_quantized(seed, circle->radius(), PlanCache::kPositionQuantum);
+        return true;
+    }
+    if (const auto* rect = dynamic_cast<const rj_geometry::Rect*>(&shape)) {
+        boost::hash_combine(*seed, 'r');
+        hash_point(seed, rect->pt[0]);
+        hash_point(seed, rect->pt[1]);
+        return true;
+    }
+    if (const auto* polygon = dynamic_cast<const rj_geometry::Polygon*>(&shape)) {
+        boost::hash_combine(*seed, 'p');
+        boost::hash_combine(*seed, polygon->vertices.size());
+        for (rj_geometry::Point vertex : polygon->vertices) {
+            hash_point(seed, vertex);
+        }
+        return true;
+    }
+    if (const auto* composite = dynamic_cast<const rj_geometry::CompositeShape*>(&shape)) {
+        boost::hash_combine(*seed, 's');
+        boost::hash_combine(*seed, composite->subshapes().size());
+        for (const auto& subshape : composite->subshapes()) {
+            if (subshape == nullptr || !hash_shape(seed, *subshape)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * A box containing everywhere the robot could reach while following
+ * @trajectory. Each Hermite segment lies inside the convex hull of its Bezier
+ * control points, so those bound the whole path.
+ */
+rj_geometry::Rect path_region(const Trajectory& trajectory) {
+    rj_geometry::Rect region(trajectory.first().position());
+    for (int i = 1; i < trajectory.num_instants(); i++) {
+        const RobotInstant& a = trajectory.instant_at(i - 1);
+        const RobotInstant& b = trajectory.instant_at(i);
+        const double third = RJ::num_seconds(b.stamp - a.stamp) / 3;
+        region.expand(a.position() + a.linear_velocity() * third);
+        region.expand(b.position() - b.linear_velocity() * third);
+        region.expand(b.position());
+    }
+    region.pad(static_cast<float>(kRobotRadius));
+    return region;
+}
+
+}  // namespace
+
+std::optional<uint64_t> PlanCache::fingerprint(
+    const Trajectory& trajectory, const LinearMotionInstant& goal,
+    const RobotConstraints& constraints, const rj_geometry::ShapeSet& static_obstacles,
+    const std::vector<DynamicObstacle>& dynamic_obstacles, RJ::Time now) {
+    if (trajectory.empty()) {
+        return std::nullopt;
+    }
+
+    size_t seed = 0;
+    hash_point(&seed, goal.position);
+    hash_quantized(&seed, goal.velocity.x(), kValueQuantum);
+    hash_quantized(&seed, goal.velocity.y(), kValueQuantum);
+    hash_quantized(&seed, constraints.mot.max_speed, kValueQuantum);
+    hash_quantized(&seed, constraints.mot.max_acceleration, kValueQuantum);
+    hash_quantized(&seed, constraints.rot.max_speed, kValueQuantum);
+    hash_quantized(&seed, constraints.rot.max_accel, kValueQuantum);
+
+    const rj_geometry::Rect region = path_region(trajectory);
+
+    for (const auto& shape : static_obstacles.shapes()) {
+        // Shapes without a bounding box (like an empty composite) can't be
+        // ruled out, so they're always included.
+        rj_geometry::Rect box;
+        if (shape->bounding_box(&box) && !box.intersects(region)) {
+            continue;
+        }
+        if (!hash_shape(&seed, *shape)) {
+            return std::nullopt;
+        }
+    }
+
+    // Sample each dynamic obstacle at fixed offsets from now, so a stationary
+    // obstacle hashes the same every frame but a moving one never does.
+    const RJ::Time end_time = std::max(now, trajectory.end_time());
+    const auto num_samples =
+        static_cast<size_t>(RJ::Seconds(end_time - now) / kDynamicSampleInterval) + 1;
+    std::vector<RobotInstant> instants(num_samples + 1);
+    std::vector<rj_geometry::Point> samples(num_samples + 1);
+    for (const DynamicObstacle& obstacle : dynamic_obstacles) {
+        if (obstacle.path == nullptr || obstacle.path->empty()) {
+            continue;
+        }
+
+        obstacle.path->evaluate_many(now, kDynamicSampleInterval, num_samples, instants.data());
+        obstacle.path->evaluate_many(&end_time, 1, &instants[num_samples]);
+        for (size_t i = 0; i < instants.size(); i++) {
+            samples[i] = instants[i].position();
+        }
+
+        // The obstacle may stray between samples; pad by the largest step
+        // between them to stay conservative.
+        rj_geometry::Rect swept(samples.front());
+        double max_step = 0;
+        for (size_t i = 1; i < samples.size(); i++) {
+            swept.expand(samples[i]);
+            max_step = std::max(max_step, samples[i].dist_to(samples[i - 1]));
+        }
+        swept.pad(obstacle.circle.radius() + static_cast<float>(max_step));
+        if (!swept.intersects(region)) {
+            continue;
+        }
+
+        hash_quantized(&seed, obstacle.circle.radius(), kPositionQuantum);
+        for (rj_geometry::Point sample : samples) {
+            hash_point(&seed, sample);
+        }
+    }
+
+    return static_cast<uint64_t>(seed);
+}
+
+bool PlanCache::matches(const Trajectory& trajectory, uint64_t key) const {
+    return stamp_.has_value() && key == key_ && trajectory.time_created() == stamp_;
+}
+
+void PlanCache::store(const Trajectory& trajectory, uint64_t key, bool improve_tried) {
+    stamp_ = trajectory.time_created();
+    key_ = key;
+    improve_tried_ = improve_tried;
+}
+
+}  // namespace planning
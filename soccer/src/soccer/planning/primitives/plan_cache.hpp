@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <rj_geometry/shape_set.hpp>
+
+#include "planning/dynamic_obstacle.hpp"
+#include "planning/instant.hpp"
+#include "planning/robot_constraints.hpp"
+#include "planning/trajectory.hpp"
+
+namespace planning {
+
+/**
+ * @brief Remembers which inputs a robot's current trajectory was last checked
+ * against, so the Replanner can skip re-checking it while they stay the same.
+ *
+ * The inputs are summarized by a fingerprint of the goal, the constraints and
+ * the geometry of the obstacles near the trajectory, each quantized so that
+ * sensor noise does not change it. Obstacles that can't reach the trajectory are left out, so
+ * robots moving elsewhere on the field don't invalidate the cache.
+ *
+ * Each planner keeps one PlanCache per robot. It is not thread-safe.
+ */
+class PlanCache {
+public:
+    /**
+     * @brief Fingerprint the inputs relevant to reusing @trajectory from
+     * @now onwards.
+     *
+     * @return The fingerprint, or std::nullopt if the inputs can't be
+     * summarized (an obstacle near the path is a kind of Shape we don't know
+     * how to hash), in which case the trajectory must always be checked.
+     */
+    static std::optional<uint64_t> fingerprint(
+        const Trajectory& trajectory, const LinearMotionInstant& goal,
+        const RobotConstraints& constraints, const rj_geometry::ShapeSet& static_obstacles,
+        const std::vector<DynamicObstacle>& dynamic_obstacles, RJ::Time now);
+
+    /**
+     * @brief Whether @trajectory is the one last stored, and was checked
+     * against inputs with the fingerprint @key.
+     */
+    [[nodiscard]] bool matches(const Trajectory& trajectory, uint64_t key) const;
+
+    /**
+     * @brief Record that @trajectory (which must be stamped) has been checked
+     * against inputs with the fingerprint @key.
+     *
+     * @param improve_tried Whether a search for a better trajectory has
+     * already been made with these inputs.
+     */
+    void store(const Trajectory& trajectory, uint64_t key, bool improve_tried);
+
+    /**
+     * @brief Whether a better trajectory was already searched for with the
+     * stored inputs. Only meaningful after matches() returns true.
+     */
+    [[nodiscard]] bool improve_tried() const { return improve_tried_; }
+
+    void clear() { stamp_.reset(); }
+
+    /// Goal and obstacle positions are rounded to this many meters.
+    static constexpr double kPositionQuantum = 0.01;
+
+    /// Goal velocities and constraints are rounded to this many SI units.
+    static constexpr double kValueQuantum = 0.001;
+
+    /// Dynamic obstacles are compared at this interval along the trajectory.
+    static constexpr RJ::Seconds kDynamicSampleInterval{0.1};
+
+private:
+    std::optional<RJ::Time> stamp_;
+    uint64_t key_ = 0;
+    bool improve_tried_ = false;
+};
+
+}  // namespace planning
@@ -0,0 +1,33 @@
+#include "planning_rng.hpp"
+
+#include <random>
+
+namespace planning {
+
+namespace {
+
+thread_local PlanningRng* bound_rng = nullptr;
+
+}  // namespace
+
+PlanningRng PlanningRng::from_entropy() {
+    std::random_device device;
+    return PlanningRng((static_cast<uint64_t>(device()) << 32) ^ device());
+}
+
+PlanningRng& PlanningRng::current() {
+    if (bound_rng != nullptr) {
+        return *bound_rng;
+    }
+
+    thread_local PlanningRng fallback = from_entropy();
+    return fallback;
+}
+
+PlanningRng::ScopedBinding::ScopedBinding(PlanningRng* rng) : previous_(bound_rng) {
+    bound_rng = rng;
+}
+
+PlanningRng::ScopedBinding::~ScopedBinding() { bound_rng = previous_; }
+
+}  // namespace planning
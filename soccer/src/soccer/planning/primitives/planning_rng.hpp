@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace planning {
+
+/**
+ * Random number source for the sampling-based planners (RRT).
+ *
+ * This is a counter-based generator: the n-th output is a fixed hash of
+ * (seed, n), so a generator can be recreated from its seed and draws made by
+ * one planner never affect another. Each planner thread should own (or be
+ * bound to) its own instance; a single instance is not thread-safe.
+ *
+ * Satisfies UniformRandomBitGenerator, so it can be used with <random>
+ * distributions too.
+ */
+class PlanningRng {
+public:
+    using result_type = uint64_t;
+
+    explicit PlanningRng(uint64_t seed) : key_(mix(seed)) {}
+
+    /**
+     * A generator keyed by robot and planning frame, for deterministic
+     * planning: the same robot in the same frame always sees the same
+     * sequence of samples.
+     */
+    static PlanningRng for_robot(unsigned robot_id, uint64_t frame_number) {
+        return PlanningRng(mix(robot_id + kGamma) ^ frame_number);
+    }
+
+    /**
+     * A generator seeded from std::random_device.
+     */
+    static PlanningRng from_entropy();
+
+    /**
+     * The generator bound to this thread with ScopedBinding, or a
+     * thread-local generator seeded from entropy if there is none. Used by
+     * planners that weren't handed a generator explicitly.
+     */
+    static PlanningRng& current();
+
+    /**
+     * Makes @rng the current() generator on this thread until destroyed.
+     */
+    class ScopedBinding {
+    public:
+        explicit ScopedBinding(PlanningRng* rng);
+        ~ScopedBinding();
+
+        ScopedBinding(const ScopedBinding&) = delete;
+        ScopedBinding& operator=(const ScopedBinding&) = delete;
+        ScopedBinding(ScopedBinding&&) = delete;
+        ScopedBinding& operator=(ScopedBinding&&) = delete;
+
+    private:
+        PlanningRng* previous_;
+    };
+
+    result_type operator()() { return mix(key_ + kGamma * ++counter_); }
+
+    /// A uniformly distributed double in [0, 1).
+    double uniform() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    /// A uniformly distributed index in [0, n). @n must be nonzero.
+    size_t index(size_t n) { return static_cast<size_t>(uniform() * static_cast<double>(n)); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    static constexpr uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+
+    // SplitMix64 finalizer
+    static constexpr uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t key_;
+    uint64_t counter_ = 0;
+};
+
+}  // namespace planning
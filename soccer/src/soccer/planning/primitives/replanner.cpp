@@ -34,7 +34,7 @@ Trajectory Replanner::partial_replan(const PlanParams& params, const Trajectory&
     Trajectory post_trajectory =
         CreatePath::rrt(pre_trajectory.last().linear_motion(), params.goal, params.constraints.mot,
                         pre_trajectory.end_time(), params.static_obstacles,
-                        params.dynamic_obstacles, bias_waypoints);
+                        params.dynamic_obstacles, bias_waypoints, nullptr, params.deadline);
 
     // If we couldn't profile such that velocity at the end of the partial replan period is valid,
     // do a full replan.
@@ -58,7 +58,8 @@ Trajectory Replanner::partial_replan(const PlanParams& params, const Trajectory&
 Trajectory Replanner::full_replan(const Replanner::PlanParams& params) {
     Trajectory path =
         CreatePath::rrt(params.start.linear_motion(), params.goal, params.constraints.mot,
-                        params.start.stamp, params.static_obstacles, params.dynamic_obstacles);
+                        params.start.stamp, params.static_obstacles, params.dynamic_obstacles, {},
+                        nullptr, params.deadline);
 
     // if the initial path is empty, the goal must be blocked
     // try to shift the goal_point until it is no longer blocked
@@ -70,15 +71,15 @@ Trajectory Replanner::full_replan(const Replanner::PlanParams& params) {
     double shift_size = 1.0 * kRobotRadius;
 
     for (int i = 0; i < max_tries; i++) {
-        if (!path.empty()) {
+        if (!path.empty() || RJ::now() >= params.deadline) {
             break;
         }
 
         almost_goal.position += shift_dir * shift_size;
 
-        path =
-            CreatePath::rrt(params.start.linear_motion(), almost_goal, params.constraints.mot,
-                            params.start.stamp, params.static_obstacles, params.dynamic_obstacles);
+        path = CreatePath::rrt(params.start.linear_motion(), almost_goal, params.constraints.mot,
+                               params.start.stamp, params.static_obstacles,
+                               params.dynamic_obstacles, {}, nullptr, params.deadline);
     }
 
     if (!path.empty()) {
@@ -101,6 +102,11 @@ Trajectory Replanner::full_replan(const Replanner::PlanParams& params) {
 }
 
 Trajectory Replanner::check_better(const Replanner::PlanParams& params, Trajectory previous) {
+    // Looking for a better path is optional; don't start if we're out of time.
+    if (RJ::now() >= params.deadline) {
+        return previous;
+    }
+
     Trajectory new_trajectory = partial_replan(params, previous);
     if (!new_trajectory.empty() && new_trajectory.end_time() < previous.end_time()) {
         apply_hold(&new_trajectory, params.hold_time);
@@ -136,14 +142,25 @@ Trajectory Replanner::create_plan(Replanner::PlanParams params, Trajectory previ
         std::clamp(now, previous_trajectory.begin_time(), previous_trajectory.end_time());
     const RJ::Seconds time_remaining{previous_trajectory.end_time() - start_time};
 
+    // If nothing near the path has changed since it was last checked, it still
+    // doesn't hit anything.
+    std::optional<uint64_t> cache_key;
+    if (params.cache != nullptr) {
+        cache_key = PlanCache::fingerprint(previous_trajectory, params.goal, params.constraints,
+                                           params.static_obstacles, params.dynamic_obstacles, now);
+    }
+    const bool cache_hit =
+        cache_key.has_value() && params.cache->matches(previous_trajectory, *cache_key);
+
     RJ::Time hit_time = RJ::Time::max();
 
     // Use short-circuiting to only check dynamic trajectories if necessary.
     bool should_partial_replan =
-        trajectory_hits_static(previous_trajectory, params.static_obstacles, start_time,
-                               &hit_time) ||
-        trajectory_hits_dynamic(previous_trajectory, params.dynamic_obstacles, start_time, nullptr,
-                                &hit_time);
+        !cache_hit &&
+        (trajectory_hits_static(previous_trajectory, params.static_obstacles, start_time,
+                                &hit_time) ||
+         trajectory_hits_dynamic(previous_trajectory, params.dynamic_obstacles, start_time,
+                                 nullptr, &hit_time));
 
     if (should_partial_replan) {
         if (hit_time - start_time < partial_replan_lead_time() * 2) {
@@ -162,12 +179,24 @@ Trajectory Replanner::create_plan(Replanner::PlanParams params, Trajectory previ
         }
     }
 
-    if (now - previous_created_time > kCheckBetterDeltaTime &&
+    // Only look for a better path once per set of inputs; with nothing
+    // changed, another search is unlikely to do better.
+    bool improve_tried = cache_hit && params.cache->improve_tried();
+    if (!improve_tried && now - previous_created_time > kCheckBetterDeltaTime &&
         time_remaining > partial_replan_lead_time() * 2) {
-        return check_better(params, previous_trajectory);
+        // check_better() gives up without searching once out of time.
+        improve_tried = RJ::now() < params.deadline;
+        Trajectory better = check_better(params, std::move(previous_trajectory));
+        if (better.time_created() != previous_created_time) {
+            return better;
+        }
+        previous_trajectory = std::move(better);
     }
 
     previous_trajectory.stamp(RJ::now());
+    if (cache_key.has_value()) {
+        params.cache->store(previous_trajectory, *cache_key, improve_tried);
+    }
     return previous_trajectory;
 }
 
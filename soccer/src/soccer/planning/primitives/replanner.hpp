@@ -5,6 +5,7 @@
 #include "planning/instant.hpp"
 #include "planning/planning_params.hpp"
 #include "planning/primitives/angle_planning.hpp"
+#include "planning/primitives/plan_cache.hpp"
 #include "planning/robot_constraints.hpp"
 #include "planning/trajectory.hpp"
 #include "velocity_profiling.hpp"
@@ -30,6 +31,14 @@ public:
         RobotConstraints constraints;
         const AngleFunction& angle_function;
         std::optional<RJ::Seconds> hold_time = std::nullopt;
+
+        // No new RRT is started after this time (see CreatePath::rrt()).
+        RJ::Time deadline = RJ::Time::max();
+
+        // The calling planner's cache for this robot, if it keeps one. While
+        // the goal and nearby obstacles are unchanged the previous trajectory
+        // is reused without checking it for collisions again.
+        PlanCache* cache = nullptr;
     };
 
     /**
@@ -1,25 +1,69 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <rj_common/field_dimensions.hpp>
 #include <rj_geometry/point.hpp>
 #include <rj_geometry/shape_set.hpp>
 #include <rrt/2dplane/PlaneStateSpace.hpp>
 
+#include "planning_rng.hpp"
+
 namespace planning {
 
 /**
  * Represents the robocup field for path-planning purposes.
+ *
+ * All sampling goes through a PlanningRng, so an RRT over this state space is
+ * reproducible given the generator's seed and never touches global RNG state.
  */
 class RoboCupStateSpace : public RRT::StateSpace<rj_geometry::Point> {
 public:
-    RoboCupStateSpace(const FieldDimensions& dims,
-                      const rj_geometry::ShapeSet& obstacles)
-        : field_dimensions_(dims), obstacles_(obstacles) {}
+    /**
+     * @param rng The generator to sample from; must outlive the state space.
+     *     If nullptr, PlanningRng::current() is used.
+     */
+    RoboCupStateSpace(const FieldDimensions& dims, const rj_geometry::ShapeSet& obstacles,
+                      PlanningRng* rng = nullptr)
+        : obstacles_(obstacles),
+          field_dimensions_(dims),
+          rng_(rng != nullptr ? rng : &PlanningRng::current()) {}
+
+    /**
+     * Bias random samples towards @targets: with probability @bias, a sample
+     * is one of @targets instead of a uniformly random point.
+     *
+     * This replaces the goal bias built into RRT::Tree, which draws from the
+     * global C RNG. For a BiRRT pass both the start and the goal, since each
+     * tree should be pulled towards the other's root.
+     */
+    void set_goal_bias(std::vector<rj_geometry::Point> targets, double bias) {
+        goal_targets_ = std::move(targets);
+        goal_bias_ = bias;
+    }
+
+    /**
+     * Bias random samples towards @waypoints with probability @bias (on top
+     * of the goal bias). Replaces RRT::Tree's waypoint bias, see
+     * set_goal_bias().
+     */
+    void set_waypoint_bias(std::vector<rj_geometry::Point> waypoints, double bias) {
+        waypoints_ = std::move(waypoints);
+        waypoint_bias_ = bias;
+    }
 
     rj_geometry::Point randomState() const override {
-        double x = field_dimensions_.floor_width() * (drand48() - 0.5f);
-        double y = field_dimensions_.floor_length() * drand48() -
-                   field_dimensions_.border();
+        const double r = rng_->uniform();
+        if (r < goal_bias_ && !goal_targets_.empty()) {
+            return goal_targets_[rng_->index(goal_targets_.size())];
+        }
+        if (r < goal_bias_ + waypoint_bias_ && !waypoints_.empty()) {
+            return waypoints_[rng_->index(waypoints_.size())];
+        }
+
+        double x = field_dimensions_.floor_width() * (rng_->uniform() - 0.5);
+        double y = field_dimensions_.floor_length() * rng_->uniform() - field_dimensions_.border();
         return rj_geometry::Point(x, y);
     }
 
@@ -55,16 +99,20 @@ public:
         // Ensure that @to doesn't hit any obstacles that @from doesn't. This
         // allows the RRT to start inside an obstacle, but prevents it from
         // entering a new obstacle.
-        for (const auto& shape : obstacles_.shapes()) {
-            if (shape->hit(rj_geometry::Segment(from, to)) && !shape->hit(from))
-                return false;
-        }
-        return true;
+        return !obstacles_.hit_if(
+            rj_geometry::Segment(from, to),
+            [&](const std::shared_ptr<rj_geometry::Shape>& shape) { return !shape->hit(from); });
     }
 
 private:
     const rj_geometry::ShapeSet& obstacles_;
     const FieldDimensions field_dimensions_;
+    PlanningRng* rng_;
+
+    std::vector<rj_geometry::Point> goal_targets_;
+    double goal_bias_ = 0;
+    std::vector<rj_geometry::Point> waypoints_;
+    double waypoint_bias_ = 0;
 };
 
 }  // namespace planning
@@ -40,9 +40,10 @@ void draw_bi_rrt(const RRT::BiRRT<Point>& bi_rrt, DebugDrawer* debug_drawer, uns
 }
 
 vector<Point> run_rrt_helper(Point start, Point goal, const ShapeSet& obstacles,
-                             const vector<Point>& waypoints, bool straight_line) {
+                             const vector<Point>& waypoints, PlanningRng* rng,
+                             bool straight_line) {
     auto state_space =
-        std::make_shared<RoboCupStateSpace>(FieldDimensions::current_dimensions, obstacles);
+        std::make_shared<RoboCupStateSpace>(FieldDimensions::current_dimensions, obstacles, rng);
     RRT::BiRRT<Point> bi_rrt(state_space, Point::hash, 2);
     bi_rrt.setStartState(start);
     bi_rrt.setGoalState(goal);
@@ -50,11 +51,14 @@ vector<Point> run_rrt_helper(Point start, Point goal, const ShapeSet& obstacles,
     bi_rrt.setStepSize(rrt::PARAM_step_size);
     bi_rrt.setMinIterations(rrt::PARAM_min_iterations);
     bi_rrt.setMaxIterations(rrt::PARAM_max_iterations);
-    bi_rrt.setGoalBias(rrt::PARAM_goal_bias);
 
+    // Biasing is done by the state space with our own generator rather than
+    // by the RRT library, which would draw from the global C RNG.
+    bi_rrt.setGoalBias(0);
+    bi_rrt.setWaypointBias(0);
+    state_space->set_goal_bias({start, goal}, rrt::PARAM_goal_bias);
     if (!waypoints.empty()) {
-        bi_rrt.setWaypoints(waypoints);
-        bi_rrt.setWaypointBias(rrt::PARAM_waypoint_bias);
+        state_space->set_waypoint_bias(waypoints, rrt::PARAM_waypoint_bias);
     }
 
     bool success = bi_rrt.run();
@@ -67,8 +71,8 @@ vector<Point> run_rrt_helper(Point start, Point goal, const ShapeSet& obstacles,
 }
 
 vector<Point> generate_rrt(Point start, Point goal, const ShapeSet& obstacles,
-                           const vector<Point>& waypoints) {
-    return run_rrt_helper(start, goal, obstacles, waypoints, false);
+                           const vector<Point>& waypoints, PlanningRng* rng) {
+    return run_rrt_helper(start, goal, obstacles, waypoints, rng, false);
 }
 
 }  // namespace planning
@@ -4,6 +4,7 @@
 #include <rj_common/field_dimensions.hpp>
 #include <rrt/BiRRT.hpp>
 
+#include "planning_rng.hpp"
 #include "robo_cup_state_space.hpp"
 #include "planning/motion_constraints.hpp"
 #include "planning/trajectory.hpp"
@@ -24,12 +25,14 @@ void draw_bi_rrt(const RRT::BiRRT<rj_geometry::Point>& bi_rrt,
  * @param obstacles the obstacles to avoid
  * @param waypoints A vector of points from a previous path. The RRT will be
  *      biased towards these points. If empty, they will be unused.
+ * @param rng The generator to sample from. If nullptr, uses
+ *      PlanningRng::current().
  * @return A vector of points representing some clear path from the start to
  *      the end.
  */
 std::vector<rj_geometry::Point> generate_rrt(
     rj_geometry::Point start, rj_geometry::Point goal,
     const rj_geometry::ShapeSet& obstacles,
-    const std::vector<rj_geometry::Point>& waypoints = {});
+    const std::vector<rj_geometry::Point>& waypoints = {}, PlanningRng* rng = nullptr);
 
 }  // namespace planning
@@ -1,5 +1,11 @@
 #include "velocity_profiling.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
 #include "planning/instant.hpp"
 #include "trapezoidal_motion.hpp"
 
@@ -9,7 +15,43 @@ using rj_geometry::Point;
 using rj_geometry::Pose;
 using rj_geometry::Twist;
 
-constexpr int kInterpolationsPerBezier = 40;
+namespace {
+
+constexpr int kInterpolationsPerBezier = VelocityProfiler::kInterpolationsPerBezier;
+
+/**
+ * Cubic Bezier basis weights, and their first and second derivatives, at
+ * t = k / kInterpolationsPerBezier. Equations from
+ * https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Cubic_B%C3%A9zier_curves:
+ *
+ *   p(t)   = p0 (-t^3 + 3t^2 - 3t + 1) + 3 p1 (t^3 - 2t^2 + t) + 3 p2 (-t^3 + t^2) + p3 t^3
+ *   p'(t)  = p0 (-3t^2 + 6t - 3) + 3 p1 (3t^2 - 4t + 1) + 3 p2 (-3t^2 + 2t) + 3 p3 t^2
+ *   p''(t) = p0 (-6t + 6) + 3 p1 (6t - 4) + 3 p2 (-6t + 2) + 6 p3 t
+ */
+struct BezierBasis {
+    std::array<std::array<double, 4>, kInterpolationsPerBezier + 1> pos;
+    std::array<std::array<double, 4>, kInterpolationsPerBezier + 1> d1;
+    std::array<std::array<double, 4>, kInterpolationsPerBezier + 1> d2;
+
+    BezierBasis() : pos(), d1(), d2() {
+        for (int k = 0; k <= kInterpolationsPerBezier; k++) {
+            const double t = k / static_cast<double>(kInterpolationsPerBezier);
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+            pos[k] = {-t3 + 3 * t2 - 3 * t + 1, 3 * (t3 - 2 * t2 + t), 3 * (-t3 + t2), t3};
+            d1[k] = {-3 * t2 + 6 * t - 3, 3 * (3 * t2 - 4 * t + 1), 3 * (-3 * t2 + 2 * t),
+                     3 * t2};
+            d2[k] = {-6 * t + 6, 3 * (6 * t - 4), 3 * (-6 * t + 2), 6 * t};
+        }
+    }
+};
+
+const BezierBasis& bezier_basis() {
+    static const BezierBasis basis;
+    return basis;
+}
+
+}  // namespace
 
 double limit_acceleration(double velocity_initial, double velocity_final, double displacement,
                           double max_accel) {
@@ -18,30 +60,86 @@ double limit_acceleration(double velocity_initial, double velocity_final, double
                       std::sqrt(std::pow(velocity_initial, 2) + offset));
 }
 
-Trajectory profile_velocity(const BezierPath& path, double initial_speed, double final_speed,
-                            const MotionConstraints& constraints, RJ::Time initial_time) {
-    if (path.empty()) {
-        return Trajectory{{}};
-    }
-
-    // Number of cubic bezier segments
-    const int num_beziers = path.size();
-
-    // Number of points that will be in the final trajectory. We need to add one
-    // to account for the final instant
-    const int num_points = num_beziers * kInterpolationsPerBezier + 1;
-    const int num_segments = num_points - 1;
+VelocityProfiler& VelocityProfiler::thread_instance() {
+    thread_local VelocityProfiler profiler;
+    return profiler;
+}
 
-    // Scratch data that we will use later.
-    std::vector<Point> points(num_points);
-    std::vector<Point> derivs1(num_points);
-    std::vector<double> curvature(num_points);
-    std::vector<double> speed(num_points, constraints.max_speed);
+void VelocityProfiler::sample(const Request* requests, size_t num_requests,
+                              const MotionConstraints& constraints) {
+    offsets_.resize(num_requests + 1);
+    offsets_[0] = 0;
+    for (size_t i = 0; i < num_requests; i++) {
+        const int num_beziers = requests[i].path->size();
+        // Add one to account for the final instant.
+        const size_t num_points =
+            num_beziers == 0 ? 0 : num_beziers * kInterpolationsPerBezier + 1;
+        offsets_[i + 1] = offsets_[i] + num_points;
+    }
 
-    // Note: these are just suggestions. If they are impossible given
-    // MotionConstraints, then we'll limit them.
-    speed[0] = initial_speed;
-    speed[num_points - 1] = std::min(constraints.max_speed, final_speed);
+    // These only reallocate when a batch is bigger than any before it.
+    const size_t total_points = offsets_[num_requests];
+    x_.resize(total_points);
+    y_.resize(total_points);
+    dx_.resize(total_points);
+    dy_.resize(total_points);
+    curvature_.resize(total_points);
+    speed_.resize(total_points);
+    distance_.resize(total_points);
+
+    const BezierBasis& basis = bezier_basis();
+
+    for (size_t i = 0; i < num_requests; i++) {
+        const auto& control = requests[i].path->control_points();
+        // Derivatives are with respect to s over the whole path, not t over
+        // one segment.
+        const auto num_beziers = static_cast<double>(control.size());
+
+        size_t base = offsets_[i];
+        for (size_t segment = 0; segment < control.size(); segment++) {
+            const BezierPath::CubicBezierControlPoints& c = control[segment];
+            const std::array<double, 4> cx{c.p0.x(), c.p1.x(), c.p2.x(), c.p3.x()};
+            const std::array<double, 4> cy{c.p0.y(), c.p1.y(), c.p2.y(), c.p3.y()};
+
+            // Each segment starts where the last one ended, so only the last
+            // segment includes its endpoint.
+            const int num_samples = segment + 1 == control.size() ? kInterpolationsPerBezier + 1
+                                                                  : kInterpolationsPerBezier;
+
+            double* x = &x_[base];
+            double* y = &y_[base];
+            double* dx = &dx_[base];
+            double* dy = &dy_[base];
+            double* curvature = &curvature_[base];
+            for (int k = 0; k < num_samples; k++) {
+                const auto& w = basis.pos[k];
+                const auto& w1 = basis.d1[k];
+                const auto& w2 = basis.d2[k];
+                x[k] = w[0] * cx[0] + w[1] * cx[1] + w[2] * cx[2] + w[3] * cx[3];
+                y[k] = w[0] * cy[0] + w[1] * cy[1] + w[2] * cy[2] + w[3] * cy[3];
+                dx[k] = num_beziers * (w1[0] * cx[0] + w1[1] * cx[1] + w1[2] * cx[2] +
+                                       w1[3] * cx[3]);
+                dy[k] = num_beziers * (w1[0] * cy[0] + w1[1] * cy[1] + w1[2] * cy[2] +
+                                       w1[3] * cy[3]);
+                const double ddx = num_beziers * num_beziers *
+                                   (w2[0] * cx[0] + w2[1] * cx[1] + w2[2] * cx[2] + w2[3] * cx[3]);
+                const double ddy = num_beziers * num_beziers *
+                                   (w2[0] * cy[0] + w2[1] * cy[1] + w2[2] * cy[2] + w2[3] * cy[3]);
+
+                // https://en.wikipedia.org/wiki/Curvature#Local_expressions
+                // K = |x'*y'' - y'*x''| / (x'^2 + y'^2)^(3/2) = |v x a|/|v|^3
+                //
+                // Curvature is broken at small velocities (mathematically).
+                // It's okay not to limit it here because we'll be limiting it
+                // at other timesteps anyway.
+                const double mag2 = dx[k] * dx[k] + dy[k] * dy[k];
+                curvature[k] = mag2 < 1e-6
+                                   ? 0.0
+                                   : std::abs(dx[k] * ddy - dy[k] * ddx) / (mag2 * std::sqrt(mag2));
+            }
+            base += num_samples;
+        }
+    }
 
     // Disable curvature limiting. Our Bezier implementation has some
     // issues when the initial or final velocity is small: it places
@@ -49,103 +147,92 @@ Trajectory profile_velocity(const BezierPath& path, double initial_speed, double
     // curvature near the endpoints.
     // TODO(#1539): Switch to Hermite splines and minimize
     //  sum-squared-acceleration instead of solving for Bezier curves.
-    double max_centripetal_acceleration = constraints.max_acceleration;
-    bool limit_curvature = true;
-
-    // Velocity pass: fill points and calculate maximum velocity given curvature
-    // at each point.
-    for (int n = 0; n < num_points; n++) {
-        double s = n / static_cast<double>(num_segments);
-        path.evaluate(s, &points[n], &derivs1[n], &curvature[n]);
-
-        // Curvature is broken at small velocities (mathematically).
-        // It's okay not to limit it here because we'll be limiting it at other timesteps anyway.
-        if (derivs1[n].mag() < 1e-3) {
-            curvature[n] = 0;
-        }
+    const double max_centripetal_acceleration = constraints.max_acceleration;
+
+    // Centripetal acceleration: a = v^2 / r => v = sqrt(ra). Written without
+    // early exits so that it vectorizes; invalid curvature is reported below.
+    bool curvature_valid = true;
+    for (size_t n = 0; n < total_points; n++) {
+        const double k = curvature_[n];
+        curvature_valid &= std::isfinite(k);
+        speed_[n] = k >= 1e-6 ? std::min(constraints.max_speed,
+                                         std::sqrt(max_centripetal_acceleration / k))
+                              : constraints.max_speed;
+    }
+    if (!curvature_valid) {
+        throw std::runtime_error("Invalid curvature");
+    }
 
-        if (curvature[n] < 0.0 || !std::isfinite(curvature[n])) {
-            throw std::runtime_error("Invalid curvature");
-        }
+    for (size_t n = 0; n + 1 < total_points; n++) {
+        const double delta_x = x_[n + 1] - x_[n];
+        const double delta_y = y_[n + 1] - y_[n];
+        distance_[n] = std::sqrt(delta_x * delta_x + delta_y * delta_y);
+    }
 
-        // Centripetal acceleration: a = v^2 / r => v = sqrt(ra)
-        if (limit_curvature && curvature[n] >= 1e-6) {
-            speed[n] = std::min(speed[n], std::sqrt(max_centripetal_acceleration / curvature[n]));
+    // Note: the endpoint speeds are just suggestions. If they are impossible
+    // given MotionConstraints, then we'll limit them.
+    for (size_t i = 0; i < num_requests; i++) {
+        const size_t begin = offsets_[i];
+        const size_t end = offsets_[i + 1];
+        if (begin == end) {
+            continue;
         }
+
+        const auto curvature_limit = [&](size_t n) {
+            return curvature_[n] >= 1e-6 ? std::sqrt(max_centripetal_acceleration / curvature_[n])
+                                         : std::numeric_limits<double>::infinity();
+        };
+        speed_[begin] = std::min(requests[i].initial_speed, curvature_limit(begin));
+        speed_[end - 1] = std::min({constraints.max_speed, requests[i].final_speed,
+                                    curvature_limit(end - 1)});
     }
+}
 
+void VelocityProfiler::limit_acceleration_range(size_t begin, size_t end,
+                                                const MotionConstraints& constraints) {
     // Acceleration pass: calculate maximum velocity at each point based on
     // acceleration limits forwards in time.
-    for (int n = 0; n < num_points - 2; n++) {
-        double max_tangential_acceleration = constraints.max_acceleration;
-
+    for (size_t n = begin; n + 2 < end; n++) {
+        // Leave room for the centripetal acceleration.
         // TODO(#1539): Re-enable curvature limiting
-        if (limit_curvature) {
-            double centripetal_acceleartion = speed[n] * speed[n] * curvature[n];
-            double squared_max_tangential_acceleration =
-                std::pow(constraints.max_acceleration, 2) - std::pow(centripetal_acceleartion, 2);
-
-            // This can occur when our initial speed is fast enough that we
-            // will slip no matter what.
-            if (squared_max_tangential_acceleration <= 0) {
-                squared_max_tangential_acceleration = 0;
-            }
-
-            max_tangential_acceleration = std::sqrt(squared_max_tangential_acceleration);
-        }
+        const double centripetal_acceleration = speed_[n] * speed_[n] * curvature_[n];
+        const double squared_max_tangential_acceleration =
+            std::max(0.0, std::pow(constraints.max_acceleration, 2) -
+                              std::pow(centripetal_acceleration, 2));
+        const double max_tangential_acceleration = std::sqrt(squared_max_tangential_acceleration);
 
         if (!std::isfinite(max_tangential_acceleration)) {
             throw std::runtime_error("Invalid maximum tangential acceleration");
         }
 
-        double distance = (points[n + 1] - points[n]).mag();
-        speed[n + 1] =
-            limit_acceleration(speed[n], speed[n + 1], distance, max_tangential_acceleration);
+        speed_[n + 1] = limit_acceleration(speed_[n], speed_[n + 1], distance_[n],
+                                           max_tangential_acceleration);
     }
 
     // Deceleration pass: calculate maximum velocity at each point based on
-    // acceleration limits backwards in time.
-    for (int n = num_points - 1; n > 1; n--) {
-        double max_tangential_acceleration = constraints.max_acceleration;
-
-        // TODO(#1539): Re-enable curvature limiting
-        if (limit_curvature) {
-            double centripetal_acceleration = speed[n] * speed[n] * curvature[n];
-            double squared_max_tangential_acceleration =
-                std::pow(constraints.max_acceleration, 2) - std::pow(centripetal_acceleration, 2);
-
-            // This can occur when our initial speed is fast enough that we
-            // will slip no matter what.
-            if (squared_max_tangential_acceleration <= 0) {
-                squared_max_tangential_acceleration = 0;
-            }
-
-            double max_tangential_acceleration = std::sqrt(squared_max_tangential_acceleration);
-        }
-
-        if (!std::isfinite(max_tangential_acceleration)) {
-            throw std::runtime_error("Invalid max tangential acceleration");
-        }
-
-        double distance = (points[n - 1] - points[n]).mag();
-        speed[n - 1] =
-            limit_acceleration(speed[n], speed[n - 1], distance, max_tangential_acceleration);
+    // acceleration limits backwards in time. This has always used the full
+    // acceleration limit, without leaving room for centripetal acceleration.
+    for (size_t n = end - 1; n > begin + 1; n--) {
+        speed_[n - 1] = limit_acceleration(speed_[n], speed_[n - 1], distance_[n - 1],
+                                           constraints.max_acceleration);
     }
+}
 
-    Trajectory trajectory{{}};
-
-    Pose initial_pose{points[0], 0};
-    Twist initial_twist{derivs1[0].normalized(speed[0]), 0};
-    trajectory.append_instant(RobotInstant{initial_pose, initial_twist, initial_time});
+Trajectory VelocityProfiler::build_trajectory(size_t begin, size_t end,
+                                              RJ::Time initial_time) const {
+    RobotInstantSequence instants;
+    instants.reserve(end - begin);
 
-    for (int n = 1; n < num_points; n++) {
-        Point delta_pos = points[n] - points[n - 1];
+    Pose initial_pose{Point(x_[begin], y_[begin]), 0};
+    Twist initial_twist{Point(dx_[begin], dy_[begin]).normalized(speed_[begin]), 0};
+    instants.emplace_back(initial_pose, initial_twist, initial_time);
 
-        double distance = delta_pos.mag();
+    for (size_t n = begin + 1; n < end; n++) {
+        double distance = distance_[n - 1];
 
         // Average speed over the interval. We assume constant acceleration,
         // which is true in the limit of small intervals.
-        double average_speed = (speed[n] + speed[n - 1]) / 2;
+        double average_speed = (speed_[n] + speed_[n - 1]) / 2;
         double interval_time = distance / average_speed;
 
         if (average_speed == 0 || !std::isfinite(average_speed)) {
@@ -156,10 +243,10 @@ Trajectory profile_velocity(const BezierPath& path, double initial_speed, double
             throw std::runtime_error("Invalid interval time");
         }
 
-        RJ::Time current_time = trajectory.last().stamp + RJ::Seconds(interval_time);
+        RJ::Time current_time = instants.back().stamp + RJ::Seconds(interval_time);
 
-        Pose pose{points[n], 0};
-        Twist twist{derivs1[n].normalized(speed[n]), 0};
+        Pose pose{Point(x_[n], y_[n]), 0};
+        Twist twist{Point(dx_[n], dy_[n]).normalized(speed_[n]), 0};
 
         // TODO (someone): Make sure destination points sent to planner are within the field radius
         // A bug exists where a point incredibly far from the field is targetted
@@ -171,9 +258,50 @@ Trajectory profile_velocity(const BezierPath& path, double initial_speed, double
         }
 
         // Add point n in
-        trajectory.append_instant(RobotInstant{pose, twist, current_time});
+        instants.emplace_back(pose, twist, current_time);
     }
-    return std::move(trajectory);
+
+    return Trajectory{std::move(instants)};
+}
+
+Trajectory VelocityProfiler::profile(const BezierPath& path, double initial_speed,
+                                     double final_speed, const MotionConstraints& constraints,
+                                     RJ::Time initial_time) {
+    if (path.empty()) {
+        return Trajectory{{}};
+    }
+
+    const Request request{&path, initial_speed, final_speed};
+    sample(&request, 1, constraints);
+    limit_acceleration_range(offsets_[0], offsets_[1], constraints);
+    return build_trajectory(offsets_[0], offsets_[1], initial_time);
+}
+
+std::vector<Trajectory> VelocityProfiler::profile_many(const std::vector<Request>& requests,
+                                                       const MotionConstraints& constraints,
+                                                       RJ::Time initial_time) {
+    sample(requests.data(), requests.size(), constraints);
+
+    std::vector<Trajectory> result;
+    result.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        const size_t begin = offsets_[i];
+        const size_t end = offsets_[i + 1];
+        if (begin == end) {
+            result.emplace_back(RobotInstantSequence{});
+            continue;
+        }
+
+        limit_acceleration_range(begin, end, constraints);
+        result.push_back(build_trajectory(begin, end, initial_time));
+    }
+    return result;
+}
+
+Trajectory profile_velocity(const BezierPath& path, double initial_speed, double final_speed,
+                            const MotionConstraints& constraints, RJ::Time initial_time) {
+    return VelocityProfiler::thread_instance().profile(path, initial_speed, final_speed,
+                                                       constraints, initial_time);
 }
 
 }  // namespace planning
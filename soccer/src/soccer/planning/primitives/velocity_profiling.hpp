@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <planning/rotation_constraints.hpp>
 
 #include "path_smoothing.hpp"
@@ -22,10 +24,81 @@ namespace planning {
 double limit_acceleration(double velocity_initial, double velocity_final,
                           double displacement, double max_accel);
 
+/**
+ * @brief Profiles BezierPaths into trajectories, reusing its scratch buffers
+ * between calls so that profiling doesn't allocate once they have grown.
+ *
+ * Samples are stored as a structure of arrays, so the sampling and curvature
+ * limiting loops can be vectorized. profile_many() profiles several candidate
+ * paths in one pass over shared buffers.
+ *
+ * A profiler is not thread-safe; use one per thread (see thread_instance()).
+ */
+class VelocityProfiler {
+public:
+    /**
+     * @brief A path to profile, with its tangential speeds at either end.
+     */
+    struct Request {
+        const BezierPath* path;
+        double initial_speed;
+        double final_speed;
+    };
+
+    /**
+     * @brief Profile one path. See profile_velocity().
+     */
+    Trajectory profile(const BezierPath& path, double initial_speed, double final_speed,
+                       const MotionConstraints& constraints, RJ::Time initial_time);
+
+    /**
+     * @brief Profile several paths under the same constraints, all starting at
+     * @initial_time. Equivalent to calling profile() on each in turn.
+     *
+     * @return One trajectory per request, in order.
+     */
+    std::vector<Trajectory> profile_many(const std::vector<Request>& requests,
+                                         const MotionConstraints& constraints,
+                                         RJ::Time initial_time);
+
+    /**
+     * @brief A profiler owned by the calling thread.
+     */
+    static VelocityProfiler& thread_instance();
+
+    /// Each cubic segment is sampled at this many evenly spaced points.
+    static constexpr int kInterpolationsPerBezier = 40;
+
+private:
+    // Sample all requested paths into the scratch buffers, one after another,
+    // and limit their speeds by curvature. Path i occupies
+    // [offsets_[i], offsets_[i + 1]).
+    void sample(const Request* requests, size_t num_requests,
+                const MotionConstraints& constraints);
+
+    // Limit speeds along [begin, end) by tangential acceleration.
+    void limit_acceleration_range(size_t begin, size_t end, const MotionConstraints& constraints);
+
+    [[nodiscard]] Trajectory build_trajectory(size_t begin, size_t end,
+                                              RJ::Time initial_time) const;
+
+    std::vector<size_t> offsets_;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> dx_;
+    std::vector<double> dy_;
+    std::vector<double> curvature_;
+    std::vector<double> speed_;
+    // Distance from each sample to the next one in the same path.
+    std::vector<double> distance_;
+};
+
 /**
  * @brief Create a trajectory with the given path by calculating the maximum
  * possible velocity at each points given constraints on speed and acceleration.
  *
+ * Uses the calling thread's VelocityProfiler.
+ *
  * @param path A spatial path along which to move.
  * @param initial_speed The initial tangential speed along the path at
  * `initial_time`.
@@ -1,8 +1,11 @@
 #include <iostream>
 #include <random>
 
+#include <rj_constants/constants.hpp>
+
 #include <gtest/gtest.h>
 
+#include "planning/dynamic_obstacle.hpp"
 #include "planning/primitives/create_path.hpp"
 #include "planning/tests/testing_utils.hpp"
 
@@ -43,6 +46,55 @@ TEST(CreatePath, infinitesimal_rrt) {
     ASSERT_NEAR(a.duration().count(), 0.0, 1e-6);
 }
 
+TEST(CreatePath, rrt_reproducible_with_seed) {
+    ShapeSet obstacles;
+    obstacles.add(std::make_shared<Circle>(Point{0, 2}, 0.5));
+    obstacles.add(std::make_shared<Circle>(Point{0.6, 3}, 0.3));
+
+    LinearMotionInstant start{Point{0, 0.5}};
+    LinearMotionInstant goal{Point{0.2, 4}};
+    RJ::Time start_time = RJ::now();
+
+    PlanningRng rng_a(42);
+    PlanningRng rng_b(42);
+    Trajectory a = CreatePath::rrt(start, goal, MotionConstraints{}, start_time, obstacles, {}, {},
+                                   &rng_a);
+    Trajectory b = CreatePath::rrt(start, goal, MotionConstraints{}, start_time, obstacles, {}, {},
+                                   &rng_b);
+
+    ASSERT_FALSE(a.empty());
+    ASSERT_EQ(a.num_instants(), b.num_instants());
+    for (int i = 0; i < a.num_instants(); i++) {
+        EXPECT_EQ(a.instant_at(i).position(), b.instant_at(i).position());
+    }
+}
+
+TEST(CreatePath, rrt_stops_at_deadline) {
+    // A robot parked on the goal: every path hits it, so without a deadline
+    // CreatePath::rrt() keeps trying.
+    LinearMotionInstant start{Point{0, 1}};
+    LinearMotionInstant goal{Point{0, 4}};
+    RJ::Time start_time = RJ::now();
+    Trajectory parked{{RobotInstant{Pose{goal.position, 0}, Twist{}, start_time}}};
+    std::vector<DynamicObstacle> dynamic_obstacles{DynamicObstacle{kRobotRadius, &parked}};
+
+    PlanningRng rng(42);
+    CreatePath::RrtStats stats;
+    Trajectory path = CreatePath::rrt(start, goal, MotionConstraints{}, start_time, ShapeSet{},
+                                      dynamic_obstacles, {}, &rng, RJ::now(), &stats);
+
+    // One attempt is always made, and its (colliding) path is the best we have.
+    EXPECT_FALSE(path.empty());
+    EXPECT_EQ(stats.num_rrt_runs, 1);
+    EXPECT_TRUE(stats.deadline_hit);
+    EXPECT_GT(stats.time_used.count(), 0);
+
+    CreatePath::rrt(start, goal, MotionConstraints{}, start_time, ShapeSet{}, dynamic_obstacles,
+                    {}, &rng, RJ::Time::max(), &stats);
+    EXPECT_GT(stats.num_rrt_runs, 1);
+    EXPECT_FALSE(stats.deadline_hit);
+}
+
 TEST(CreatePath, success_rate) {
     std::mt19937 gen(1337);
 
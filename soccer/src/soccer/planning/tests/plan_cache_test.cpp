@@ -0,0 +1,146 @@
+#include "planning/primitives/plan_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <rj_geometry/circle.hpp>
+#include <rj_geometry/composite_shape.hpp>
+#include <rj_geometry/polygon.hpp>
+
+using namespace planning;
+using namespace rj_geometry;
+
+namespace {
+
+Trajectory straight_path(RJ::Time start) {
+    Trajectory trajectory;
+    trajectory.append_instant(RobotInstant(Pose(0, 0, 0), Twist(1, 0, 0), start));
+    trajectory.append_instant(RobotInstant(Pose(1, 0, 0), Twist(1, 0, 0), start + 1s));
+    trajectory.stamp(start);
+    return trajectory;
+}
+
+RobotConstraints default_constraints() {
+    RobotConstraints constraints;
+    constraints.mot.max_speed = 2.0;
+    constraints.mot.max_acceleration = 1.0;
+    return constraints;
+}
+
+}  // namespace
+
+TEST(PlanCache, FingerprintIgnoresFarObstaclesAndNoise) {
+    const RJ::Time start = RJ::now();
+    const Trajectory path = straight_path(start);
+    const LinearMotionInstant goal{Point(1, 0), Point(1, 0)};
+    const RobotConstraints constraints = default_constraints();
+
+    ShapeSet near;
+    near.add(std::make_shared<Circle>(Point(0.5, 0.3), 0.1));
+    ShapeSet near_with_far = near;
+    near_with_far.add(std::make_shared<Circle>(Point(3, 3), 0.1));
+    ShapeSet near_jittered;
+    near_jittered.add(std::make_shared<Circle>(Point(0.5001, 0.3), 0.1));
+    ShapeSet near_moved;
+    near_moved.add(std::make_shared<Circle>(Point(0.5, 0.2), 0.1));
+
+    const auto key = PlanCache::fingerprint(path, goal, constraints, near, {}, start);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(key, PlanCache::fingerprint(path, goal, constraints, near_with_far, {}, start));
+    EXPECT_EQ(key, PlanCache::fingerprint(path, goal, constraints, near_jittered, {}, start));
+    EXPECT_NE(key, PlanCache::fingerprint(path, goal, constraints, near_moved, {}, start));
+
+    const LinearMotionInstant other_goal{Point(1, 0.1), Point(1, 0)};
+    EXPECT_NE(key, PlanCache::fingerprint(path, other_goal, constraints, near, {}, start));
+
+    RobotConstraints slower = constraints;
+    slower.mot.max_speed = 1.0;
+    EXPECT_NE(key, PlanCache::fingerprint(path, goal, slower, near, {}, start));
+}
+
+TEST(PlanCache, FingerprintTracksShapesInsideTheSameBox) {
+    const RJ::Time start = RJ::now();
+    const Trajectory path = straight_path(start);
+    const LinearMotionInstant goal{Point(1, 0), Point(1, 0)};
+    const RobotConstraints constraints = default_constraints();
+
+    // A composite that gains a subshape inside its bounding box
+    auto composite = std::make_shared<CompositeShape>();
+    composite->add(std::make_shared<Rect>(Point(0.4, -0.2), Point(0.6, 0.2)));
+    auto grown = std::make_shared<CompositeShape>(*composite);
+    grown->add(std::make_shared<Circle>(Point(0.5, 0), 0.05));
+
+    ShapeSet before;
+    before.add(composite);
+    ShapeSet after;
+    after.add(grown);
+
+    const auto key = PlanCache::fingerprint(path, goal, constraints, before, {}, start);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_NE(key, PlanCache::fingerprint(path, goal, constraints, after, {}, start));
+
+    // A polygon whose vertex moves inside its bounding box
+    auto triangle = std::make_shared<Polygon>();
+    triangle->add_vertex(Point(0.4, -0.2));
+    triangle->add_vertex(Point(0.6, -0.2));
+    triangle->add_vertex(Point(0.4, 0.2));
+    auto square = std::make_shared<Polygon>(*triangle);
+    square->add_vertex(Point(0.6, 0.2));
+
+    ShapeSet with_triangle;
+    with_triangle.add(triangle);
+    ShapeSet with_square;
+    with_square.add(square);
+    EXPECT_NE(PlanCache::fingerprint(path, goal, constraints, with_triangle, {}, start),
+              PlanCache::fingerprint(path, goal, constraints, with_square, {}, start));
+
+    // An empty shape has no bounding box, but can still be fingerprinted
+    ShapeSet with_empty = before;
+    with_empty.add(std::make_shared<CompositeShape>());
+    EXPECT_TRUE(PlanCache::fingerprint(path, goal, constraints, with_empty, {}, start).has_value());
+}
+
+TEST(PlanCache, FingerprintTracksMovingObstacles) {
+    const RJ::Time start = RJ::now();
+    const Trajectory path = straight_path(start);
+    const LinearMotionInstant goal{Point(1, 0), Point(1, 0)};
+    const RobotConstraints constraints = default_constraints();
+
+    Trajectory parked;
+    parked.append_instant(RobotInstant(Pose(0.5, 0.3, 0), Twist(), start));
+    Trajectory driving;
+    driving.append_instant(RobotInstant(Pose(0.5, 0.3, 0), Twist(0, 1, 0), start));
+    driving.append_instant(RobotInstant(Pose(0.5, 1.3, 0), Twist(0, 1, 0), start + 1s));
+
+    const std::vector<DynamicObstacle> parked_obstacles{DynamicObstacle(0.1, &parked)};
+    const std::vector<DynamicObstacle> driving_obstacles{DynamicObstacle(0.1, &driving)};
+
+    // A parked robot looks the same from one frame to the next...
+    EXPECT_EQ(PlanCache::fingerprint(path, goal, constraints, {}, parked_obstacles, start),
+              PlanCache::fingerprint(path, goal, constraints, {}, parked_obstacles, start + 16ms));
+
+    // ...but a moving one doesn't.
+    EXPECT_NE(PlanCache::fingerprint(path, goal, constraints, {}, driving_obstacles, start),
+              PlanCache::fingerprint(path, goal, constraints, {}, driving_obstacles, start + 16ms));
+}
+
+TEST(PlanCache, MatchesOnlyTheStoredTrajectory) {
+    const RJ::Time start = RJ::now();
+    Trajectory path = straight_path(start);
+
+    PlanCache cache;
+    EXPECT_FALSE(cache.matches(path, 1));
+
+    cache.store(path, 1, false);
+    EXPECT_TRUE(cache.matches(path, 1));
+    EXPECT_FALSE(cache.matches(path, 2));
+
+    path.stamp(start + 16ms);
+    EXPECT_FALSE(cache.matches(path, 1));
+
+    cache.store(path, 1, true);
+    EXPECT_TRUE(cache.matches(path, 1));
+    EXPECT_TRUE(cache.improve_tried());
+
+    cache.clear();
+    EXPECT_FALSE(cache.matches(path, 1));
+}
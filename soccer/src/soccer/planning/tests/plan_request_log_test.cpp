@@ -0,0 +1,64 @@
+#include "planning/planner/plan_request_log.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace planning;
+using namespace rj_geometry;
+
+TEST(PlanRequestLog, RoundTrip) {
+    const std::string path = ::testing::TempDir() + "plan_request_log_round_trip.bin";
+    std::remove(path.c_str());
+
+    WorldState world_state;
+    world_state.ball = BallState{Point{1, 2}, Point{0, -1}, RJ::now()};
+
+    ShapeSet obstacles;
+    obstacles.add(std::make_shared<Circle>(Point{0, 3}, 0.5));
+
+    RobotInstant start{Pose{Point{0, 1}, 0.5}, Twist{Point{0.2, 0}, 0}, RJ::now()};
+    MotionCommand command{"path_target", LinearMotionInstant{Point{1, 5}}};
+    PlanRequest request{start, command,     RobotConstraints{}, obstacles, {}, nullptr,
+                        3,     &world_state, 2};
+
+    {
+        PlanRequestWriter writer(path);
+        writer.write(request);
+        writer.write(request);
+    }
+
+    std::vector<RecordedPlanRequest> records = read_plan_requests(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(records.size(), 2);
+    const RecordedPlanRequest& record = records[0];
+    EXPECT_EQ(record.start.position(), start.position());
+    EXPECT_EQ(record.motion_command.name, "path_target");
+    EXPECT_EQ(record.motion_command.target.position, command.target.position);
+    EXPECT_EQ(record.field_obstacles.shapes().size(), 1);
+    EXPECT_EQ(record.shell_id, 3);
+    EXPECT_EQ(record.priority, 2);
+    EXPECT_EQ(record.world_state.ball.position, world_state.ball.position);
+
+    PlanRequest replayed = record.make_request();
+    EXPECT_EQ(replayed.world_state, &record.world_state);
+    EXPECT_EQ(replayed.shell_id, 3);
+}
+
+TEST(PlanRequestLog, ThrowsIfLogCantBeOpened) {
+    const std::string path = ::testing::TempDir() + "no_such_directory/plan_request_log.bin";
+    EXPECT_THROW(PlanRequestWriter writer(path), std::runtime_error);
+}
+
+TEST(PlanRequestLog, ThrowsOnTruncatedLog) {
+    const std::string path = ::testing::TempDir() + "plan_request_log_truncated.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write("\x10\x00\x00\x00\x01", 5);
+    }
+
+    EXPECT_THROW(read_plan_requests(path), std::runtime_error);
+    std::remove(path.c_str());
+}
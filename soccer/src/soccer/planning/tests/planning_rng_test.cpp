@@ -0,0 +1,57 @@
+#include "planning/primitives/planning_rng.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace planning;
+
+TEST(PlanningRng, SameSeedSameSequence) {
+    PlanningRng a(1234);
+    PlanningRng b(1234);
+    PlanningRng c(1235);
+
+    bool any_different = false;
+    for (int i = 0; i < 100; i++) {
+        const auto value = a();
+        EXPECT_EQ(value, b());
+        any_different |= value != c();
+    }
+    EXPECT_TRUE(any_different);
+}
+
+TEST(PlanningRng, KeyedByRobotAndFrame) {
+    EXPECT_EQ(PlanningRng::for_robot(3, 100)(), PlanningRng::for_robot(3, 100)());
+    EXPECT_NE(PlanningRng::for_robot(3, 100)(), PlanningRng::for_robot(4, 100)());
+    EXPECT_NE(PlanningRng::for_robot(3, 100)(), PlanningRng::for_robot(3, 101)());
+}
+
+TEST(PlanningRng, UniformRange) {
+    PlanningRng rng(7);
+    double sum = 0;
+    constexpr int kSamples = 10000;
+    for (int i = 0; i < kSamples; i++) {
+        const double u = rng.uniform();
+        ASSERT_GE(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        sum += u;
+
+        ASSERT_LT(rng.index(6), 6);
+    }
+    EXPECT_NEAR(sum / kSamples, 0.5, 0.02);
+}
+
+TEST(PlanningRng, ScopedBinding) {
+    PlanningRng outer(1);
+    PlanningRng inner(2);
+    PlanningRng* fallback = &PlanningRng::current();
+
+    {
+        PlanningRng::ScopedBinding bind_outer(&outer);
+        EXPECT_EQ(&PlanningRng::current(), &outer);
+        {
+            PlanningRng::ScopedBinding bind_inner(&inner);
+            EXPECT_EQ(&PlanningRng::current(), &inner);
+        }
+        EXPECT_EQ(&PlanningRng::current(), &outer);
+    }
+    EXPECT_EQ(&PlanningRng::current(), fallback);
+}
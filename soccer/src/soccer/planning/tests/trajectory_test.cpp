@@ -1,5 +1,7 @@
 #include "planning/trajectory.hpp"
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <rrt/planning/Path.hpp>
@@ -10,6 +12,7 @@
 #include "planning/primitives/path_smoothing.hpp"
 #include "planning/primitives/rrt_util.hpp"
 #include "planning/primitives/velocity_profiling.hpp"
+#include "planning/trajectory_utils.hpp"
 #include "testing_utils.hpp"
 
 using namespace planning;
@@ -124,6 +127,70 @@ TEST(Trajectory, TrajectoryCursor) {
     EXPECT_FALSE(cursor.has_value());
 }
 
+TEST(Trajectory, CursorSeekMatchesEvaluate) {
+    RobotConstraints constraints;
+    BezierPath path({Point{0, 0}, Point{1, 1}, Point{2, 0}, Point{1, -1}}, Point(0, 0),
+                    Point(0, 0), constraints.mot);
+    Trajectory trajectory = profile_velocity(path, 0, 0, constraints.mot, RJ::Time(0s));
+    ASSERT_GT(trajectory.num_instants(), 100);
+
+    const auto expect_matches = [&](Trajectory::Cursor& cursor, RJ::Time time) {
+        cursor.seek(time);
+        ASSERT_TRUE(cursor.has_value());
+        EXPECT_TRUE(RobotInstant::nearly_equals(cursor.value(), *trajectory.evaluate(time)));
+    };
+
+    // Short forward seeks, long forward seeks, and backwards seeks.
+    auto cursor = trajectory.cursor_begin();
+    for (RJ::Time t = trajectory.begin_time(); t < trajectory.end_time(); t = t + 10ms) {
+        expect_matches(cursor, t);
+    }
+    expect_matches(cursor, trajectory.begin_time() + trajectory.duration() * 0.1);
+    expect_matches(cursor, trajectory.begin_time() + trajectory.duration() * 0.9);
+    expect_matches(cursor, trajectory.begin_time());
+    expect_matches(cursor, trajectory.end_time());
+}
+
+TEST(Trajectory, EvaluateMany) {
+    RobotConstraints constraints;
+    BezierPath path({Point{0, 0}, Point{1, 1}, Point{2, 0}}, Point(0, 0), Point(0, 0),
+                    constraints.mot);
+    Trajectory trajectory = profile_velocity(path, 0, 0, constraints.mot, RJ::Time(0s));
+
+    // Include a time before the start, every knot, and a time past the end.
+    std::vector<RJ::Time> times{trajectory.begin_time() - 1s};
+    for (const RobotInstant& instant : trajectory.instants()) {
+        times.push_back(instant.stamp);
+        times.push_back(instant.stamp + 1ms);
+    }
+
+    std::vector<RobotInstant> batch(times.size());
+    trajectory.evaluate_many(times.data(), times.size(), batch.data());
+
+    EXPECT_EQ(batch.front(), trajectory.first());
+    EXPECT_EQ(batch.back(), trajectory.last());
+    for (size_t i = 1; i + 1 < times.size(); i++) {
+        auto expected = trajectory.evaluate(times[i]);
+        ASSERT_TRUE(expected.has_value());
+        EXPECT_TRUE(RobotInstant::nearly_equals(batch[i], *expected));
+    }
+
+    constexpr size_t kNumSamples = 50;
+    std::vector<RobotInstant> resampled(kNumSamples);
+    const RJ::Seconds dt = trajectory.duration() / static_cast<double>(kNumSamples - 1);
+    trajectory.evaluate_many(trajectory.begin_time(), dt, kNumSamples, resampled.data());
+    for (size_t i = 0; i < kNumSamples; i++) {
+        auto expected = trajectory.evaluate(std::min(
+            trajectory.end_time(), trajectory.begin_time() + dt * static_cast<double>(i)));
+        ASSERT_TRUE(expected.has_value());
+        EXPECT_TRUE(RobotInstant::nearly_equals(resampled[i], *expected));
+    }
+
+    std::reverse(times.begin(), times.end());
+    EXPECT_THROW(trajectory.evaluate_many(times.data(), times.size(), batch.data()),
+                 std::invalid_argument);
+}
+
 TEST(Trajectory, BezierPath) {
     std::vector<Point> points = {Point(0, 0), Point(1, 0.5), Point(1.5, 1), Point(2, 2)};
 
@@ -240,3 +307,66 @@ TEST(Trajectory, CombiningFail) {
     // better path planner that will let us find a cleaner solution to this problem, but for now,
     // this basic solution is the best way to avoid flaws.
 }
+
+TEST(Trajectory, HitsStaticBetweenSamples) {
+    // At 8 m/s the robot covers 0.4m every 0.05s, more than the width of this
+    // (inflated) obstacle, so a fixed-step check could skip right over it.
+    RobotInstant a{Pose{{0, 0}, 0}, Twist{{8, 0}, 0}, RJ::Time(0s)};
+    RobotInstant b{Pose{{4, 0}, 0}, Twist{{8, 0}, 0}, RJ::Time(500ms)};
+    Trajectory traj{{a, b}};
+
+    ShapeSet obstacles;
+    obstacles.add(std::make_shared<Circle>(Point{1.02, 0.05}, 0.01));
+
+    RJ::Time hit_time;
+    ASSERT_TRUE(trajectory_hits_static(traj, obstacles, traj.begin_time(), &hit_time));
+
+    // The robot first touches the obstacle a bit before x = 1.02.
+    auto hit_instant = traj.evaluate(hit_time);
+    ASSERT_TRUE(hit_instant.has_value());
+    EXPECT_NEAR(hit_instant->position().x(), 0.933, 0.03);
+
+    // Starting past the obstacle, there is nothing left to hit.
+    EXPECT_FALSE(trajectory_hits_static(traj, obstacles, RJ::Time(200ms), nullptr));
+}
+
+TEST(Trajectory, IgnoresStaticStartHits) {
+    RobotInstant a{Pose{{0, 0}, 0}, Twist{{1, 0}, 0}, RJ::Time(0s)};
+    RobotInstant b{Pose{{2, 0}, 0}, Twist{{1, 0}, 0}, RJ::Time(2s)};
+    Trajectory traj{{a, b}};
+
+    ShapeSet obstacles;
+    obstacles.add(std::make_shared<Rect>(Point{-0.5, -0.5}, Point{0.5, 0.5}));
+    EXPECT_FALSE(trajectory_hits_static(traj, obstacles, traj.begin_time(), nullptr));
+
+    obstacles.add(std::make_shared<Circle>(Point{1.5, 0.1}, 0.05));
+    EXPECT_TRUE(trajectory_hits_static(traj, obstacles, traj.begin_time(), nullptr));
+}
+
+TEST(Trajectory, HitsDynamicHeadOn) {
+    // Two robots driving straight at each other at 4 m/s each.
+    RobotInstant a{Pose{{0, 0}, 0}, Twist{{4, 0}, 0}, RJ::Time(0s)};
+    RobotInstant b{Pose{{4, 0}, 0}, Twist{{4, 0}, 0}, RJ::Time(1s)};
+    Trajectory traj{{a, b}};
+
+    RobotInstant obs_a{Pose{{4, 0}, 0}, Twist{{-4, 0}, 0}, RJ::Time(0s)};
+    RobotInstant obs_b{Pose{{0, 0}, 0}, Twist{{-4, 0}, 0}, RJ::Time(1s)};
+    Trajectory obs_traj{{obs_a, obs_b}};
+    std::vector<DynamicObstacle> obstacles{DynamicObstacle{kRobotRadius, &obs_traj}};
+
+    Circle hit_circle;
+    RJ::Time hit_time;
+    ASSERT_TRUE(trajectory_hits_dynamic(traj, obstacles, traj.begin_time(), &hit_circle,
+                                        &hit_time));
+
+    // Contact when the centers are two robot radii apart: 8t = 4 - 2r.
+    const double expected = (4 - 2 * kRobotRadius) / 8;
+    EXPECT_NEAR(RJ::num_seconds(hit_time - traj.begin_time()), expected, 0.01);
+    EXPECT_NEAR(hit_circle.center.x(), 4 - 4 * expected, 0.05);
+
+    // An obstacle that stays well off to the side is never hit.
+    Trajectory far_traj{{RobotInstant{Pose{{2, 1}, 0}, Twist{}, RJ::Time(0s)}}};
+    std::vector<DynamicObstacle> far_obstacles{DynamicObstacle{kRobotRadius, &far_traj}};
+    EXPECT_FALSE(
+        trajectory_hits_dynamic(traj, far_obstacles, traj.begin_time(), nullptr, nullptr));
+}
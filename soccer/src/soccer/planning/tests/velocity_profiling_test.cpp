@@ -47,6 +47,43 @@ TEST(VelocityProfiling, ComplexPath) {
     TestingUtils::check_trajectory_continuous(result, constraints);
 }
 
+TEST(VelocityProfiling, BatchMatchesSingle) {
+    RobotConstraints constraints;
+    BezierPath first({Point{0, 0}, Point{1, 1}, Point{2, 0}}, Point(1, 0), Point(1, 0),
+                     constraints.mot);
+    BezierPath empty({}, Point(), Point(), constraints.mot);
+    BezierPath second({Point{0, 0}, Point{1, -1}, Point{0, -2}, Point{2, -2}}, Point(0, 0),
+                      Point(0, 0), constraints.mot);
+
+    RJ::Time start_time{0s};
+
+    VelocityProfiler profiler;
+    std::vector<Trajectory> batch = profiler.profile_many(
+        {{&first, 0.5, 0}, {&empty, 0, 0}, {&second, 0, 0.2}}, constraints.mot, start_time);
+    ASSERT_EQ(batch.size(), 3u);
+
+    std::vector<Trajectory> single{
+        profile_velocity(first, 0.5, 0, constraints.mot, start_time),
+        profile_velocity(empty, 0, 0, constraints.mot, start_time),
+        profile_velocity(second, 0, 0.2, constraints.mot, start_time),
+    };
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        ASSERT_EQ(batch[i].num_instants(), single[i].num_instants());
+        for (int n = 0; n < batch[i].num_instants(); n++) {
+            EXPECT_EQ(batch[i].instant_at(n), single[i].instant_at(n));
+        }
+    }
+    EXPECT_TRUE(batch[1].empty());
+    TestingUtils::check_trajectory_continuous(batch[2], constraints);
+
+    // Reusing the profiler's buffers for a smaller request must not leave
+    // stale samples behind.
+    Trajectory again = profiler.profile(first, 0.5, 0, constraints.mot, start_time);
+    ASSERT_EQ(again.num_instants(), batch[0].num_instants());
+    EXPECT_EQ(again.last(), batch[0].last());
+}
+
 TEST(VelocityProfiling, ClampAccel) {
     ASSERT_NEAR(limit_acceleration(1, 20, 1.5, 1), 2, 1e-6);
     ASSERT_NEAR(limit_acceleration(0, 5, 0.5, 1), 1, 1e-6);
@@ -0,0 +1,48 @@
+#include <rj_utils/worker_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using rj_utils::WorkerPool;
+
+TEST(WorkerPool, RunsEveryTaskOnce) {
+    WorkerPool pool(4);
+    EXPECT_EQ(pool.num_threads(), 4);
+
+    std::vector<std::atomic_int> counts(16);
+    std::vector<std::function<void()>> tasks;
+    for (auto& count : counts) {
+        tasks.emplace_back([&count]() { count++; });
+    }
+
+    // Run several frames to make sure workers pick up later batches too.
+    for (int frame = 0; frame < 100; frame++) {
+        pool.run_all(tasks);
+    }
+
+    for (const auto& count : counts) {
+        EXPECT_EQ(count, 100);
+    }
+}
+
+TEST(WorkerPool, SingleThread) {
+    WorkerPool pool(1);
+    int sum = 0;
+    pool.run_all({[&]() { sum += 1; }, [&]() { sum += 2; }});
+    EXPECT_EQ(sum, 3);
+
+    pool.run_all({});
+}
+
+TEST(WorkerPool, RethrowsAfterBarrier) {
+    WorkerPool pool(3);
+    std::atomic_int finished{0};
+    std::vector<std::function<void()>> tasks{
+        [&]() { finished++; }, []() { throw std::runtime_error("planner failed"); },
+        [&]() { finished++; }, [&]() { finished++; }};
+
+    EXPECT_THROW(pool.run_all(tasks), std::runtime_error);
+    EXPECT_EQ(finished, 3);
+}
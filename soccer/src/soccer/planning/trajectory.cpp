@@ -1,5 +1,6 @@
 #include "trajectory.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <spdlog/spdlog.h>
@@ -13,6 +14,112 @@ namespace planning {
 using rj_geometry::Pose;
 using rj_geometry::Twist;
 
+namespace {
+
+/**
+ * Cubic Hermite interpolation between two knots, at interpolation factor
+ * s in [0, 1] over an interval of length dt seconds.
+ *
+ * We've rescaled the problem to exist in the range [0, 1] instead of
+ * [t0, t1] by adjusting the tangent vectors, so now we can interpolate
+ * using a Hermite spline. The coefficients for the pose can be found at
+ * https://en.wikipedia.org/wiki/Cubic_Hermite_spline. The coefficients for
+ * the twist are chosen to be the derivative of the pose with respect to s,
+ * and then it is rescaled to match the time derivative.
+ *
+ * This works on plain doubles rather than Pose and Twist so that it stays
+ * cheap in tight sampling loops.
+ */
+RobotInstant hermite_instant(const RobotInstant& a, const RobotInstant& b, double dt, double s,
+                             RJ::Time time) {
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    const double h00 = 2 * s3 - 3 * s2 + 1;
+    const double h10 = (s3 - 2 * s2 + s) * dt;
+    const double h01 = -2 * s3 + 3 * s2;
+    const double h11 = (s3 - s2) * dt;
+
+    const double d00 = (6 * s2 - 6 * s) / dt;
+    const double d10 = 3 * s2 - 4 * s + 1;
+    const double d01 = (-6 * s2 + 6 * s) / dt;
+    const double d11 = 3 * s2 - 2 * s;
+
+    const auto interpolate = [&](double p0, double v0, double p1, double v1, double* position,
+                                 double* velocity) {
+        *position = p0 * h00 + v0 * h10 + p1 * h01 + v1 * h11;
+        *velocity = p0 * d00 + v0 * d10 + p1 * d01 + v1 * d11;
+    };
+
+    double x = 0;
+    double y = 0;
+    double h = 0;
+    double vx = 0;
+    double vy = 0;
+    double vh = 0;
+    interpolate(a.position().x(), a.linear_velocity().x(), b.position().x(),
+                b.linear_velocity().x(), &x, &vx);
+    interpolate(a.position().y(), a.linear_velocity().y(), b.position().y(),
+                b.linear_velocity().y(), &y, &vy);
+    interpolate(a.heading(), a.angular_velocity(), b.heading(), b.angular_velocity(), &h, &vh);
+
+    return RobotInstant{Pose(x, y, h), Twist(vx, vy, vh), time};
+}
+
+/**
+ * Evaluate @instants at @count sorted times, given by @time_at(i), walking
+ * the knots alongside the sample times so the whole batch costs
+ * O(knots + samples).
+ */
+template <typename TimeAt>
+void evaluate_sorted(const RobotInstantSequence& instants, size_t count, TimeAt time_at,
+                     RobotInstant* out) {
+    if (count == 0) {
+        return;
+    }
+    if (instants.empty()) {
+        throw std::invalid_argument("Cannot evaluate an empty trajectory");
+    }
+
+    auto knot = instants.begin();
+    const auto last_knot = instants.end() - 1;
+    RJ::Time previous_time = RJ::Time::min();
+    for (size_t i = 0; i < count; i++) {
+        const RJ::Time time = time_at(i);
+        if (time < previous_time) {
+            throw std::invalid_argument("Sample times must be sorted");
+        }
+        previous_time = time;
+
+        if (time <= knot->stamp) {
+            // Only possible before the first knot, or exactly on a knot.
+            out[i] = *knot;
+            continue;
+        }
+
+        while (knot != last_knot && (knot + 1)->stamp < time) {
+            ++knot;
+        }
+
+        if (knot == last_knot) {
+            out[i] = *last_knot;
+            continue;
+        }
+
+        const RobotInstant& next = *(knot + 1);
+        if (time == next.stamp) {
+            out[i] = next;
+            continue;
+        }
+
+        const double dt = RJ::num_seconds(next.stamp - knot->stamp);
+        const double s = RJ::num_seconds(time - knot->stamp) / dt;
+        out[i] = hermite_instant(*knot, next, dt, s, time);
+    }
+}
+
+}  // namespace
+
 Trajectory::Trajectory(Trajectory a, const Trajectory& b) {
     if (a.empty() || b.empty()) {
         throw std::invalid_argument("Cannot splice empty trajectories");
@@ -99,6 +206,16 @@ std::optional<RobotInstant> Trajectory::evaluate(RJ::Time time) const {
     return cursor.value();
 }
 
+void Trajectory::evaluate_many(const RJ::Time* times, size_t count, RobotInstant* out) const {
+    evaluate_sorted(instants_, count, [times](size_t i) { return times[i]; }, out);
+}
+
+void Trajectory::evaluate_many(RJ::Time start, RJ::Seconds dt, size_t count,
+                               RobotInstant* out) const {
+    evaluate_sorted(
+        instants_, count, [=](size_t i) { return start + dt * static_cast<double>(i); }, out);
+}
+
 RobotInstant Trajectory::interpolated_instant(const RobotInstant& prev_entry,
                                               const RobotInstant& next_entry, RJ::Time time) {
     if (time < prev_entry.stamp || time > next_entry.stamp) {
@@ -122,32 +239,7 @@ RobotInstant Trajectory::interpolated_instant(const RobotInstant& prev_entry,
         throw std::runtime_error("Interpolant `s` is out of bounds!");
     }
 
-    Pose pose_0 = prev_entry.pose;
-    Pose pose_1 = next_entry.pose;
-    Twist tangent_0 = prev_entry.velocity * RJ::num_seconds(dt);
-    Twist tangent_1 = next_entry.velocity * RJ::num_seconds(dt);
-
-    // Cubic interpolation.
-    // We've rescaled the problem to exist in the range [0, 1] instead of
-    // [t0, t1] by adjusting the tangent vectors, so now we can interpolate
-    // using a Hermite spline. The coefficients for `interpolated_pose` can be
-    // found at https://en.wikipedia.org/wiki/Cubic_Hermite_spline. The
-    // coefficients for `interpolated_twist` are chosen to be the derivative of
-    // `interpolated_pose` with respect to s, and then it is rescaled to match
-    // the time derivative
-    Pose interpolated_pose = Pose(Eigen::Vector3d(pose_0) * (2 * s * s * s - 3 * s * s + 1) +
-                                  Eigen::Vector3d(tangent_0) * (s * s * s - 2 * s * s + s) +
-                                  Eigen::Vector3d(pose_1) * (-2 * s * s * s + 3 * s * s) +
-                                  Eigen::Vector3d(tangent_1) * (s * s * s - s * s));
-
-    Twist interpolated_twist = Twist(Eigen::Vector3d(pose_0) * (6 * s * s - 6 * s) +
-                                     Eigen::Vector3d(tangent_0) * (3 * s * s - 4 * s + 1) +
-                                     Eigen::Vector3d(pose_1) * (-6 * s * s + 6 * s) +
-                                     Eigen::Vector3d(tangent_1) * (3 * s * s - 2 * s)) /
-                               RJ::num_seconds(dt);
-
-    // Create a new RobotInstant with the correct values.
-    return RobotInstant{interpolated_pose, interpolated_twist, time};
+    return hermite_instant(prev_entry, next_entry, RJ::num_seconds(dt), s, time);
 }
 
 Trajectory Trajectory::sub_trajectory(RJ::Time clip_start_time, RJ::Time clip_end_time) const {
@@ -280,22 +372,37 @@ void Trajectory::Cursor::seek(RJ::Time time) {
         return;
     }
 
-    // Note that this comparison is less than or equal to.
-    auto compare_times = [](const RobotInstant& a, const RobotInstant& b) -> bool {
-        return a.stamp <= b.stamp;
-    };
+    const auto begin = trajectory_.instants_.begin();
+    const auto end = trajectory_.instants_.end();
+
+    // We want the _last_ instant with instant.stamp <= time. Start looking
+    // from the current knot if it's at or before the target, since dense
+    // sampling mostly seeks forwards by less than a knot.
+    auto search_begin = begin;
+    auto search_end = end;
+    if (iterator_ != end && iterator_->stamp <= time) {
+        for (int i = 0; i < kMaxLinearSeekSteps; i++) {
+            auto next = iterator_ + 1;
+            if (next == end || next->stamp > time) {
+                time_ = time;
+                return;
+            }
+            iterator_ = next;
+        }
+        search_begin = iterator_;
+    } else if (iterator_ != end) {
+        search_end = iterator_;
+    }
 
-    RobotInstant dummy_instant;
-    dummy_instant.stamp = time;
+    // Note that this comparison is less than or equal to.
+    auto compare_times = [](const RobotInstant& a, RJ::Time t) -> bool { return a.stamp <= t; };
 
     // std::lower_bound finds the first iterator such that the above comparison
-    // _fails_ - that is, the first instant with time < instant.stamp.
-    // We actually want the _last_ instant with instant.stamp <= time, so we
-    // can use the call to lower_bound and then take a step back.
-    iterator_ = std::lower_bound(trajectory_.instants_.begin(), trajectory_.instants_.end(),
-                                 dummy_instant, compare_times);
+    // _fails_ - that is, the first instant with time < instant.stamp. We can
+    // then take a step back.
+    iterator_ = std::lower_bound(search_begin, search_end, time, compare_times);
 
-    if (iterator_ == trajectory_.instants_.begin()) {
+    if (iterator_ == begin) {
         throw std::runtime_error(
             "Cannot seek before beginning of trajectory. This should be "
             "unreachable.");
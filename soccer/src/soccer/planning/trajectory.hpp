@@ -159,6 +159,27 @@ public:
     [[nodiscard]] std::optional<RobotInstant> evaluate(
         RJ::Seconds seconds) const;
 
+    /**
+     * @brief Evaluate this trajectory at many times at once, walking the knots
+     *  in a single pass. Much cheaper than calling evaluate() for each time
+     *  when sampling densely.
+     *
+     * Times before the beginning or after the end of the trajectory are
+     * clamped to the first or last instant. The trajectory must not be empty.
+     *
+     * @param times The times to evaluate at, in non-decreasing order.
+     * @param count The number of times (and of instants to write).
+     * @param out Caller-provided buffer of at least @count instants.
+     */
+    void evaluate_many(const RJ::Time* times, size_t count, RobotInstant* out) const;
+
+    /**
+     * @brief Evaluate this trajectory at @count evenly spaced times
+     *  start, start + dt, ... into @out. See evaluate_many().
+     */
+    void evaluate_many(RJ::Time start, RJ::Seconds dt, size_t count,
+                       RobotInstant* out) const;
+
     /**
      * @brief Returns a trajectory formed using an interval subset of this
      *  trajectory.
@@ -354,8 +375,10 @@ public:
 
         /**
          * @brief Set this cursor to an arbitrary point in time.
-         * @details Operates in O(log n) average case with n points in the
-         *  trajectory.
+         * @details Seeking forwards by a few knots is a linear walk from the
+         *  current knot, so seeking monotonically through the trajectory is
+         *  amortized O(1) per call. Longer or backwards seeks are a binary
+         *  search, O(log n) with n points in the trajectory.
          */
         void seek(RJ::Time time);
 
@@ -396,6 +419,9 @@ public:
         }
 
     private:
+        // Forward seeks further than this many knots switch to binary search.
+        static constexpr int kMaxLinearSeekSteps = 8;
+
         const Trajectory& trajectory_;
 
         // An iterator pointing to the knot point at or immediately before the
@@ -461,7 +487,8 @@ struct RosConverter<planning::Trajectory, rj_msgs::msg::Trajectory> {
         }
         return rj_msgs::build<rj_msgs::msg::Trajectory>()
             .stamp(convert_to_ros(from.time_created().value()))
-            .instants(convert_to_ros(from.instants()));
+            .instants(convert_to_ros(from.instants()))
+            .trace(rj_msgs::msg::FrameTrace{});
     }
 
     static planning::Trajectory from_ros(const rj_msgs::msg::Trajectory& from) {
@@ -1,9 +1,209 @@
 #include "trajectory_utils.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include <rj_constants/constants.hpp>
 
 namespace planning {
 
+namespace {
+
+// Pieces of a trajectory shorter than this are checked with a single point
+// test instead of being split further. Obstacles are always inflated by at
+// least a robot radius, so nothing can slip between two checks this close.
+// TODO(#1525): Make these config variables.
+constexpr double kCollisionResolution = 0.02;
+
+// Guards against runaway recursion on degenerate (e.g. NaN) input.
+constexpr int kMaxSubdivisionDepth = 20;
+
+/**
+ * The xy part of a trajectory between two knots, as a cubic Bezier curve over
+ * [t0, t1] (seconds relative to the start of the collision check).
+ *
+ * Trajectory interpolates between knots with a cubic Hermite spline, which is
+ * the same curve as a Bezier with inner control points one third of the way
+ * along each tangent. In Bezier form the curve lies inside the convex hull of
+ * its control points, which gives us a cheap, conservative bounding box.
+ */
+struct BezierPiece {
+    std::array<rj_geometry::Point, 4> pts;
+    double t0;
+    double t1;
+
+    static BezierPiece from_knots(const RobotInstant& a, const RobotInstant& b,
+                                  RJ::Time origin) {
+        const double t0 = RJ::num_seconds(a.stamp - origin);
+        const double t1 = RJ::num_seconds(b.stamp - origin);
+        const double third = (t1 - t0) / 3;
+        return BezierPiece{{a.position(), a.position() + a.linear_velocity() * third,
+                            b.position() - b.linear_velocity() * third, b.position()},
+                           t0,
+                           t1};
+    }
+
+    /// A piece that stays at @pos for all time.
+    static BezierPiece stationary(rj_geometry::Point pos, double t0, double t1) {
+        return BezierPiece{{pos, pos, pos, pos}, t0, t1};
+    }
+
+    /// Split at parameter @s in [0, 1] (de Casteljau).
+    [[nodiscard]] std::pair<BezierPiece, BezierPiece> split(double s) const {
+        const rj_geometry::Point a = pts[0] + (pts[1] - pts[0]) * s;
+        const rj_geometry::Point b = pts[1] + (pts[2] - pts[1]) * s;
+        const rj_geometry::Point c = pts[2] + (pts[3] - pts[2]) * s;
+        const rj_geometry::Point ab = a + (b - a) * s;
+        const rj_geometry::Point bc = b + (c - b) * s;
+        const rj_geometry::Point mid = ab + (bc - ab) * s;
+        const double t_mid = t0 + (t1 - t0) * s;
+        return {BezierPiece{{pts[0], a, ab, mid}, t0, t_mid},
+                BezierPiece{{mid, bc, c, pts[3]}, t_mid, t1}};
+    }
+
+    /// The part of this piece between times @ta and @tb, which must lie in
+    /// [t0, t1].
+    [[nodiscard]] BezierPiece restrict(double ta, double tb) const {
+        if (t1 <= t0) {
+            return BezierPiece{{pts[0], pts[0], pts[0], pts[0]}, ta, tb};
+        }
+
+        BezierPiece result = *this;
+        if (ta > t0) {
+            result = result.split((ta - t0) / (t1 - t0)).second;
+        }
+        if (tb < t1 && result.t1 > result.t0) {
+            result = result.split((tb - result.t0) / (result.t1 - result.t0)).first;
+        }
+        result.t0 = ta;
+        result.t1 = tb;
+        return result;
+    }
+
+    [[nodiscard]] rj_geometry::Rect bbox() const {
+        rj_geometry::Rect box(pts[0]);
+        for (int i = 1; i < 4; i++) {
+            box.expand(pts[i]);
+        }
+        return box;
+    }
+};
+
+/// Diagonal of a box; an upper bound on how far apart two points in it are.
+double box_size(const rj_geometry::Rect& box) {
+    return std::hypot(box.maxx() - box.minx(), box.maxy() - box.miny());
+}
+
+/// Distance between two boxes, or zero if they overlap.
+double box_distance(const rj_geometry::Rect& a, const rj_geometry::Rect& b) {
+    const double dx = std::max({0.0, static_cast<double>(a.minx() - b.maxx()),
+                                static_cast<double>(b.minx() - a.maxx())});
+    const double dy = std::max({0.0, static_cast<double>(a.miny() - b.maxy()),
+                                static_cast<double>(b.miny() - a.maxy())});
+    return std::hypot(dx, dy);
+}
+
+/// A static obstacle that might be hit somewhere along a knot interval.
+struct StaticCandidate {
+    const rj_geometry::Shape* shape;
+    // Bounding box padded by a robot radius, or nullopt if unbounded.
+    std::optional<rj_geometry::Rect> box;
+};
+
+/**
+ * Find the first time in @piece at which the robot hits one of @candidates.
+ * Pieces whose bounding box misses every candidate's box are skipped; the
+ * rest are split until they are short enough to check with a point test.
+ */
+std::optional<double> first_static_hit(const BezierPiece& piece,
+                                       const std::vector<StaticCandidate>& candidates,
+                                       int depth) {
+    const rj_geometry::Rect box = piece.bbox();
+
+    bool any_near = false;
+    for (const StaticCandidate& candidate : candidates) {
+        if (!candidate.box.has_value() || candidate.box->intersects(box)) {
+            any_near = true;
+            break;
+        }
+    }
+    if (!any_near) {
+        return std::nullopt;
+    }
+
+    if (box_size(box) <= kCollisionResolution || depth >= kMaxSubdivisionDepth) {
+        // Only the end needs checking; the start was the end of the
+        // previous piece (or the start point, whose hits are excluded).
+        for (const StaticCandidate& candidate : candidates) {
+            if (candidate.shape->hit(piece.pts[3])) {
+                return piece.t1;
+            }
+        }
+        return std::nullopt;
+    }
+
+    const auto [first, second] = piece.split(0.5);
+    if (auto hit = first_static_hit(first, candidates, depth + 1)) {
+        return hit;
+    }
+    return first_static_hit(second, candidates, depth + 1);
+}
+
+/**
+ * Find the first time in [robot.t0, robot.t1] at which the robot comes within
+ * @radius of the obstacle. Both pieces must cover the same interval.
+ *
+ * Once both pieces are short, each is replaced by the straight line between
+ * its ends; the relative motion is then linear and the first contact time has
+ * a closed form.
+ */
+std::optional<double> first_dynamic_hit(const BezierPiece& robot, const BezierPiece& obstacle,
+                                        double radius, int depth) {
+    const rj_geometry::Rect robot_box = robot.bbox();
+    const rj_geometry::Rect obstacle_box = obstacle.bbox();
+    if (box_distance(robot_box, obstacle_box) >= radius) {
+        return std::nullopt;
+    }
+
+    if ((box_size(robot_box) <= kCollisionResolution &&
+         box_size(obstacle_box) <= kCollisionResolution) ||
+        depth >= kMaxSubdivisionDepth) {
+        // Relative position d(u) = d0 + u * (d1 - d0) for u in [0, 1]. Solve
+        // |d(u)|^2 = radius^2 for the first crossing.
+        const rj_geometry::Point d0 = robot.pts[0] - obstacle.pts[0];
+        const rj_geometry::Point d1 = robot.pts[3] - obstacle.pts[3];
+        const rj_geometry::Point dd = d1 - d0;
+
+        const double c = d0.magsq() - radius * radius;
+        if (c < 0) {
+            return robot.t0;
+        }
+
+        const double a = dd.magsq();
+        const double b = 2 * d0.dot(dd);
+        const double discriminant = b * b - 4 * a * c;
+        if (a <= 0 || discriminant < 0) {
+            return std::nullopt;
+        }
+
+        const double u = (-b - std::sqrt(discriminant)) / (2 * a);
+        if (u < 0 || u > 1) {
+            return std::nullopt;
+        }
+        return robot.t0 + u * (robot.t1 - robot.t0);
+    }
+
+    const auto [robot_first, robot_second] = robot.split(0.5);
+    const auto [obstacle_first, obstacle_second] = obstacle.split(0.5);
+    if (auto hit = first_dynamic_hit(robot_first, obstacle_first, radius, depth + 1)) {
+        return hit;
+    }
+    return first_dynamic_hit(robot_second, obstacle_second, radius, depth + 1);
+}
+
+}  // namespace
+
 bool trajectory_hits_static(const Trajectory& trajectory, const rj_geometry::ShapeSet& obstacles,
                             RJ::Time start_time, RJ::Time* hit_time) {
     if (trajectory.empty()) {
@@ -23,33 +223,46 @@ bool trajectory_hits_static(const Trajectory& trajectory, const rj_geometry::Sha
         return false;
     }
 
-    // Limit iterations to 100. This will continue to operate at dt = 0.05 until
-    // we hit a 5 second trajectory. If our trajectory is longer than that,
-    // something is probably wrong, but we'll still handle it (just scale dt
-    // accordingly).
-    // TODO(#1525): Make these config variables.
-    constexpr int kMaxIterations = 100;
-    constexpr RJ::Seconds kExpectedDt{0.05};
+    // Only count hits that we didn't start in.
+    std::vector<const rj_geometry::Shape*> start_hits;
+    obstacles.hit_if(cursor.value().position(),
+                     [&](const std::shared_ptr<rj_geometry::Shape>& obstacle) {
+                         start_hits.push_back(obstacle.get());
+                         return false;
+                     });
 
-    RJ::Seconds time_left{trajectory.end_time() - start_time};
-    RJ::Seconds dt = std::max(kExpectedDt, time_left / kMaxIterations);
+    const auto& instants = trajectory.instants();
 
-    const auto& start_hits = obstacles.hit_set(cursor.value().position());
-    while (cursor.has_value()) {
-        RobotInstant instant = cursor.value();
+    std::vector<StaticCandidate> candidates;
+    for (size_t i = 0; i + 1 < instants.size(); i++) {
+        BezierPiece piece = BezierPiece::from_knots(instants[i], instants[i + 1], start_time);
+        if (piece.t1 <= 0 || piece.t1 <= piece.t0) {
+            continue;
+        }
+        if (piece.t0 < 0) {
+            piece = piece.restrict(0, piece.t1);
+        }
 
-        // Only count hits that we didn't start in.
-        for (const auto& obstacle : obstacles.shapes()) {
-            if (obstacle->hit(instant.position()) &&
-                start_hits.find(obstacle) == start_hits.end()) {
-                if (hit_time != nullptr) {
-                    *hit_time = instant.stamp;
-                }
-                return true;
+        // Broad phase: only shapes near this whole interval can be hit.
+        candidates.clear();
+        obstacles.visit_near(piece.bbox(), [&](const std::shared_ptr<rj_geometry::Shape>& shape,
+                                               const rj_geometry::Rect* box) {
+            if (std::find(start_hits.begin(), start_hits.end(), shape.get()) == start_hits.end()) {
+                candidates.push_back(StaticCandidate{
+                    shape.get(), box != nullptr ? std::make_optional(*box) : std::nullopt});
             }
+            return false;
+        });
+        if (candidates.empty()) {
+            continue;
         }
 
-        cursor.advance(dt);
+        if (auto hit = first_static_hit(piece, candidates, 0)) {
+            if (hit_time != nullptr) {
+                *hit_time = start_time + RJ::Seconds(*hit);
+            }
+            return true;
+        }
     }
 
     // No obstacles were hit, and we're through the whole trajectory.
@@ -69,74 +282,105 @@ bool trajectory_hits_dynamic(const Trajectory& trajectory,
             "be before trajectory begin");
     }
 
-    Trajectory::Cursor cursor = trajectory.cursor(start_time);
-
     // If the trajectory has already ended, we don't need to check it.
-    if (!cursor.has_value()) {
+    if (!trajectory.check_time(start_time)) {
         return false;
     }
 
-    // Limit iterations to 100. This will continue to operate at dt = 0.05 until
-    // we hit a 5 second trajectory. If our trajectory is longer than that,
-    // something is probably wrong, but we'll still handle it (just scale dt
-    // accordingly).
-    // TODO(#1525): Make these config variables.
-    constexpr int kMaxIterations = 100;
-    constexpr RJ::Seconds kExpectedDt{0.05};
-
-    RJ::Seconds time_left{trajectory.end_time() - start_time};
-    RJ::Seconds dt = std::max(kExpectedDt, time_left / kMaxIterations);
+    const auto& instants = trajectory.instants();
+    const double end = RJ::num_seconds(trajectory.end_time() - start_time);
 
     // The time of the earliest hit, if there is one. This is needed so that
     // we get the _first_ time we hit an obstacle, not necessarily the time we
     // hit the obstacle that happened to be first in the list.
-    std::optional<RJ::Time> maybe_hit_time = std::nullopt;
+    std::optional<double> maybe_hit_time = std::nullopt;
 
     for (const DynamicObstacle& obs : obstacles) {
         if (obs.path->empty()) {
             throw std::runtime_error("Empty trajectory in dynamic obstacle");
         }
 
-        cursor.seek(start_time);
-
         // Inflate obstacles by our robot's radius.
         const double total_radius = obs.circle.radius() + kRobotRadius;
 
-        // Only use the trajectory cursor in the loop condition; we use the
-        // static position after the obstacle cursor runs off the end.
-        for (auto cursor_obstacle = obs.path->cursor_begin(); cursor.has_value();
-             cursor_obstacle.advance(dt), cursor.advance(dt)) {
-            // If the earlier calculated hit was before this point, stop looking
-            // at this obstacle.
-            if (maybe_hit_time.has_value() && maybe_hit_time.value() < cursor.time()) {
-                break;
+        // The obstacle's path is played from its own beginning as of
+        // start_time (as the sampled check always did), and then holds its
+        // final position.
+        const auto& obs_instants = obs.path->instants();
+        const RJ::Time obs_origin = obs.path->begin_time();
+        const double obs_end = RJ::num_seconds(obs.path->end_time() - obs_origin);
+
+        // A zero-length trajectory is just its starting point.
+        if (end <= 0 || instants.size() < 2) {
+            const rj_geometry::Point obstacle_position = obs.path->first().position();
+            if (!maybe_hit_time.has_value() &&
+                instants.front().position().dist_to(obstacle_position) < total_radius) {
+                maybe_hit_time = 0;
+                if (out_hit_obstacle != nullptr) {
+                    *out_hit_obstacle =
+                        rj_geometry::Circle(obstacle_position, obs.circle.radius());
+                }
             }
+            continue;
+        }
 
-            rj_geometry::Point obstacle_position;
-            if (cursor_obstacle.has_value()) {
-                obstacle_position = cursor_obstacle.value().position();
-            } else {
-                obstacle_position = obs.path->last().position();
+        // Walk both trajectories' knots together, so that each step covers
+        // one Hermite segment of each.
+        size_t i = 0;
+        size_t j = 0;
+        double t = 0;
+        const double limit = maybe_hit_time.has_value() ? std::min(end, *maybe_hit_time) : end;
+        while (t < limit) {
+            while (i + 2 < instants.size() &&
+                   RJ::num_seconds(instants[i + 1].stamp - start_time) <= t) {
+                i++;
+            }
+            while (j + 1 < obs_instants.size() &&
+                   RJ::num_seconds(obs_instants[j + 1].stamp - obs_origin) <= t) {
+                j++;
             }
 
-            rj_geometry::Point robot_position = cursor.value().position();
+            BezierPiece robot_segment =
+                BezierPiece::from_knots(instants[i], instants[i + 1], start_time);
+            const bool obs_moving = t < obs_end && j + 1 < obs_instants.size();
+            double t_next = std::min(robot_segment.t1, limit);
+            BezierPiece obs_segment =
+                obs_moving ? BezierPiece::from_knots(obs_instants[j], obs_instants[j + 1], obs_origin)
+                           : BezierPiece::stationary(obs.path->last().position(), t, t_next);
+            if (obs_moving) {
+                t_next = std::min(t_next, obs_segment.t1);
+            }
+            if (t_next <= t) {
+                break;
+            }
 
-            if (robot_position.dist_to(obstacle_position) < total_radius) {
-                // We would already have broken out if we had an earlier
-                // obstacle (from the check above), so this is definitely the
+            auto hit = first_dynamic_hit(robot_segment.restrict(t, t_next),
+                                         obs_segment.restrict(t, t_next), total_radius, 0);
+            if (hit.has_value()) {
+                // We would already have stopped if we had an earlier
+                // obstacle (from the limit above), so this is definitely the
                 // earliest one.
+                maybe_hit_time = hit;
                 if (out_hit_obstacle != nullptr) {
-                    *out_hit_obstacle = rj_geometry::Circle(obstacle_position, obs.circle.radius());
+                    const auto obs_instant =
+                        obs.path->evaluate(obs_origin + RJ::Seconds(std::min(*hit, obs_end)));
+                    const rj_geometry::Point obstacle_position =
+                        obs_instant.has_value() ? obs_instant->position()
+                                                : obs.path->last().position();
+                    *out_hit_obstacle =
+                        rj_geometry::Circle(obstacle_position, obs.circle.radius());
                 }
-                maybe_hit_time = cursor.time();
+                break;
             }
+
+            t = t_next;
         }
     }
 
     // if there was a collision, send the timestamp back via out_hit_time and
     // return true (else return false and leave out_hit_time untouched)
     if (maybe_hit_time.has_value() && out_hit_time != nullptr) {
-        *out_hit_time = maybe_hit_time.value();
+        *out_hit_time = start_time + RJ::Seconds(maybe_hit_time.value());
     }
     return maybe_hit_time.has_value();
 }
@@ -10,6 +10,7 @@
 
 #include "debug_drawer.hpp"
 #include "radio/packet_convert.hpp"
+#include "world_state_cache.hpp"
 
 using namespace boost;
 using namespace rj_geometry;
@@ -107,7 +108,7 @@ void Processor::run() {
 
         const WorldStateMsg::SharedPtr world_state_msg = world_state_queue_->get();
         if (world_state_msg != nullptr) {
-            context_.world_state = rj_convert::convert_from_ros(*world_state_msg);
+            context_.world_state = *WorldStateCache::global().get(*world_state_msg);
             cur_status.last_vision_time =
                 rj_convert::convert_from_ros(world_state_msg->last_update_time);
         }
@@ -154,6 +155,22 @@ void Processor::run() {
     }
 }
 
+bool Processor::open_log(const QString& filename) {
+    // The logger shares the history and log state with run(). Whatever file
+    // was open before finishes writing once the lock is released.
+    std::unique_ptr<LogWriter> previous;
+    auto lock = lock_loop_mutex();
+    previous = logger_->close();
+    return logger_->write(filename.toStdString());
+}
+
+void Processor::close_log() {
+    // Declared before the lock so the writer is joined after it's released.
+    std::unique_ptr<LogWriter> previous;
+    auto lock = lock_loop_mutex();
+    previous = logger_->close();
+}
+
 void Processor::stop_robots() {}
 
 void Processor::set_field_dimensions(const FieldDimensions& dims) { *current_dimensions = dims; }
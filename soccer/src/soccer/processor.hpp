@@ -79,12 +79,9 @@ public:
 
     float framerate() { return framerate_; }
 
-    bool open_log(const QString& filename) {
-        logger_->write(filename.toStdString());
-        return true;
-    }
+    bool open_log(const QString& filename);
 
-    void close_log() { logger_->close(); }
+    void close_log();
 
     std::lock_guard<std::mutex> lock_loop_mutex() {
         return std::lock_guard(loop_mutex_);
@@ -2,6 +2,7 @@
 
 #include <boost/asio.hpp>
 #include <fmt/ostream.h>
+#include <rclcpp_components/register_node_macro.hpp>
 #include <spdlog/spdlog.h>
 
 #include <rj_common/network.hpp>
@@ -16,7 +17,8 @@ using ip::udp;
 
 namespace radio {
 
-NetworkRadio::NetworkRadio() : socket_(io_service_), recv_buffer_{}, send_buffers_(kNumShells) {
+NetworkRadio::NetworkRadio(const rclcpp::NodeOptions& options)
+    : Radio(options), socket_(io_service_), recv_buffer_{}, send_buffers_(kNumShells) {
     connections_.resize(kNumShells);
 
     this->get_parameter("server_port", param_server_port_);
@@ -162,3 +164,5 @@ void NetworkRadio::publish_alive_robots() {
 }
 
 }  // namespace radio
+
+RCLCPP_COMPONENTS_REGISTER_NODE(radio::NetworkRadio)
@@ -24,7 +24,7 @@ namespace radio {
  */
 class NetworkRadio : public Radio {
 public:
-    NetworkRadio();
+    explicit NetworkRadio(const rclcpp::NodeOptions& options = rclcpp::NodeOptions{});
 
 protected:
     void send(int robot_id, const rj_msgs::msg::MotionSetpoint& motion,
@@ -2,13 +2,16 @@
 
 #include <spdlog/spdlog.h>
 
+#include <rj_utils/intra_process.hpp>
+#include <rj_utils/latency_recorder.hpp>
+
 namespace radio {
 
 DEFINE_FLOAT64(kRadioParamModule, timeout, 0.25,
                "Timeout after which radio will assume a robot is disconnected. Seconds.");
 
-Radio::Radio()
-    : Node{"radio", rclcpp::NodeOptions{}
+Radio::Radio(const rclcpp::NodeOptions& options)
+    : Node{"radio", rclcpp::NodeOptions{options}
                         .automatically_declare_parameters_from_overrides(true)
                         .allow_undeclared_parameters(true)},
       param_provider_(this, kRadioParamModule) {
@@ -35,10 +38,17 @@ Radio::Radio()
             });
         motion_subs_.at(i) = create_subscription<rj_msgs::msg::MotionSetpoint>(
             control::topics::motion_setpoint_topic(i), rclcpp::QoS(1),
-            [this, i](rj_msgs::msg::MotionSetpoint::SharedPtr motion) {  // NOLINT
+            [this, i](rj_msgs::msg::MotionSetpoint::ConstSharedPtr motion) {  // NOLINT
                 last_updates_.at(i) = RJ::now();
                 send(i, *motion, manipulators_cached_.at(i), positions_.at(i));
-            });
+
+                const builtin_interfaces::msg::Time sent = rj_convert::convert_to_ros(RJ::now());
+                rj_utils::LatencyRecorder::global().record(
+                    rj_utils::LatencyStage::kControlToRadio, motion->trace.t_controlled, sent);
+                rj_utils::LatencyRecorder::global().record(rj_utils::LatencyStage::kEndToEnd,
+                                                           motion->trace.t_capture, sent);
+            },
+            rj_utils::intra_process_subscription_options());
     }
 
     tick_timer_ = create_wall_timer(std::chrono::milliseconds(16), [this]() { tick(); });
@@ -62,7 +72,8 @@ void Radio::tick() {
             const auto motion = rj_msgs::build<MotionSetpoint>()
                                     .velocity_x_mps(0)
                                     .velocity_y_mps(0)
-                                    .velocity_z_radps(0);
+                                    .velocity_z_radps(0)
+                                    .trace(rj_msgs::msg::FrameTrace{});
             const auto manipulator = rj_msgs::build<ManipulatorSetpoint>()
                                          .shoot_mode(ManipulatorSetpoint::SHOOT_MODE_KICK)
                                          .trigger_mode(ManipulatorSetpoint::TRIGGER_MODE_STAND_DOWN)
@@ -31,7 +31,7 @@ DECLARE_FLOAT64(kRadioParamModule, timeout);
  */
 class Radio : public rclcpp::Node {
 public:
-    Radio();
+    explicit Radio(const rclcpp::NodeOptions& options);
 
 protected:
     void publish(int robot_id, const rj_msgs::msg::RobotStatus& robot_status);
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <stdexcept>
 
+#include <rclcpp_components/register_node_macro.hpp>
 #include <spdlog/spdlog.h>
 
 #include <rj_common/network.hpp>
@@ -68,8 +69,8 @@ static SimulatorCommand convert_placement_to_proto(
     return packet;
 }
 
-SimRadio::SimRadio(bool blue_team)
-    : Radio(),
+SimRadio::SimRadio(const rclcpp::NodeOptions& options, bool blue_team)
+    : Radio(options),
       blue_team_(blue_team),
       socket_(io_service_, ip::udp::endpoint(ip::udp::v4(), blue_team ? kSimBlueStatusPort
                                                                       : kSimYellowStatusPort)) {
@@ -226,3 +227,5 @@ void SimRadio::send_sim_command(const SimulatorCommand& cmd) {
 }
 
 }  // namespace radio
+
+RCLCPP_COMPONENTS_REGISTER_NODE(radio::SimRadio)
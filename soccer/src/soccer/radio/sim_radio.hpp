@@ -18,7 +18,8 @@ namespace radio {
  */
 class SimRadio : public Radio {
 public:
-    SimRadio(bool blue_team = false);
+    explicit SimRadio(const rclcpp::NodeOptions& options = rclcpp::NodeOptions{},
+                      bool blue_team = false);
 
 protected:
     void send(int robot_id, const rj_msgs::msg::MotionSetpoint& motion,
@@ -1,5 +1,7 @@
 #include "coach_node.hpp"
 
+#include <rclcpp_components/register_node_macro.hpp>
+
 #include "rj_constants/topic_names.hpp"
 
 namespace strategy {
@@ -424,3 +426,5 @@ bool CoachNode::check_robot_alive(u_int8_t robot_id) {
 }
 
 }  // namespace strategy
+
+RCLCPP_COMPONENTS_REGISTER_NODE(strategy::CoachNode)
@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <functional>
+#include <string>
 
 #include <QLayout>
 #include <QPainter>
@@ -184,7 +186,7 @@ void FieldView::drawWorldSpace(QPainter& p) {
     const LogFrame* frame = _history->back().get();
 
     // Draw the field
-    drawField(p, frame);
+    drawCachedField(p, frame);
 
     // Raw vision
     if (showRawBalls || showRawRobots) {
@@ -261,33 +263,197 @@ void FieldView::drawTeamSpace(QPainter& p) {
         drawCoords(p);
     }
 
+    updateTrails();
+
     // History
     p.setBrush(Qt::NoBrush);
-    QPainterPath ballTrail;
-    bool move = false;
-    int ballTrailLength = 60;
-    for (unsigned int i = _history->size() - std::min<int>(_history->size(), ballTrailLength);
-         i < _history->size(); ++i) {
-        const LogFrame* oldFrame = _history->at(i).get();
-        if (oldFrame != nullptr && oldFrame->has_ball()) {
-            QPointF pos = qpointf(oldFrame->ball().pos());
-
-            if (!move) {
-                ballTrail.moveTo(pos);
-                move = true;
-            } else {
-                ballTrail.lineTo(pos);
-            }
-        }
-    }
     QPen ballTrailPen(ballColor, 0.03);
     ballTrailPen.setCapStyle(Qt::RoundCap);
     p.setPen(ballTrailPen);
-    p.drawPath(ballTrail);
+    p.drawPolyline(_ballTrail.points);
+
+    drawDebugLayers(p, frame);
+
+    // draw robot comet trails
+    const float cometTrailPenSize = 0.07;
+    for (const auto& [key, trail] : _robotTrails) {
+        // note: key.first is 1 for our team and 2 for their team
+        bool ourTeam = key.first == 1;
+        bool blue = frame->blue_team();
+        const QColor color = (ourTeam ^ blue) != 0 ? Qt::yellow : Qt::blue;
+        QPen pen(color, cometTrailPenSize);
+        pen.setCapStyle(Qt::RoundCap);
+        p.setPen(pen);
+        p.drawPolyline(trail.points);
+    }
+
+    // Text positioning vectors
+    QPointF rtX = qpointf(rj_geometry::Point(0, 1).rotated(-_rotate * 90));
+    QPointF rtY = qpointf(rj_geometry::Point(-1, 0).rotated(-_rotate * 90));
+
+    // Opponent robots
+    for (const LogFrame::Robot& r : frame->opp()) {
+        drawRobot(p, !frame->blue_team(), r.shell(), qpointf(r.pos()), r.angle(),
+                  r.ball_sense_status() == HasBall);
+    }
+
+    // Our robots
+    int manualID = frame->manual_id();
+    for (const LogFrame::Robot& r : frame->self()) {
+        QPointF center = qpointf(r.pos());
+
+        bool faulty = false;
+        if (r.has_ball_sense_status() &&
+            (r.ball_sense_status() == Dazzled || r.ball_sense_status() == Failed)) {
+            faulty = true;
+        }
+        if (r.has_kicker_works() && !r.kicker_works()) {
+            // 			faulty = true;
+        }
+        for (int i = 0; i < r.motor_status().size(); ++i) {
+            if (r.motor_status(i) != Good) {
+                faulty = true;
+            }
+        }
+        if (r.has_battery_voltage() && r.battery_voltage() <= 14.3f) {
+            faulty = true;
+        }
+
+        drawRobot(p, frame->blue_team(), r.shell(), center, r.angle(),
+                  r.ball_sense_status() == HasBall, faulty);
+
+        // Highlight the manually controlled robot
+        if (manualID == r.shell()) {
+            p.setPen(greenPen);
+            const float r = kRobotRadius + .05;
+            p.drawEllipse(center, r, r);
+        }
+
+        // Robot text
+        QPointF textPos = center - rtX * 0.2 - rtY * (kRobotRadius + 0.1);
+        for (const DebugText& text : r.text()) {
+            if (text.layer() < 0 || layerVisible(text.layer())) {
+                tempPen.setColor(text.color());
+                p.setPen(tempPen);
+                drawText(p, textPos, QString::fromStdString(text.text()), false);
+                textPos -= rtY * 0.1;
+            }
+        }
+    }
+
+    // Current ball position and velocity
+    if (frame->has_ball()) {
+        QPointF pos = qpointf(frame->ball().pos());
+        QPointF vel = qpointf(frame->ball().vel());
+
+        p.setPen(ballPen);
+        p.setBrush(ballColor);
+        p.drawEllipse(
+            QRectF(-kBallRadius + pos.x(), -kBallRadius + pos.y(), kBallDiameter, kBallDiameter));
+
+        if (!vel.isNull()) {
+            p.drawLine(pos, QPointF(pos.x() + vel.x(), pos.y() + vel.y()));
+        }
+    }
+}
+
+void FieldView::drawCachedField(QPainter& p, const LogFrame* frame) {
+    // The goal colors are all that depends on the frame.
+    const size_t contents = frame->blue_team() ^ frame->defend_plus_x() ? 1 : 0;
+    if (!cacheValid(_fieldCache, p, contents) ||
+        !(_fieldCacheDimensions == FieldDimensions::current_dimensions)) {
+        _fieldCacheDimensions = FieldDimensions::current_dimensions;
+        QPainter cache;
+        beginCache(cache, _fieldCache, p, contents);
+        drawField(cache, frame);
+    }
+    drawCache(p, _fieldCache);
+}
+
+void FieldView::drawDebugLayers(QPainter& p, const LogFrame* frame) {
+    // Everything on each visible layer, serialized, to tell whether the layer
+    // changed since it was last drawn. A layer with thousands of lines (like
+    // an RRT) is much cheaper to serialize than to draw.
+    std::map<int, std::string> contents;
+    auto add = [&](char kind, int layer, const google::protobuf::MessageLite& item) {
+        if (layer < 0 || layerVisible(layer)) {
+            std::string& layer_contents = contents[std::max(layer, -1)];
+            layer_contents.push_back(kind);
+            item.AppendToString(&layer_contents);
+        }
+    };
+    for (const DebugPath& path : frame->debug_paths()) {
+        add('l', path.layer(), path);
+    }
+    for (const DebugRobotPath& path : frame->debug_robot_paths()) {
+        add('r', path.layer(), path);
+    }
+    for (const DebugCircle& c : frame->debug_circles()) {
+        add('c', c.layer(), c);
+    }
+    for (const DebugArc& a : frame->debug_arcs()) {
+        add('a', a.layer(), a);
+    }
+    for (const DebugPath& polygon : frame->debug_polygons()) {
+        add('p', polygon.layer(), polygon);
+    }
+    for (const DebugText& text : frame->debug_texts()) {
+        add('t', text.layer(), text);
+    }
+
+    // Forget layers that are hidden or empty now
+    for (auto it = _layerStates.begin(); it != _layerStates.end();) {
+        it = contents.count(it->first) != 0 ? std::next(it) : _layerStates.erase(it);
+    }
+
+    // Caching a layer costs a widget-sized image, and redrawing that image
+    // every time the layer changes costs more than drawing the layer directly,
+    // so only layers that have stopped changing are cached.
+    std::vector<int> steadyLayers;
+    std::vector<int> changingLayers;
+    size_t steadyContents = 0;
+    for (const auto& [layer, layer_contents] : contents) {
+        const size_t hash = std::hash<std::string>{}(layer_contents);
+        LayerState& state = _layerStates[layer];
+        state.steadyPaints =
+            state.contents == hash ? std::min(state.steadyPaints + 1, kSteadyPaints) : 0;
+        state.contents = hash;
+
+        if (state.steadyPaints == kSteadyPaints) {
+            steadyLayers.push_back(layer);
+            steadyContents ^= hash + 0x9e3779b9 + (steadyContents << 6) + (steadyContents >> 2);
+        } else {
+            changingLayers.push_back(layer);
+        }
+    }
+
+    // Steady layers end up under changing ones, whatever their layer numbers.
+    if (steadyLayers.empty()) {
+        _steadyLayersCache = CachedImage{};
+    } else {
+        if (!cacheValid(_steadyLayersCache, p, steadyContents)) {
+            QPainter cache;
+            beginCache(cache, _steadyLayersCache, p, steadyContents);
+            for (int layer : steadyLayers) {
+                drawDebugLayer(cache, frame, layer);
+            }
+        }
+        drawCache(p, _steadyLayersCache);
+    }
+
+    p.save();
+    for (int layer : changingLayers) {
+        drawDebugLayer(p, frame, layer);
+    }
+    p.restore();
+}
+
+void FieldView::drawDebugLayer(QPainter& p, const LogFrame* frame, int layer) {
+    p.setBrush(Qt::NoBrush);
 
     // Debug lines
     for (const DebugPath& path : frame->debug_paths()) {
-        if (path.layer() < 0 || layerVisible(path.layer())) {
+        if (std::max(path.layer(), -1) == layer) {
             tempPen.setColor(qcolor(path.color()));
             p.setPen(tempPen);
             std::vector<QPointF> pts;
@@ -299,7 +465,7 @@ void FieldView::drawTeamSpace(QPainter& p) {
     }
 
     for (const DebugRobotPath& path : frame->debug_robot_paths()) {
-        if (path.layer() < 0 || layerVisible(path.layer())) {
+        if (std::max(path.layer(), -1) == layer) {
             for (int i = 0; i < path.points_size() - 1; ++i) {
                 const DebugRobotPath::DebugRobotPathPoint& from = path.points(i);
                 const DebugRobotPath::DebugRobotPathPoint& to = path.points(i + 1);
@@ -325,7 +491,7 @@ void FieldView::drawTeamSpace(QPainter& p) {
 
     // Debug circles
     for (const DebugCircle& c : frame->debug_circles()) {
-        if (c.layer() < 0 || layerVisible(c.layer())) {
+        if (std::max(c.layer(), -1) == layer) {
             QColor fill_color(c.color());
             fill_color.setAlpha(0);
             p.setBrush(fill_color);
@@ -340,7 +506,7 @@ void FieldView::drawTeamSpace(QPainter& p) {
 
     // Debug arcs
     for (const DebugArc& a : frame->debug_arcs()) {
-        if (a.layer() < 0 || layerVisible(a.layer())) {
+        if (std::max(a.layer(), -1) == layer) {
             tempPen.setColor(a.color());
             p.setPen(tempPen);
 
@@ -365,7 +531,7 @@ void FieldView::drawTeamSpace(QPainter& p) {
     // Debug polygons
     p.setPen(Qt::NoPen);
     for (const DebugPath& polygon : frame->debug_polygons()) {
-        if (polygon.layer() < 0 || layerVisible(polygon.layer())) {
+        if (std::max(polygon.layer(), -1) == layer) {
             if (polygon.points_size() < 3) {
                 fprintf(stderr, "Ignoring DebugPolygon with %d points\n", polygon.points_size());
                 continue;
@@ -389,131 +555,109 @@ void FieldView::drawTeamSpace(QPainter& p) {
 
     // Debug text
     for (const DebugText& text : frame->debug_texts()) {
-        if (text.layer() < 0 || layerVisible(text.layer())) {
+        if (std::max(text.layer(), -1) == layer) {
             tempPen.setColor(text.color());
             p.setPen(tempPen);
             drawText(p, qpointf(text.pos()), QString::fromStdString(text.text()), text.center());
         }
     }
+}
 
-    // maps robots to their comet trails, so we can draw a path of where each
-    // robot has been over the past X frames the pair used as a key is of the
-    // form (team, robot_id).  Our team team = 1, opponent team = 2. we only
-    // draw trails for robots that exist in the current frame
-    map<pair<int, int>, QPainterPath> cometTrails;
+void FieldView::beginCache(QPainter& cache, CachedImage& image, const QPainter& p,
+                           size_t contents) {
+    const qreal ratio = devicePixelRatioF();
+    const QSize pixels = size() * ratio;
+    if (image.pixmap.size() != pixels) {
+        image.pixmap = QPixmap(pixels);
+        image.pixmap.setDevicePixelRatio(ratio);
+    }
+    image.pixmap.fill(Qt::transparent);
+    image.transform = p.worldTransform();
+    image.contents = contents;
+
+    cache.begin(&image.pixmap);
+    cache.setRenderHints(p.renderHints());
+    cache.setFont(p.font());
+    cache.setWorldTransform(image.transform);
+}
 
-    /// populate @cometTrails with the past locations of each robot
-    int pastLocationCount = 40;  // number of past locations to show
-    int start = std::max(0, static_cast<int>(_history->size()) - pastLocationCount);
-    for (size_t i = start; i < _history->size(); i++) {
-        const LogFrame* oldFrame = _history->at(i).get();
-        if (oldFrame != nullptr) {
-            for (const LogFrame::Robot& r : oldFrame->self()) {
-                pair<int, int> key(1, r.shell());
-                if (cometTrails.find(key) != cometTrails.end() || i == start) {
-                    QPointF pt = qpointf(r.pos());
-                    if (i == start) {
-                        cometTrails[key].moveTo(pt);
-                    } else {
-                        cometTrails[key].lineTo(pt);
-                    }
-                }
-            }
+bool FieldView::cacheValid(const CachedImage& image, const QPainter& p, size_t contents) const {
+    return !image.pixmap.isNull() && image.pixmap.size() == size() * devicePixelRatioF() &&
+           image.transform == p.worldTransform() && image.contents == contents;
+}
 
-            for (const LogFrame::Robot& r : oldFrame->opp()) {
-                pair<int, int> key(2, r.shell());
-                if (cometTrails.find(key) != cometTrails.end() || i == start) {
-                    QPointF pt = qpointf(r.pos());
-                    if (i == start) {
-                        cometTrails[key].moveTo(pt);
-                    } else {
-                        cometTrails[key].lineTo(pt);
-                    }
-                }
-            }
-        }
-    }
+void FieldView::drawCache(QPainter& p, const CachedImage& image) {
+    p.save();
+    p.resetTransform();
+    p.drawPixmap(0, 0, image.pixmap);
+    p.restore();
+}
 
-    // draw robot comet trails
-    const float cometTrailPenSize = 0.07;
-    for (auto& kv : cometTrails) {
-        // note: kv.first.first is 1 for our team and 2 for their team
-        bool ourTeam = kv.first.first == 1;
-        bool blue = frame->blue_team();
-        const QColor color = (ourTeam ^ blue) != 0 ? Qt::yellow : Qt::blue;
-        QPen pen(color, cometTrailPenSize);
-        pen.setCapStyle(Qt::RoundCap);
-        p.setPen(pen);
-        p.drawPath(kv.second);
-    }
+void FieldView::updateTrails() {
+    const int ballTrailLength = 60;
+    const int pastLocationCount = 40;  // number of past locations to show
 
-    // Text positioning vectors
-    QPointF rtX = qpointf(rj_geometry::Point(0, 1).rotated(-_rotate * 90));
-    QPointF rtY = qpointf(rj_geometry::Point(-1, 0).rotated(-_rotate * 90));
+    const auto& history = *_history;
+    auto timestamp = [&](size_t i) {
+        return history[i] != nullptr ? static_cast<int64_t>(history[i]->timestamp()) : -1;
+    };
 
-    // Opponent robots
-    for (const LogFrame::Robot& r : frame->opp()) {
-        drawRobot(p, !frame->blue_team(), r.shell(), qpointf(r.pos()), r.angle(),
-                  r.ball_sense_status() == HasBall);
+    // Start over when going back through a log
+    if (history.empty() || timestamp(history.size() - 1) < _trailsEnd) {
+        _trailsEnd = -1;
+        _ballTrail = Trail{};
+        _robotTrails.clear();
+    }
+    if (history.empty()) {
+        return;
     }
 
-    // Our robots
-    int manualID = frame->manual_id();
-    for (const LogFrame::Robot& r : frame->self()) {
-        QPointF center = qpointf(r.pos());
+    auto add = [](Trail& trail, int64_t t, QPointF pos) {
+        trail.timestamps.push_back(t);
+        trail.points.append(pos);
+    };
 
-        bool faulty = false;
-        if (r.has_ball_sense_status() &&
-            (r.ball_sense_status() == Dazzled || r.ball_sense_status() == Failed)) {
-            faulty = true;
-        }
-        if (r.has_kicker_works() && !r.kicker_works()) {
-            // 			faulty = true;
-        }
-        for (int i = 0; i < r.motor_status().size(); ++i) {
-            if (r.motor_status(i) != Good) {
-                faulty = true;
-            }
-        }
-        if (r.has_battery_voltage() && r.battery_voltage() <= 14.3f) {
-            faulty = true;
+    // Only look at frames newer than the ones already in the trails
+    size_t first_new = history.size();
+    while (first_new > 0 && timestamp(first_new - 1) > _trailsEnd) {
+        first_new--;
+    }
+    for (size_t i = first_new; i < history.size(); i++) {
+        const LogFrame* oldFrame = history[i].get();
+        if (oldFrame == nullptr) {
+            continue;
         }
+        const auto t = static_cast<int64_t>(oldFrame->timestamp());
+        _trailsEnd = t;
 
-        drawRobot(p, frame->blue_team(), r.shell(), center, r.angle(),
-                  r.ball_sense_status() == HasBall, faulty);
-
-        // Highlight the manually controlled robot
-        if (manualID == r.shell()) {
-            p.setPen(greenPen);
-            const float r = kRobotRadius + .05;
-            p.drawEllipse(center, r, r);
+        if (i + ballTrailLength >= history.size() && oldFrame->has_ball()) {
+            add(_ballTrail, t, qpointf(oldFrame->ball().pos()));
         }
 
-        // Robot text
-        QPointF textPos = center - rtX * 0.2 - rtY * (kRobotRadius + 0.1);
-        for (const DebugText& text : r.text()) {
-            if (text.layer() < 0 || layerVisible(text.layer())) {
-                tempPen.setColor(text.color());
-                p.setPen(tempPen);
-                drawText(p, textPos, QString::fromStdString(text.text()), false);
-                textPos -= rtY * 0.1;
+        if (i + pastLocationCount >= history.size()) {
+            for (const LogFrame::Robot& r : oldFrame->self()) {
+                add(_robotTrails[{1, r.shell()}], t, qpointf(r.pos()));
+            }
+            for (const LogFrame::Robot& r : oldFrame->opp()) {
+                add(_robotTrails[{2, r.shell()}], t, qpointf(r.pos()));
             }
         }
     }
 
-    // Current ball position and velocity
-    if (frame->has_ball()) {
-        QPointF pos = qpointf(frame->ball().pos());
-        QPointF vel = qpointf(frame->ball().vel());
-
-        p.setPen(ballPen);
-        p.setBrush(ballColor);
-        p.drawEllipse(
-            QRectF(-kBallRadius + pos.x(), -kBallRadius + pos.y(), kBallDiameter, kBallDiameter));
-
-        if (!vel.isNull()) {
-            p.drawLine(pos, QPointF(pos.x() + vel.x(), pos.y() + vel.y()));
+    // Drop points from frames that are now too old
+    auto trim = [&](Trail& trail, int length) {
+        const int64_t oldest = timestamp(history.size() - std::min<size_t>(length, history.size()));
+        int stale = 0;
+        while (stale < trail.points.size() && trail.timestamps[stale] < oldest) {
+            stale++;
         }
+        trail.timestamps.erase(trail.timestamps.begin(), trail.timestamps.begin() + stale);
+        trail.points.remove(0, stale);
+    };
+    trim(_ballTrail, ballTrailLength);
+    for (auto it = _robotTrails.begin(); it != _robotTrails.end();) {
+        trim(it->second, pastLocationCount);
+        it = it->second.points.isEmpty() ? _robotTrails.erase(it) : std::next(it);
     }
 }
 
@@ -3,12 +3,19 @@
 
 #include <rj_protos/LogFrame.pb.h>
 
+#include <rj_common/field_dimensions.hpp>
 #include <rj_geometry/point.hpp>
 #include <rj_geometry/transform_matrix.hpp>
 #include <QGLWidget>
 #include <QLabel>
+#include <QPixmap>
+#include <QPolygonF>
+#include <QTransform>
+#include <map>
 #include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 class Logger;
 
@@ -67,6 +74,9 @@ protected:
     void drawText(QPainter& p, QPointF pos, const QString& text,
                   bool center = true) const;
     static void drawField(QPainter& p, const Packet::LogFrame* frame);
+    void drawCachedField(QPainter& p, const Packet::LogFrame* frame);
+    void drawDebugLayers(QPainter& p, const Packet::LogFrame* frame);
+    void drawDebugLayer(QPainter& p, const Packet::LogFrame* frame, int layer);
     void drawRobot(QPainter& p, bool blueRobot, int ID, QPointF pos,
                    float theta, bool hasBall = false, bool faulty = false);
     void drawCoords(QPainter& p);
@@ -104,4 +114,58 @@ protected:
     const std::vector<std::shared_ptr<Packet::LogFrame> >* _history{};
 
     QVector<bool> _layerVisible;
+
+private:
+    // Something drawn once into a pixmap the size of the widget, and drawn
+    // from there until whatever it was drawn from changes.
+    struct CachedImage {
+        QPixmap pixmap;
+        QTransform transform;
+        size_t contents = 0;
+    };
+
+    // Positions of one object over the last few frames of history
+    struct Trail {
+        std::vector<int64_t> timestamps;
+        QPolygonF points;
+    };
+
+    // Sets up a painter to draw into image with the same transform as p, and
+    // remembers that transform and contents.
+    void beginCache(QPainter& cache, CachedImage& image, const QPainter& p, size_t contents);
+
+    // Whether image was drawn with p's transform, from the given contents
+    bool cacheValid(const CachedImage& image, const QPainter& p, size_t contents) const;
+
+    static void drawCache(QPainter& p, const CachedImage& image);
+
+    // Brings the trails up to date with _history, only looking at frames
+    // that weren't there last time.
+    void updateTrails();
+
+    // Field lines and goals
+    CachedImage _fieldCache;
+    FieldDimensions _fieldCacheDimensions;
+
+    // What each visible debug layer held at the last paint, and for how many
+    // paints in a row it has held it. By layer; drawing with a negative layer,
+    // which is always visible, is kept under -1.
+    struct LayerState {
+        size_t contents = 0;
+        int steadyPaints = 0;
+    };
+    std::map<int, LayerState> _layerStates;
+
+    // A layer is cached once it has been the same for this many paints.
+    static constexpr int kSteadyPaints = 3;
+
+    // Every steady debug layer, in one image. Layers that are still changing
+    // are drawn straight to the widget instead.
+    CachedImage _steadyLayersCache;
+
+    // Timestamp of the newest frame in the trails
+    int64_t _trailsEnd = -1;
+    Trail _ballTrail;
+    // (team, shell), with 1 for our team and 2 for the opponents
+    std::map<std::pair<int, int>, Trail> _robotTrails;
 };
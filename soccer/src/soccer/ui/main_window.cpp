@@ -26,6 +26,7 @@
 #include "radio/radio.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "robot_status_widget.hpp"
+#include "strip_chart.hpp"
 #include "std_msgs/msg/string.hpp"
 
 #include "rc-fshare/git_version.hpp"
@@ -37,7 +38,10 @@ using namespace Packet;
 using namespace Eigen;
 
 constexpr int kHistorySize = 60 * 2;
-constexpr int kLongHistorySize = 60 * 60 * 30;
+// Enough to fill a strip chart. Older frames are decoded on demand, so don't
+// hold on to more than the views look at; chart exports read the whole
+// history from the Logger instead.
+constexpr int kLongHistorySize = 60 * 30;
 
 static const std::vector<QString> defaultHiddenLayers{
     "MotionControl", "Global Obstacles", "Local Obstacles", "Planning0", "Planning1",
@@ -66,6 +70,16 @@ MainWindow::MainWindow(Processor* processor, bool has_external_ref, QWidget* par
     _ui.logTree->history(&_longHistory);
     _ui.logTree->mainWindow = this;
     _ui.logTree->updateTimer = &updateTimer;
+    _ui.logTree->exportFrames = [this]() {
+        // Copying the history is cheap (packed frames are shared), and lets
+        // the export decode frames without holding up the Processor.
+        std::lock_guard<std::mutex> lock(*context__mutex);
+        if (std::shared_ptr<LogFile> file = context_->logs.file) {
+            return Chart::FrameSource{file->size(), [file](size_t i) { return file->frame(i); }};
+        }
+        auto frames = std::make_shared<LogHistory>(context_->logs.frames);
+        return Chart::FrameSource{frames->size(), [frames](size_t i) { return frames->at(i); }};
+    };
 
     // Initialize live/non-live control styles
 
@@ -248,10 +262,12 @@ void MainWindow::initialize() {
         _ui.actionDefendMinusX->setChecked(true);
     }
 
-    // If we're reading logs, we should already have some data. Update frames
-    // for all of it.
-    for (const auto& frame : context_->logs.frames) {
-        updateDebugLayers(*frame);
+    // If we're reading logs, we should already have some data. Layers are
+    // never removed, so the last frame has all of them.
+    if (context_->logs.num_frames() > 0) {
+        if (auto frame = context_->logs.frame(context_->logs.num_frames() - 1)) {
+            updateDebugLayers(*frame);
+        }
     }
 
     if (context_->logs.state == Logs::State::kReading) {
@@ -362,8 +378,13 @@ void MainWindow::updateViews() {
         _viewFPS->setText(QString("View: %1 fps").arg(framerate, 0, 'f', 1));
         _procFPS->setText(QString("Proc: %1 fps").arg(_processor->framerate(), 0, 'f', 1));
 
-        _logMemory->setText(
-            QString("Log: %1 kiB").arg(QString::number((context_->logs.size_bytes + 512) / 1024)));
+        QString log_text =
+            QString("Log: %1 kiB").arg(QString::number((context_->logs.size_bytes + 512) / 1024));
+        if (context_->logs.dropped_write_frames > 0) {
+            log_text += QString(", %1 frames dropped")
+                            .arg(QString::number(context_->logs.dropped_write_frames));
+        }
+        _logMemory->setText(log_text);
     }
 
     auto value = _ui.logHistoryLocation->value();
@@ -376,7 +397,8 @@ void MainWindow::updateViews() {
     // Grab frames
     {
         std::lock_guard<std::mutex> lock(*context__mutex);
-        if (context_->logs.frames.empty()) {
+        const size_t num_frames = context_->logs.num_frames();
+        if (num_frames == 0) {
             // No log frames, nothing else to update.
             return;
         }
@@ -386,13 +408,13 @@ void MainWindow::updateViews() {
         size_t num_dropped = context_->logs.dropped_frames;
 
         if (live()) {
-            _doubleFrameNumber = static_cast<double>(context_->logs.frames.size() + num_dropped);
+            _doubleFrameNumber = static_cast<double>(num_frames + num_dropped);
         } else {
             _doubleFrameNumber += *_playbackRate;
         }
 
         minFrame = num_dropped;
-        maxFrame = static_cast<int>(num_dropped + context_->logs.frames.size()) - 1;
+        maxFrame = static_cast<int>(num_dropped + num_frames) - 1;
 
         if (_doubleFrameNumber < minFrame) {
             _doubleFrameNumber = minFrame;
@@ -404,14 +426,20 @@ void MainWindow::updateViews() {
         _ui.logHistoryLocation->setMinimum(minFrame);
         _ui.logHistoryLocation->setMaximum(maxFrame);
 
-        live_frame = context_->logs.frames.back();
+        live_frame = context_->logs.frame(num_frames - 1);
 
         // Cast to ints so that subtraction doesn't overflow.
         int start = std::max(frameNumber() - kLongHistorySize, minFrame);
 
-        // Read the latest frames
-        _longHistory.assign(context_->logs.frames.begin() + start - num_dropped,
-                            context_->logs.frames.begin() + frameNumber() - num_dropped + 1);
+        // Read the latest frames. Build a new list and swap it in, so frames
+        // already decoded from a log file stay alive and are shared instead
+        // of being decoded again.
+        std::vector<std::shared_ptr<Packet::LogFrame>> longHistory;
+        longHistory.reserve(frameNumber() - start + 1);
+        for (int i = start; i <= frameNumber(); i++) {
+            longHistory.push_back(context_->logs.frame(i - num_dropped));
+        }
+        _longHistory.swap(longHistory);
     }
 
     // Update positions and republish overrides
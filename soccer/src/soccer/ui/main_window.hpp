@@ -229,7 +229,7 @@ private:
 
     // Longer log history, copied from Logger.
     // This is used specificially via StripChart and ProtobufTree
-    // To export a larger amount of data.
+    // to chart a larger amount of data.
     std::vector<std::shared_ptr<Packet::LogFrame>> _longHistory{};
 
     // Manual Position Controls
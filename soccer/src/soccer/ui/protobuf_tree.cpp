@@ -481,7 +481,11 @@ void ProtobufTree::contextMenuEvent(QContextMenuEvent* e) {
         }
 
         // export that chart
-        chart->exportChart();
+        if (exportFrames) {
+            chart->exportChart(exportFrames());
+        } else {
+            chart->exportChart();
+        }
 
     } else if (!chartMenuActions.empty()) {
         int i = chartMenuActions.indexOf(act);
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <memory>
 #include <QTreeWidget>
 #include <google/protobuf/message.h>
 
+#include "strip_chart.hpp"
+
 class QMainWindow;
 class QTimer;
 
@@ -41,6 +44,10 @@ public:
         _history = value;
     }
 
+    // Returns every frame in the log history, for exporting charts.
+    // If this isn't set, exports only cover history().
+    std::function<Chart::FrameSource()> exportFrames;
+
     QMainWindow* mainWindow;
     QTimer* updateTimer;
 
@@ -48,6 +48,15 @@ void StripChart::function(Chart::Function* function) {
 }
 
 void StripChart::exportChart() {
+    if (_history == nullptr) {
+        return;
+    }
+    const Chart::History* history = _history;
+    exportChart(
+        Chart::FrameSource{history->size(), [history](size_t i) { return history->at(i); }});
+}
+
+void StripChart::exportChart(const Chart::FrameSource& frames) {
     QString chartName = QFileDialog::getSaveFileName(this, tr("Save Chart"), "run/newChart.csv",
                                                      tr("Csv Files(*.csv)"));
     std::ofstream outfile(chartName.toStdString());
@@ -60,23 +69,30 @@ void StripChart::exportChart() {
     outfile << std::endl;
 
     // output data
+    bool haveStart = false;
+    int64_t startTime = 0;
+    for (size_t i = 0; i < frames.size; i++) {
+        const std::shared_ptr<LogFrame> frame = frames.frame(i);
+        if (!frame) {
+            continue;
+        }
 
-    // Get the oldest datapoint to use as the starting time
-    auto startTime = _history->at(0).get()->timestamp();
-
-    for (const auto& frame_i : *_history) {
-        if (frame_i) {
-            outfile << RJ::timestamp_to_secs(frame_i->timestamp() - startTime);
-
-            for (auto* function : _functions) {
-                float v = 0;
+        // Use the oldest datapoint as the starting time
+        if (!haveStart) {
+            startTime = static_cast<int64_t>(frame->timestamp());
+            haveStart = true;
+        }
+        outfile << RJ::timestamp_to_secs(static_cast<int64_t>(frame->timestamp()) - startTime);
 
-                if (function->value(*frame_i, &v)) {
-                    outfile << "," << v;
-                }
+        for (auto* function : _functions) {
+            // Leave missing values empty so the columns stay lined up
+            float v = 0;
+            outfile << ",";
+            if (function->value(*frame, &v)) {
+                outfile << v;
             }
-            outfile << std::endl;
         }
+        outfile << std::endl;
     }
     outfile.close();
 }
@@ -125,16 +141,21 @@ void StripChart::paintEvent(QPaintEvent* /*e*/) {
             p.setPen(Qt::red);
         }
 
+        // Only evaluates the function for frames that are new since the last paint
+        function->series.sync(*function, *_history);
+        const float* values = function->series.values();
+        const int64_t* timestamps = function->series.timestamps();
+        const int size = static_cast<int>(function->series.size());
+
         int start = 0;
-        if (chartSize < _history->size()) {
-            start = static_cast<int>(_history->size()) - chartSize;
+        if (chartSize < size) {
+            start = size - chartSize;
         }
 
         for (int i = 0; i < chartSize; ++i) {
-            float v = 0;
-            size_t hist_idx = start + i;
-            if (hist_idx < _history->size() && _history->at(hist_idx) &&
-                function->value(*_history->at(hist_idx).get(), &v)) {
+            int hist_idx = start + i;
+            float v = hist_idx < size ? values[hist_idx] : NAN;
+            if (!std::isnan(v)) {
                 if (autoRange) {
                     newMin = min(newMin, v);
                     newMax = max(newMax, v);
@@ -148,14 +169,12 @@ void StripChart::paintEvent(QPaintEvent* /*e*/) {
                     p.drawText(mappedCursorPos + QPointF(15, 0 + fontHeight * 2 * x),
                                (" V: " + std::to_string(v)).c_str());
 
-                    if (hist_idx > 0 && hist_idx < _history->size() - 1) {
-                        float v1 = 0;
-                        float v2 = 0;
-                        function->value(*_history->at(hist_idx - 1).get(), &v1);
-                        function->value(*_history->at(hist_idx + 1).get(), &v2);
+                    if (hist_idx > 0 && hist_idx < size - 1) {
+                        float v1 = values[hist_idx - 1];
+                        float v2 = values[hist_idx + 1];
 
-                        auto t1 = _history->at(hist_idx - 1)->timestamp();
-                        auto t2 = _history->at(hist_idx + 1)->timestamp();
+                        auto t1 = timestamps[hist_idx - 1];
+                        auto t2 = timestamps[hist_idx + 1];
                         auto deltaTime = RJ::timestamp_to_secs(t2 - t1);
 
                         auto derivative = (v2 - v1) / (deltaTime);
@@ -184,6 +203,75 @@ void StripChart::paintEvent(QPaintEvent* /*e*/) {
 
 ////////
 
+namespace {
+
+int64_t frame_timestamp(const Packet::LogFrame* frame) {
+    return frame != nullptr ? static_cast<int64_t>(frame->timestamp()) : 0;
+}
+
+}  // namespace
+
+void Chart::Series::sync(const Function& function, const History& history) {
+    // Frames are in timestamp order, so the new ones are the ones after our
+    // last timestamp.
+    size_t first_new = 0;
+    if (!empty()) {
+        const int64_t last = _timestamps.back();
+        first_new = history.size();
+        while (first_new > 0 && frame_timestamp(history[first_new - 1].get()) > last) {
+            first_new--;
+        }
+
+        // The window moved back or jumped, e.g. when scrubbing through a log.
+        if (first_new == 0 || frame_timestamp(history[first_new - 1].get()) != last) {
+            clear();
+            first_new = 0;
+        }
+    }
+
+    for (size_t i = first_new; i < history.size(); i++) {
+        append(function, history[i].get());
+    }
+
+    // Drop frames that have scrolled out of the window
+    if (size() > history.size()) {
+        pop_front(size() - history.size());
+    }
+
+    // If the window also grew at the front, start over.
+    if (size() != history.size() ||
+        (!empty() && timestamps()[0] != frame_timestamp(history.front().get()))) {
+        clear();
+        for (const auto& frame : history) {
+            append(function, frame.get());
+        }
+    }
+}
+
+void Chart::Series::clear() {
+    _timestamps.clear();
+    _values.clear();
+    _begin = 0;
+}
+
+void Chart::Series::append(const Function& function, const Packet::LogFrame* frame) {
+    float v = 0;
+    if (frame == nullptr || !function.value(*frame, &v)) {
+        v = NAN;
+    }
+    _timestamps.push_back(frame_timestamp(frame));
+    _values.push_back(v);
+}
+
+void Chart::Series::pop_front(size_t count) {
+    _begin += count;
+    if (_begin * 2 >= _timestamps.size()) {
+        _timestamps.erase(_timestamps.begin(), _timestamps.begin() + _begin);
+        _values.erase(_values.begin(), _values.begin() + _begin);
+        _begin = 0;
+    }
+}
+
 bool Chart::PointMagnitude::value(const Packet::LogFrame& frame, float* v) const {
     const Message* msg = &frame;
     for (int i = 0; i < path.size(); ++i) {
@@ -3,6 +3,8 @@
 #include <QWidget>
 #include <string.h>
 
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -17,6 +19,53 @@ class LogFrame;
 // Returns true if the value was available.
 // Returns false with v undefined if the value was not available.
 namespace Chart {
+struct Function;
+
+using History = std::vector<std::shared_ptr<Packet::LogFrame> >;
+
+// A function's values over a window of consecutive frames, stored as plain
+// arrays so that charts don't go through protobuf reflection for every frame
+// on every repaint.
+//
+// sync() only evaluates the function for frames that weren't already in the
+// window, so following a live log costs one evaluation per new frame.
+// Values that weren't available are NaN.
+class Series {
+public:
+    // Brings the series in line with history, so that index i here is frame i
+    // in history. Frames must be in timestamp order.
+    void sync(const Function& function, const History& history);
+
+    void clear();
+
+    size_t size() const { return _timestamps.size() - _begin; }
+
+    bool empty() const { return size() == 0; }
+
+    // Contiguous arrays of size() timestamps and values
+    const int64_t* timestamps() const { return _timestamps.data() + _begin; }
+    const float* values() const { return _values.data() + _begin; }
+
+private:
+    void append(const Function& function, const Packet::LogFrame* frame);
+    void pop_front(size_t count);
+
+    // Frames before _begin have scrolled out of the window. They're removed
+    // in bulk once they take up half the arrays, so that the window always
+    // stays contiguous.
+    std::vector<int64_t> _timestamps;
+    std::vector<float> _values;
+    size_t _begin = 0;
+};
+
+// Frames to export, oldest first: how many there are, and how to get each
+// one. Frames are asked for one at a time, so a long log doesn't need to be
+// decoded all at once.
+struct FrameSource {
+    size_t size = 0;
+    std::function<std::shared_ptr<Packet::LogFrame>(size_t)> frame;
+};
+
 struct Function {
     virtual ~Function() = default;
     virtual bool value(const Packet::LogFrame& frame, float* v) const = 0;
@@ -27,6 +76,10 @@ struct Function {
     // A repeated field's tag is followed by the index of the item.
     QVector<int> path;
     QString name;
+
+    // Values already extracted from the history. This lives with the function
+    // so that every chart showing it (and exports) can share it.
+    Series series;
 };
 
 struct PointMagnitude : public Function {
@@ -43,9 +96,7 @@ public:
     StripChart(QWidget* parent = nullptr);
     ~StripChart() override = default;
 
-    void history(const std::vector<std::shared_ptr<Packet::LogFrame> >* value) {
-        _history = value;
-    }
+    void history(const Chart::History* value) { _history = value; }
 
     // Sets the chart function.
     // This chart owns the function and will destroy it when needed.
@@ -56,6 +107,9 @@ public:
     // Exports the contents of the chart to a .csv file
     void exportChart();
 
+    // Exports the chart's functions over the given frames to a .csv file
+    void exportChart(const Chart::FrameSource& frames);
+
     void minValue(float v) { _minValue = v; }
 
     void maxValue(float v) { _maxValue = v; }
@@ -89,7 +143,7 @@ protected:
     float _maxValue;
     QColor _color;
 
-    const std::vector<std::shared_ptr<Packet::LogFrame> >* _history;
+    const Chart::History* _history;
 
     QPointF _mouse_overlay;
 };
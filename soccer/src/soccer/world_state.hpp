@@ -178,6 +178,12 @@ struct WorldState {
      */
     RJ::Time last_updated_time;
 
+    /**
+     * @brief Latency trace of the newest vision frame in this state, passed
+     * along to anything computed from it.
+     */
+    rj_msgs::msg::FrameTrace trace;
+
     std::vector<RobotState> their_robots;
     std::vector<RobotState> our_robots;
     BallState ball;
@@ -239,6 +245,7 @@ struct RosConverter<WorldState, WorldState::Msg> {
         convert_to_ros(value.our_robots, &result.our_robots);
         convert_to_ros(value.their_robots, &result.their_robots);
         convert_to_ros(value.last_updated_time, &result.last_update_time);
+        result.trace = value.trace;
         return result;
     }
 
@@ -248,6 +255,7 @@ struct RosConverter<WorldState, WorldState::Msg> {
         convert_from_ros(value.our_robots, &result.our_robots);
         convert_from_ros(value.their_robots, &result.their_robots);
         convert_from_ros(value.last_update_time, &result.last_updated_time);
+        result.trace = value.trace;
         return result;
     }
 };
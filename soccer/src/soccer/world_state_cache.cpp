@@ -0,0 +1,47 @@
+#include "world_state_cache.hpp"
+
+namespace {
+
+bool is_unset(const builtin_interfaces::msg::Time& stamp) {
+    return stamp.sec == 0 && stamp.nanosec == 0;
+}
+
+int64_t to_ns(const builtin_interfaces::msg::Time& stamp) {
+    return static_cast<int64_t>(stamp.sec) * 1'000'000'000 + stamp.nanosec;
+}
+
+}  // namespace
+
+WorldStateCache& WorldStateCache::global() {
+    static WorldStateCache cache;
+    return cache;
+}
+
+std::shared_ptr<const WorldState> WorldStateCache::get(const WorldState::Msg& msg) {
+    const builtin_interfaces::msg::Time& stamp = msg.trace.t_filtered;
+
+    std::unique_lock lock{mutex_};
+    if (latest_ != nullptr && stamp == latest_stamp_ && !is_unset(stamp)) {
+        return latest_;
+    }
+
+    num_decoded_++;
+    // Slightly out of order: someone fell behind, so don't evict the latest.
+    // Any further back and the clock was reset, so start over from here.
+    const int64_t behind_ns = to_ns(latest_stamp_) - to_ns(stamp);
+    if (is_unset(stamp) || (behind_ns > 0 && behind_ns <= kMaxReorderNs)) {
+        lock.unlock();
+        return std::make_shared<const WorldState>(rj_convert::convert_from_ros(msg));
+    }
+
+    // Convert while holding the lock, so that everyone else who got this
+    // message waits for the result instead of converting it too
+    latest_ = std::make_shared<const WorldState>(rj_convert::convert_from_ros(msg));
+    latest_stamp_ = stamp;
+    return latest_;
+}
+
+size_t WorldStateCache::num_decoded() const {
+    std::lock_guard lock{mutex_};
+    return num_decoded_;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <builtin_interfaces/msg/time.hpp>
+
+#include "world_state.hpp"
+
+/**
+ * @brief One robot's state inside a shared, decoded WorldState.
+ *
+ * @details Holds on to the whole WorldState, so the robot (and the rest of the
+ * world it was decoded with) stays valid for as long as the view is kept.
+ */
+class RobotStateView {
+public:
+    RobotStateView(std::shared_ptr<const WorldState> world, bool ours, int shell)
+        : world_{std::move(world)},
+          robot_{&(ours ? world_->our_robots : world_->their_robots).at(shell)} {}
+
+    [[nodiscard]] const RobotState& state() const { return *robot_; }
+    [[nodiscard]] const WorldState& world() const { return *world_; }
+
+    const RobotState& operator*() const { return *robot_; }
+    const RobotState* operator->() const { return robot_; }
+
+private:
+    std::shared_ptr<const WorldState> world_;
+    const RobotState* robot_;
+};
+
+/**
+ * @brief Decodes each published WorldState message once per process.
+ *
+ * @details Every node that listens to the world state (the planner, all of
+ * the motion controllers, the agents, the processor) used to convert the
+ * whole message on its own. Instead they ask this cache, which converts the
+ * first copy of each message it sees and hands the same immutable result to
+ * everyone else.
+ *
+ * Messages are told apart by trace.t_filtered, which the vision filter stamps
+ * on every world state it publishes. Messages without that stamp (tests,
+ * replayed logs) are converted every time.
+ *
+ * Thread-safe. Only the latest message is kept, so a subscriber that falls
+ * behind converts its stale message itself instead of evicting the latest.
+ * A message more than kMaxReorderNs older than the latest means the clock went
+ * back (a restarted simulator, a looping bag), so it becomes the latest.
+ */
+class WorldStateCache {
+public:
+    /**
+     * How far out of order a message may be and still count as stale
+     */
+    static constexpr int64_t kMaxReorderNs = 1'000'000'000;
+
+    /**
+     * @return The cache shared by every node in this process
+     */
+    static WorldStateCache& global();
+
+    /**
+     * @return The decoded contents of @msg. Don't cast away the const: the
+     * same object is given to every caller with the same message.
+     */
+    [[nodiscard]] std::shared_ptr<const WorldState> get(const WorldState::Msg& msg);
+
+    /**
+     * @return A view of one of our robots in the decoded contents of @msg
+     */
+    [[nodiscard]] RobotStateView our_robot(const WorldState::Msg& msg, int shell) {
+        return RobotStateView{get(msg), true, shell};
+    }
+
+    /**
+     * @return How many messages were converted rather than shared
+     */
+    [[nodiscard]] size_t num_decoded() const;
+
+private:
+    mutable std::mutex mutex_;
+    builtin_interfaces::msg::Time latest_stamp_;
+    std::shared_ptr<const WorldState> latest_;
+    size_t num_decoded_ = 0;
+};
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "world_state_cache.hpp"
+
+namespace {
+
+WorldState::Msg make_msg(int32_t filtered_sec) {
+    WorldState world;
+    world.our_robots.at(3) =
+        RobotState{rj_geometry::Pose{1, 2, 0}, rj_geometry::Twist::zero(), RJ::now(), true};
+    WorldState::Msg msg = rj_convert::convert_to_ros(world);
+    msg.trace.t_filtered.sec = filtered_sec;
+    return msg;
+}
+
+}  // namespace
+
+TEST(WorldStateCache, shares_one_decode_per_message) {
+    WorldStateCache cache;
+    const WorldState::Msg msg = make_msg(10);
+
+    auto first = cache.get(msg);
+    auto second = cache.get(msg);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.num_decoded(), 1u);
+
+    RobotStateView robot = cache.our_robot(msg, 3);
+    EXPECT_EQ(&robot.world(), first.get());
+    EXPECT_TRUE(robot->visible);
+    EXPECT_EQ(robot->pose.position().x(), 1);
+
+    auto next = cache.get(make_msg(11));
+    EXPECT_NE(next, first);
+    EXPECT_EQ(cache.num_decoded(), 2u);
+
+    // The older decode stays alive for as long as someone holds it
+    EXPECT_TRUE(robot->visible);
+}
+
+TEST(WorldStateCache, stale_and_unstamped_messages_are_not_cached) {
+    WorldStateCache cache;
+    auto latest = cache.get(make_msg(10));
+
+    auto stale = cache.get(make_msg(9));
+    EXPECT_NE(stale, latest);
+    EXPECT_EQ(cache.get(make_msg(10)), latest);
+
+    const WorldState::Msg unstamped = make_msg(0);
+    EXPECT_NE(cache.get(unstamped), cache.get(unstamped));
+    EXPECT_EQ(cache.num_decoded(), 4u);
+}
+
+TEST(WorldStateCache, starts_over_when_the_clock_goes_back) {
+    WorldStateCache cache;
+    cache.get(make_msg(1000));
+
+    // Far older than the latest: the clock was reset, so this is cached
+    auto restarted = cache.get(make_msg(10));
+    EXPECT_EQ(cache.get(make_msg(10)), restarted);
+    EXPECT_EQ(cache.num_decoded(), 2u);
+}
@@ -56,7 +56,7 @@ TEST(BallBounce, no_intersection) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -86,7 +86,7 @@ TEST(BallBounce, wrong_direction) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -116,7 +116,7 @@ TEST(BallBounce, too_far) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -146,7 +146,7 @@ TEST(BallBounce, flat_intersect_side) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -179,7 +179,7 @@ TEST(BallBounce, flat_intersect_mouth) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -212,7 +212,7 @@ TEST(BallBounce, angle_intersect_side) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -246,7 +246,7 @@ TEST(BallBounce, angle_intersect_mouth) {
     WorldRobot wr1;
     KalmanRobot kr = KalmanRobot(1, tc, cr, wr1);
 
-    std::list<KalmanRobot> krl;
+    std::vector<KalmanRobot> krl;
     krl.push_back(kr);
 
     WorldRobot wr2 = WorldRobot(tc, WorldRobot::Team::BLUE, 1, krl);
@@ -53,7 +53,7 @@ TEST(CameraRobot, get_robot_id) {
 }
 
 TEST(CameraRobot, combine_zero) {
-    std::list<CameraRobot> robots;
+    std::vector<CameraRobot> robots;
 
     CameraRobot r = CameraRobot::combine_robots(robots);
 
@@ -68,7 +68,7 @@ TEST(CameraRobot, combine_one) {
     rj_geometry::Pose pose(rj_geometry::Point(1, 1), 1);
     int id = 0;
 
-    std::list<CameraRobot> robots;
+    std::vector<CameraRobot> robots;
     robots.emplace_back(t, pose, id);
 
     CameraRobot r = CameraRobot::combine_robots(robots);
@@ -87,7 +87,7 @@ TEST(CameraRobot, combine_two) {
     rj_geometry::Pose pose2(rj_geometry::Point(2, 2), 1.5);
     int id = 0;
 
-    std::list<CameraRobot> robots;
+    std::vector<CameraRobot> robots;
     robots.emplace_back(t1, pose1, id);
     robots.emplace_back(t2, pose2, id);
 
@@ -13,9 +13,9 @@ TEST(Camera, invalid_camera) {
 TEST(Camera, valid_camera) {
     Camera c = Camera(1);
 
-    std::list<KalmanBall> kb = c.get_kalman_balls();
-    std::vector<std::list<KalmanRobot>> kry = c.get_kalman_robots_yellow();
-    std::vector<std::list<KalmanRobot>> krb = c.get_kalman_robots_blue();
+    std::vector<KalmanBall> kb = c.get_kalman_balls();
+    std::vector<std::vector<KalmanRobot>> kry = c.get_kalman_robots_yellow();
+    std::vector<std::vector<KalmanRobot>> krb = c.get_kalman_robots_blue();
 
     EXPECT_TRUE(c.get_is_valid());
     EXPECT_EQ(kb.size(), 0);
@@ -29,9 +29,9 @@ TEST(Camera, update_no_frame_empty) {
     Camera c = Camera(1);
     c.update_without_frame(RJ::now());
 
-    std::list<KalmanBall> kb = c.get_kalman_balls();
-    std::vector<std::list<KalmanRobot>> kry = c.get_kalman_robots_yellow();
-    std::vector<std::list<KalmanRobot>> krb = c.get_kalman_robots_blue();
+    std::vector<KalmanBall> kb = c.get_kalman_balls();
+    std::vector<std::vector<KalmanRobot>> kry = c.get_kalman_robots_yellow();
+    std::vector<std::vector<KalmanRobot>> krb = c.get_kalman_robots_blue();
 
     EXPECT_TRUE(c.get_is_valid());
     EXPECT_EQ(kb.size(), 0);
@@ -46,17 +46,17 @@ TEST(Camera, update_with_frame_empty) {
     RJ::Time t = RJ::now();
 
     std::vector<CameraBall> b;
-    std::vector<std::list<CameraRobot>> yr(kNumShells);
-    std::vector<std::list<CameraRobot>> br(kNumShells);
+    std::vector<std::vector<CameraRobot>> yr(kNumShells);
+    std::vector<std::vector<CameraRobot>> br(kNumShells);
     WorldBall wb;
     std::vector<WorldRobot> wry(kNumShells, WorldRobot());
     std::vector<WorldRobot> wrb(kNumShells, WorldRobot());
 
     c.update_with_frame(t, b, yr, br, wb, wry, wrb);
 
-    std::list<KalmanBall> kb = c.get_kalman_balls();
-    std::vector<std::list<KalmanRobot>> kry = c.get_kalman_robots_yellow();
-    std::vector<std::list<KalmanRobot>> krb = c.get_kalman_robots_blue();
+    std::vector<KalmanBall> kb = c.get_kalman_balls();
+    std::vector<std::vector<KalmanRobot>> kry = c.get_kalman_robots_yellow();
+    std::vector<std::vector<KalmanRobot>> krb = c.get_kalman_robots_blue();
 
     EXPECT_TRUE(c.get_is_valid());
     EXPECT_EQ(kb.size(), 0);
@@ -71,8 +71,8 @@ TEST(Camera, update_with_single_frame) {
     RJ::Time t = RJ::now();
 
     std::vector<CameraBall> b;
-    std::vector<std::list<CameraRobot>> yr(kNumShells);
-    std::vector<std::list<CameraRobot>> br(kNumShells);
+    std::vector<std::vector<CameraRobot>> yr(kNumShells);
+    std::vector<std::vector<CameraRobot>> br(kNumShells);
     WorldBall wb;
     std::vector<WorldRobot> wry(kNumShells, WorldRobot());
     std::vector<WorldRobot> wrb(kNumShells, WorldRobot());
@@ -87,9 +87,9 @@ TEST(Camera, update_with_single_frame) {
 
     c.update_with_frame(t, b, yr, br, wb, wry, wrb);
 
-    std::list<KalmanBall> kb = c.get_kalman_balls();
-    std::vector<std::list<KalmanRobot>> kry = c.get_kalman_robots_yellow();
-    std::vector<std::list<KalmanRobot>> krb = c.get_kalman_robots_blue();
+    std::vector<KalmanBall> kb = c.get_kalman_balls();
+    std::vector<std::vector<KalmanRobot>> kry = c.get_kalman_robots_yellow();
+    std::vector<std::vector<KalmanRobot>> krb = c.get_kalman_robots_blue();
 
     EXPECT_TRUE(c.get_is_valid());
     EXPECT_EQ(kb.size(), 1);
@@ -104,4 +104,43 @@ TEST(Camera, update_with_single_frame) {
     EXPECT_NEAR(kry.at(0).front().get_pos().y(), 1.25, 0.01);
     EXPECT_NEAR(kry.at(0).front().get_theta(), 0.25, 0.01);
 }
+
+TEST(Camera, best_kalman_objects) {
+    Camera c = Camera(1);
+    RJ::Time t = RJ::now();
+
+    EXPECT_EQ(c.get_best_kalman_ball(), nullptr);
+    EXPECT_EQ(c.get_best_kalman_robot_yellow(0), nullptr);
+    EXPECT_EQ(c.get_best_kalman_robot_blue(0), nullptr);
+
+    std::vector<CameraBall> b;
+    std::vector<std::vector<CameraRobot>> yr(kNumShells);
+    std::vector<std::vector<CameraRobot>> br(kNumShells);
+    WorldBall wb;
+    std::vector<WorldRobot> wry(kNumShells, WorldRobot());
+    std::vector<WorldRobot> wrb(kNumShells, WorldRobot());
+
+    b.emplace_back(RJ::now(), rj_geometry::Point(0, 0));
+    yr.at(0).emplace_back(RJ::now(), rj_geometry::Pose(rj_geometry::Point(1, 1), 0), 0);
+
+    c.update_with_frame(t, b, yr, br, wb, wry, wrb);
+
+    // A second ball far away from the first gets its own, newer filter
+    b.clear();
+    b.emplace_back(RJ::now(), rj_geometry::Point(0, 0));
+    b.emplace_back(RJ::now(), rj_geometry::Point(3, 3));
+
+    c.update_with_frame(t + RJ::Seconds(0.01), b, yr, br, wb, wry, wrb);
+
+    ASSERT_EQ(c.get_kalman_balls().size(), 2);
+    ASSERT_NE(c.get_best_kalman_ball(), nullptr);
+    EXPECT_EQ(c.get_best_kalman_ball(), &c.get_kalman_balls().front());
+    EXPECT_GT(c.get_kalman_balls().front().get_health(),
+              c.get_kalman_balls().back().get_health());
+
+    ASSERT_NE(c.get_best_kalman_robot_yellow(0), nullptr);
+    EXPECT_EQ(c.get_best_kalman_robot_yellow(0), &c.get_kalman_robots_yellow().at(0).front());
+    EXPECT_EQ(c.get_best_kalman_robot_yellow(1), nullptr);
+    EXPECT_EQ(c.get_best_kalman_robot_blue(0), nullptr);
+}
 }  // namespace vision_filter
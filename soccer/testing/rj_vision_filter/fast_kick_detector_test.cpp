@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <rj_constants/constants.hpp>
+#include <rj_vision_filter/kick/detector/fast_kick_detector.hpp>
+#include <rj_vision_filter/params.hpp>
+
+namespace vision_filter {
+namespace {
+WorldBall make_ball(RJ::Time t, rj_geometry::Point pos) {
+    std::vector<KalmanBall> kbl{KalmanBall(1, t, CameraBall(t, pos), WorldBall())};
+    return WorldBall(t, kbl);
+}
+
+WorldRobot make_robot(RJ::Time t, WorldRobot::Team team, int id, rj_geometry::Pose pose) {
+    std::vector<KalmanRobot> krl{KalmanRobot(1, t, CameraRobot(t, pose, id), WorldRobot())};
+    return WorldRobot(t, team, id, krl);
+}
+}  // namespace
+
+TEST(FastKickDetector, blames_closest_robot) {
+    const auto count = static_cast<size_t>(kick::detector::PARAM_fast_kick_hist_length);
+    KickHistory history(count);
+    RJ::Time t = RJ::now();
+
+    for (size_t i = 0; i < count; i++) {
+        RJ::Time frame_time = t + RJ::Seconds(PARAM_vision_loop_dt * i);
+
+        // The kicker is right next to the ball. Another robot, far away,
+        // comes later in the search order (blue after yellow, higher ids
+        // later), which is the one that used to be blamed.
+        std::vector<WorldRobot> yellow(kNumShells, WorldRobot());
+        std::vector<WorldRobot> blue(kNumShells, WorldRobot());
+        yellow.at(1) = make_robot(frame_time, WorldRobot::Team::YELLOW, 1,
+                                  rj_geometry::Pose(rj_geometry::Point(-0.1, 0), 0));
+        blue.at(5) = make_robot(frame_time, WorldRobot::Team::BLUE, 5,
+                                rj_geometry::Pose(rj_geometry::Point(3, 3), 0));
+
+        // The ball sits still, then jumps away on the last sample
+        rj_geometry::Point ball_pos = i + 1 < count ? rj_geometry::Point(0, 0)
+                                                    : rj_geometry::Point(1, 0);
+        history.add(frame_time, make_ball(frame_time, ball_pos), yellow, blue);
+    }
+
+    KickEvent kick_event;
+    ASSERT_TRUE(FastKickDetector().detect(history, &kick_event));
+    EXPECT_EQ(kick_event.get_kicking_team(), WorldRobot::Team::YELLOW);
+    EXPECT_EQ(kick_event.get_kicking_robot_id(), 1);
+}
+}  // namespace vision_filter
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <rj_vision_filter/camera/frame_aggregator.hpp>
+
+namespace vision_filter {
+namespace {
+CameraFrame empty_frame(RJ::Time t_capture, int camera_id) {
+    return CameraFrame(t_capture, camera_id, {}, {}, {});
+}
+}  // namespace
+
+TEST(FrameAggregator, waits_for_all_cameras) {
+    FrameAggregator aggregator(RJ::Seconds(0.01), RJ::Seconds(0.1));
+    RJ::Time t = RJ::now();
+    std::vector<CameraFrame> frames;
+
+    EXPECT_FALSE(aggregator.ready(t));
+
+    // Nothing is known about the other cameras yet, so go right away
+    aggregator.add(empty_frame(t, 0), t);
+    aggregator.add(empty_frame(t, 1), t);
+    EXPECT_TRUE(aggregator.ready(t));
+    aggregator.take(&frames);
+    EXPECT_EQ(frames.size(), 2);
+    EXPECT_FALSE(aggregator.ready(t));
+
+    // Now wait for camera 1 to catch up with camera 0
+    t = t + RJ::Seconds(0.016);
+    aggregator.add(empty_frame(t, 0), t);
+    EXPECT_FALSE(aggregator.ready(t));
+    aggregator.add(empty_frame(t, 1), t + RJ::Seconds(0.002));
+    EXPECT_TRUE(aggregator.ready(t + RJ::Seconds(0.002)));
+    aggregator.take(&frames);
+    EXPECT_EQ(frames.size(), 2);
+}
+
+TEST(FrameAggregator, window_expires) {
+    FrameAggregator aggregator(RJ::Seconds(0.01), RJ::Seconds(0.1));
+    RJ::Time t = RJ::now();
+    std::vector<CameraFrame> frames;
+
+    aggregator.add(empty_frame(t, 0), t);
+    aggregator.add(empty_frame(t, 1), t);
+    aggregator.take(&frames);
+
+    // Camera 1 is late, but still live
+    t = t + RJ::Seconds(0.016);
+    aggregator.add(empty_frame(t, 0), t);
+    EXPECT_FALSE(aggregator.ready(t + RJ::Seconds(0.005)));
+    EXPECT_TRUE(aggregator.ready(t + RJ::Seconds(0.01)));
+
+    aggregator.take(&frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.front().camera_id, 0);
+
+    // Camera 1 went down, so stop waiting on it
+    t = t + RJ::Seconds(0.2);
+    aggregator.add(empty_frame(t, 0), t);
+    EXPECT_TRUE(aggregator.ready(t));
+}
+
+TEST(FrameAggregator, drops_stale_frames) {
+    FrameAggregator aggregator(RJ::Seconds(0.01), RJ::Seconds(0.1));
+    RJ::Time t = RJ::now();
+    std::vector<CameraFrame> frames;
+
+    // A newer frame from the same camera replaces the pending one
+    EXPECT_TRUE(aggregator.add(empty_frame(t, 0), t));
+    EXPECT_TRUE(aggregator.add(empty_frame(t + RJ::Seconds(0.016), 0), t));
+
+    // Duplicates and frames that arrive out of order are dropped
+    EXPECT_FALSE(aggregator.add(empty_frame(t + RJ::Seconds(0.016), 0), t));
+    EXPECT_FALSE(aggregator.add(empty_frame(t, 0), t));
+    EXPECT_EQ(aggregator.num_dropped(), 3);
+
+    aggregator.take(&frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.front().t_capture, t + RJ::Seconds(0.016));
+
+    // Even after their batch has been processed
+    EXPECT_FALSE(aggregator.add(empty_frame(t + RJ::Seconds(0.008), 0), t));
+    EXPECT_FALSE(aggregator.ready(t));
+}
+
+TEST(FrameAggregator, zero_window) {
+    FrameAggregator aggregator(RJ::Seconds(0), RJ::Seconds(0.1));
+    RJ::Time t = RJ::now();
+    std::vector<CameraFrame> frames;
+
+    aggregator.add(empty_frame(t, 0), t);
+    aggregator.add(empty_frame(t, 1), t);
+    aggregator.take(&frames);
+
+    aggregator.add(empty_frame(t + RJ::Seconds(0.016), 0), t);
+    EXPECT_TRUE(aggregator.ready(t));
+}
+}  // namespace vision_filter
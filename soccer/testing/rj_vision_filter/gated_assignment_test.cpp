@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <rj_vision_filter/filter/gated_assignment.hpp>
+
+namespace vision_filter {
+TEST(GatedAssignment, empty) {
+    GatedAssignment a;
+    a.add_track(rj_geometry::Point(0, 0), 1);
+    a.solve();
+
+    EXPECT_EQ(a.get_measurement_for_track(0), GatedAssignment::kUnassigned);
+}
+
+TEST(GatedAssignment, outside_gate) {
+    GatedAssignment a;
+    a.add_track(rj_geometry::Point(0, 0), 0.5);
+    a.add_measurement(rj_geometry::Point(0.6, 0));
+    a.solve();
+
+    EXPECT_EQ(a.get_measurement_for_track(0), GatedAssignment::kUnassigned);
+    EXPECT_FALSE(a.is_gated(0));
+}
+
+TEST(GatedAssignment, optimal_not_greedy) {
+    // Greedily giving track 0 its closest measurement (1) leaves track 1
+    // with nothing inside its gate
+    GatedAssignment a;
+    a.add_track(rj_geometry::Point(0, 0), 0.5);
+    a.add_track(rj_geometry::Point(0.6, 0), 0.5);
+    a.add_measurement(rj_geometry::Point(-0.3, 0));
+    a.add_measurement(rj_geometry::Point(0.2, 0));
+    a.solve();
+
+    EXPECT_EQ(a.get_measurement_for_track(0), 0);
+    EXPECT_EQ(a.get_measurement_for_track(1), 1);
+    EXPECT_TRUE(a.is_gated(0));
+    EXPECT_TRUE(a.is_gated(1));
+}
+
+TEST(GatedAssignment, more_measurements_than_tracks) {
+    GatedAssignment a;
+    a.add_track(rj_geometry::Point(0, 0), 0.5);
+    a.add_measurement(rj_geometry::Point(0.3, 0));
+    a.add_measurement(rj_geometry::Point(0, 0.1));
+    a.add_measurement(rj_geometry::Point(2, 0));
+    a.solve();
+
+    EXPECT_EQ(a.get_measurement_for_track(0), 1);
+    EXPECT_TRUE(a.is_gated(0));
+    EXPECT_TRUE(a.is_gated(1));
+    EXPECT_FALSE(a.is_gated(2));
+}
+
+TEST(GatedAssignment, more_tracks_than_measurements) {
+    GatedAssignment a;
+    a.add_track(rj_geometry::Point(0, 0), 0.5);
+    a.add_track(rj_geometry::Point(0, 0.2), 0.5);
+    a.add_track(rj_geometry::Point(0, 0.4), 0.5);
+    a.add_measurement(rj_geometry::Point(0, 0.45));
+    a.solve();
+
+    EXPECT_EQ(a.get_measurement_for_track(0), GatedAssignment::kUnassigned);
+    EXPECT_EQ(a.get_measurement_for_track(1), GatedAssignment::kUnassigned);
+    EXPECT_EQ(a.get_measurement_for_track(2), 0);
+}
+
+TEST(GatedAssignment, independent_clusters) {
+    GatedAssignment a;
+
+    // Two separate groups of 3 objects seen once each, listed out of order
+    for (int i = 0; i < 3; i++) {
+        a.add_track(rj_geometry::Point(i * 0.3, 0), 0.35);
+        a.add_track(rj_geometry::Point(5 + i * 0.3, 0), 0.35);
+    }
+
+    for (int i = 2; i >= 0; i--) {
+        a.add_measurement(rj_geometry::Point(5 + i * 0.3 + 0.05, 0));
+        a.add_measurement(rj_geometry::Point(i * 0.3 + 0.05, 0));
+    }
+
+    a.solve();
+
+    for (size_t track = 0; track < 6; track++) {
+        const int measurement = a.get_measurement_for_track(track);
+        ASSERT_NE(measurement, GatedAssignment::kUnassigned);
+
+        // Track 2k (2k+1) is at i = k in the near (far) group, and measurement
+        // 2j (2j+1) is at i = 2 - j in the far (near) group
+        const size_t i = track / 2;
+        const bool near = track % 2 == 0;
+        EXPECT_EQ(measurement, static_cast<int>(2 * (2 - i) + (near ? 1 : 0)));
+    }
+
+    // Reusing the instance starts from scratch
+    a.clear();
+    a.add_track(rj_geometry::Point(0, 0), 0.5);
+    a.solve();
+    EXPECT_EQ(a.get_measurement_for_track(0), GatedAssignment::kUnassigned);
+}
+}  // namespace vision_filter
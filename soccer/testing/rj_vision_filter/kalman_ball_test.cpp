@@ -34,7 +34,7 @@ TEST(KalmanBall, valid_world_ball) {
 
     KalmanBall kb = KalmanBall(c_id, t, b, w);
     kb.set_vel(p);
-    std::list<KalmanBall> kbl;
+    std::vector<KalmanBall> kbl;
     kbl.push_back(kb);
 
     WorldBall wb = WorldBall(t, kbl);
@@ -49,7 +49,7 @@ TEST(KalmanRobot, valid_world_robot) {
     KalmanRobot kb = KalmanRobot(c_id, t, b1, w);
     kb.predict_and_update(t, b2);
 
-    std::list<KalmanRobot> kbl;
+    std::vector<KalmanRobot> kbl;
     kbl.push_back(kb);
 
     WorldRobot wb = WorldRobot(t, WorldRobot::Team::BLUE, robot_id, kbl);
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <rj_constants/constants.hpp>
+#include <rj_vision_filter/kick/kick_history.hpp>
+
+namespace vision_filter {
+namespace {
+WorldBall make_ball(RJ::Time t, rj_geometry::Point pos) {
+    std::vector<KalmanBall> kbl{KalmanBall(1, t, CameraBall(t, pos), WorldBall())};
+    return WorldBall(t, kbl);
+}
+
+WorldRobot make_robot(RJ::Time t, WorldRobot::Team team, int id, rj_geometry::Pose pose) {
+    std::vector<KalmanRobot> krl{KalmanRobot(1, t, CameraRobot(t, pose, id), WorldRobot())};
+    return WorldRobot(t, team, id, krl);
+}
+}  // namespace
+
+TEST(KickHistory, keeps_latest_in_order) {
+    KickHistory history(3);
+    RJ::Time t = RJ::now();
+
+    std::vector<WorldRobot> yellow(kNumShells, WorldRobot());
+    std::vector<WorldRobot> blue(kNumShells, WorldRobot());
+
+    EXPECT_EQ(history.size(), 0u);
+    EXPECT_ANY_THROW(history.ball_track(1));
+
+    // Go around the ring more than once
+    for (size_t i = 0; i < 5; i++) {
+        RJ::Time frame_time = t + RJ::Seconds(i);
+        yellow.at(2) = make_robot(frame_time, WorldRobot::Team::YELLOW, 2,
+                                  rj_geometry::Pose(rj_geometry::Point(i, 1), 0.5));
+        history.add(frame_time, make_ball(frame_time, rj_geometry::Point(i, 0)), yellow, blue);
+
+        EXPECT_EQ(history.size(), std::min<size_t>(i + 1, 3));
+    }
+
+    EXPECT_EQ(history.capacity(), 3u);
+
+    KickHistory::BallTrack ball = history.ball_track(3);
+    KickHistory::RobotTrack robot = history.robot_track(WorldRobot::Team::YELLOW, 2, 3);
+    KickHistory::RobotTrack other = history.robot_track(WorldRobot::Team::BLUE, 2, 3);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(ball.time[i], t + RJ::Seconds(i + 2));
+        EXPECT_TRUE(ball.valid[i]);
+        EXPECT_NEAR(ball.pos[i].x(), i + 2, 0.01);
+
+        EXPECT_TRUE(robot.valid[i]);
+        EXPECT_NEAR(robot.pos[i].x(), i + 2, 0.01);
+        EXPECT_NEAR(robot.theta[i], 0.5, 0.01);
+
+        EXPECT_FALSE(other.valid[i]);
+    }
+
+    // Shorter views end at the newest sample too
+    ball = history.ball_track(1);
+    EXPECT_EQ(ball.time[0], t + RJ::Seconds(4));
+    EXPECT_ANY_THROW(history.ball_track(4));
+}
+
+TEST(KickHistory, invalid_ball) {
+    KickHistory history(2);
+    RJ::Time t = RJ::now();
+
+    std::vector<WorldRobot> robots(kNumShells, WorldRobot());
+
+    history.add(t, make_ball(t, rj_geometry::Point(0, 0)), robots, robots);
+    history.add(t + RJ::Seconds(1), WorldBall(), robots, robots);
+
+    KickHistory::BallTrack ball = history.ball_track(2);
+    EXPECT_TRUE(ball.valid[0]);
+    EXPECT_FALSE(ball.valid[1]);
+}
+}  // namespace vision_filter
@@ -10,7 +10,7 @@ TEST(WorldBall, invalid) {
 }
 
 TEST(WorldBall, no_ball) {
-    std::list<KalmanBall> kbl;
+    std::vector<KalmanBall> kbl;
 
     EXPECT_ANY_THROW(WorldBall(RJ::now(), kbl));
 }
@@ -24,7 +24,7 @@ TEST(WorldBall, one_ball) {
 
     KalmanBall kb = KalmanBall(c_id, t, b, w);
 
-    std::list<KalmanBall> kbl;
+    std::vector<KalmanBall> kbl;
     kbl.push_back(kb);
 
     WorldBall wb = WorldBall(t, kbl);
@@ -34,7 +34,7 @@ TEST(WorldBall, one_ball) {
     double rpc = wb.get_pos_cov();
     double rvc = wb.get_vel_cov();
 
-    std::list<KalmanBall> list = wb.get_ball_components();
+    std::vector<KalmanBall> list = wb.get_ball_components();
 
     EXPECT_TRUE(wb.get_is_valid());
     EXPECT_EQ(rp.x(), p.x());
@@ -60,7 +60,7 @@ TEST(WorldBall, two_ball) {
     KalmanBall kb1 = KalmanBall(c_id, t, b1, w);
     KalmanBall kb2 = KalmanBall(c_id, t, b2, w);
 
-    std::list<KalmanBall> kbl;
+    std::vector<KalmanBall> kbl;
     kbl.push_back(kb1);
     kbl.push_back(kb2);
 
@@ -71,7 +71,7 @@ TEST(WorldBall, two_ball) {
     double rpc = wb.get_pos_cov();
     double rvc = wb.get_vel_cov();
 
-    std::list<KalmanBall> list = wb.get_ball_components();
+    std::vector<KalmanBall> list = wb.get_ball_components();
 
     EXPECT_TRUE(wb.get_is_valid());
     EXPECT_EQ(rp.x(), (p1.x() + p2.x()) / 2);
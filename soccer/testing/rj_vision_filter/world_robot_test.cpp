@@ -10,7 +10,7 @@ TEST(WorldRobot, invalid) {
 }
 
 TEST(WorldRobot, no_robot) {
-    std::list<KalmanRobot> kbl;
+    std::vector<KalmanRobot> kbl;
 
     EXPECT_ANY_THROW(WorldRobot(RJ::now(), WorldRobot::Team::BLUE, 1, kbl));
 }
@@ -25,7 +25,7 @@ TEST(WorldRobot, one_robot) {
 
     KalmanRobot kb = KalmanRobot(c_id, t, b, w);
 
-    std::list<KalmanRobot> kbl;
+    std::vector<KalmanRobot> kbl;
     kbl.push_back(kb);
 
     WorldRobot wb = WorldRobot(t, WorldRobot::Team::BLUE, r_id, kbl);
@@ -38,7 +38,7 @@ TEST(WorldRobot, one_robot) {
     double rpc = wb.get_pos_cov();
     double rvc = wb.get_vel_cov();
 
-    std::list<KalmanRobot> list = wb.get_robot_components();
+    std::vector<KalmanRobot> list = wb.get_robot_components();
 
     EXPECT_TRUE(wb.get_is_valid());
     EXPECT_EQ(wb.get_robot_id(), r_id);
@@ -73,7 +73,7 @@ TEST(WorldRobot, two_robot) {
     KalmanRobot kb1 = KalmanRobot(c_id, t, b1, w);
     KalmanRobot kb2 = KalmanRobot(c_id, t, b2, w);
 
-    std::list<KalmanRobot> kbl;
+    std::vector<KalmanRobot> kbl;
     kbl.push_back(kb1);
     kbl.push_back(kb2);
 
@@ -86,7 +86,7 @@ TEST(WorldRobot, two_robot) {
     double rpc = wb.get_pos_cov();
     double rvc = wb.get_vel_cov();
 
-    std::list<KalmanRobot> list = wb.get_robot_components();
+    std::vector<KalmanRobot> list = wb.get_robot_components();
 
     EXPECT_TRUE(wb.get_is_valid());
     EXPECT_EQ(rp.x(), (pose1.position().x() + pose2.position().x()) / 2);
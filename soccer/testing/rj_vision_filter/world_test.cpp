@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <rj_constants/constants.hpp>
+#include <rj_param_utils/param.hpp>
+#include <rj_vision_filter/camera/world.hpp>
+#include <rj_vision_filter/params.hpp>
+
+namespace vision_filter {
+namespace {
+
+constexpr int kNumCameras = 4;
+
+// The ball and a few robots of each team, seen slightly differently by each
+// camera, moving a little every iteration
+std::vector<CameraFrame> make_frames(RJ::Time t, int iteration) {
+    std::vector<CameraFrame> frames;
+    for (int camera_id = 0; camera_id < kNumCameras; camera_id++) {
+        const double offset = 0.01 * iteration + 0.001 * camera_id;
+
+        std::vector<CameraBall> balls{CameraBall(t, rj_geometry::Point(1 + offset, 2 - offset))};
+        std::vector<CameraRobot> yellow;
+        std::vector<CameraRobot> blue;
+        for (int id = 0; id < 3; id++) {
+            yellow.emplace_back(t, rj_geometry::Pose(id + offset, 1, 0.1 * id), id);
+            blue.emplace_back(t, rj_geometry::Pose(-id - offset, 3, -0.1 * id), id);
+        }
+
+        frames.emplace_back(t, camera_id, balls, yellow, blue);
+    }
+    return frames;
+}
+
+void set_num_camera_threads(int64_t num_threads) {
+    ::params::ParamProvider provider{kVisionFilterParamModule};
+    provider.Update<int64_t>("num_camera_threads", num_threads);
+}
+
+void expect_same_robots(const std::vector<WorldRobot>& serial,
+                        const std::vector<WorldRobot>& parallel) {
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        ASSERT_EQ(serial.at(i).get_is_valid(), parallel.at(i).get_is_valid());
+        if (serial.at(i).get_is_valid()) {
+            EXPECT_DOUBLE_EQ(serial.at(i).get_pos().x(), parallel.at(i).get_pos().x());
+            EXPECT_DOUBLE_EQ(serial.at(i).get_pos().y(), parallel.at(i).get_pos().y());
+            EXPECT_DOUBLE_EQ(serial.at(i).get_theta(), parallel.at(i).get_theta());
+            EXPECT_DOUBLE_EQ(serial.at(i).get_vel().x(), parallel.at(i).get_vel().x());
+            EXPECT_DOUBLE_EQ(serial.at(i).get_vel().y(), parallel.at(i).get_vel().y());
+        }
+    }
+}
+
+}  // namespace
+
+TEST(World, parallel_cameras_match_serial) {
+    World serial;
+    World parallel;
+
+    const RJ::Time start = RJ::now();
+    for (int i = 0; i < 30; i++) {
+        const RJ::Time t = start + RJ::Seconds(0.01 * i);
+
+        // Every so often, an iteration without any vision
+        if (i % 5 == 4) {
+            set_num_camera_threads(1);
+            serial.update_without_camera_frame(t);
+            set_num_camera_threads(kNumCameras);
+            parallel.update_without_camera_frame(t);
+            continue;
+        }
+
+        const std::vector<CameraFrame> frames = make_frames(t, i);
+        set_num_camera_threads(1);
+        serial.update_with_camera_frame(t, frames, true);
+        set_num_camera_threads(kNumCameras);
+        parallel.update_with_camera_frame(t, frames, true);
+    }
+    set_num_camera_threads(1);
+
+    const WorldBall& serial_ball = serial.get_world_ball();
+    const WorldBall& parallel_ball = parallel.get_world_ball();
+    ASSERT_TRUE(serial_ball.get_is_valid());
+    ASSERT_TRUE(parallel_ball.get_is_valid());
+    EXPECT_DOUBLE_EQ(serial_ball.get_pos().x(), parallel_ball.get_pos().x());
+    EXPECT_DOUBLE_EQ(serial_ball.get_pos().y(), parallel_ball.get_pos().y());
+    EXPECT_DOUBLE_EQ(serial_ball.get_vel().x(), parallel_ball.get_vel().x());
+    EXPECT_DOUBLE_EQ(serial_ball.get_vel().y(), parallel_ball.get_vel().y());
+
+    ASSERT_TRUE(serial.get_robots_yellow().at(0).get_is_valid());
+    expect_same_robots(serial.get_robots_yellow(), parallel.get_robots_yellow());
+    expect_same_robots(serial.get_robots_blue(), parallel.get_robots_blue());
+}
+}  // namespace vision_filter